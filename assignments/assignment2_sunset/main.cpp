@@ -1,5 +1,7 @@
 #include <stdio.h>
 #include <math.h>
+#include <string>
+#include <filesystem>
 
 #include <ew/external/glad.h>
 #include <ew/ewMath/ewMath.h>
@@ -9,6 +11,8 @@
 #include <imgui_impl_opengl3.h>
 
 #include <MyLibrary/shader.h>
+#include <ew/shader.h>
+#include <ew/shaderHotReload.h>
 
 void framebufferSizeCallback(GLFWwindow* window, int width, int height);
 
@@ -81,8 +85,18 @@ int main() {
 	ImGui_ImplGlfw_InitForOpenGL(window, true);
 	ImGui_ImplOpenGL3_Init();
 
-	MyLibrary::Shader shader("assets/vertexShader.vert", "assets/fragmentShader.frag");
-	shader.use();
+	//Shaders are read from this assignment's source folder, so saving them reloads without rebuilding or restarting.
+	//Falls back to the copies in bin/assets when the source folder isn't there
+	std::string assetsDirectory = "assets/";
+#if defined(ASSETS_SOURCE_DIR)
+	if (std::filesystem::exists(ASSETS_SOURCE_DIR)) {
+		assetsDirectory = ASSETS_SOURCE_DIR;
+	}
+#endif
+	ew::Shader shader(assetsDirectory + "vertexShader.vert", assetsDirectory + "fragmentShader.frag");
+
+	ew::ShaderHotReload shaderHotReload;
+	shaderHotReload.watch(&shader);
 
 	unsigned int vao = MyLibrary::createVAO(vertices, 4, indicies, 6);
 	glBindVertexArray(vao);
@@ -92,6 +106,9 @@ int main() {
 		glClearColor(0.3f, 0.4f, 0.9f, 1.0f);
 		glClear(GL_COLOR_BUFFER_BIT);
 
+		shaderHotReload.update();
+		shader.use();
+
 		// Set uniforms
 		// BG uniforms
 		shader.setVec3("_BGTopColor", _BGTopColor[0], _BGTopColor[1], _BGTopColor[2]);
@@ -164,6 +181,8 @@ int main() {
 
 			ImGui::End();
 
+			shaderHotReload.drawErrorOverlay();
+
 			if (showImGUIDemoWindow)
 			{
 				ImGui::ShowDemoWindow(&showImGUIDemoWindow);
@@ -10,6 +10,7 @@
 
 #include <MyLibrary/shader.h>
 #include <MyLibrary/texture.h>
+#include <ew/glState.h>
 
 struct Vertex {
 	float x, y, z;
@@ -72,27 +73,25 @@ int main() {
 	unsigned int characterTexture = MyLibrary::loadTexture("assets/littleGuy.png", GL_CLAMP_TO_BORDER, GL_NEAREST);
 	
 	// Put the noise pattern texture in unit 0
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, noisePatternTexture);
+	ew::state::bindTexture(0, GL_TEXTURE_2D, noisePatternTexture);
 
 	// Put the background texture in unit 1
-	glActiveTexture(GL_TEXTURE1);
-	glBindTexture(GL_TEXTURE_2D, backgroundTexture);
+	ew::state::bindTexture(1, GL_TEXTURE_2D, backgroundTexture);
 
 	// Put the character texture in unit 2
-	glActiveTexture(GL_TEXTURE2);
-	glBindTexture(GL_TEXTURE_2D, characterTexture);
+	ew::state::bindTexture(2, GL_TEXTURE_2D, characterTexture);
 
 	unsigned int quadVAO = createVAO(vertices, 4, indices, 6);
 
-	glBindVertexArray(quadVAO);
+	ew::state::bindVertexArray(quadVAO);
 
 	while (!glfwWindowShouldClose(window)) {
 		glfwPollEvents();
 		glClearColor(0.3f, 0.4f, 0.9f, 1.0f);
 		glClear(GL_COLOR_BUFFER_BIT);
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		// Redundant after the first frame, so the state cache filters these out
+		ew::state::setEnabled(GL_BLEND, true);
+		ew::state::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 		float time = (float)glfwGetTime();
 
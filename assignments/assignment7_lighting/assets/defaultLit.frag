@@ -5,40 +5,49 @@ in Surface{
 	vec2 UV;
 	vec3 WorldPosition;
 	vec3 WorldNormal;
+#ifdef MULTI_DRAW_INDIRECT
+	flat uint MaterialIndex;
+#endif
 }fs_in;
 
-struct Light
-{
-	vec3 position;
-	vec3 color;
-};
-
-#define MAX_NUM_OF_LIGHTS 4
-uniform Light _LightsArray[MAX_NUM_OF_LIGHTS];
+#include "lights.glsl"
 
+#ifdef MULTI_DRAW_INDIRECT
+//Each draw's material from the MaterialTable header, indexed by its IndirectBatch materialIndex
+#define _ambient _Materials[fs_in.MaterialIndex].ambient
+#define _diffuse _Materials[fs_in.MaterialIndex].diffuse
+#define _specular _Materials[fs_in.MaterialIndex].specular
+#define _shine _Materials[fs_in.MaterialIndex].shine
+#else
 uniform float _ambient;
 uniform float _diffuse;
 uniform float _specular;
 uniform float _shine;
+#endif
 
 vec3 reflectionVec;
 uniform vec3 _cameraPos;
 vec3 viewingAngle;
-uniform bool _blinnPhong = false;
 
+#ifndef MULTI_DRAW_INDIRECT
 uniform sampler2D _Texture;
+#endif
 
 float diffuseFactor;
 float specularFactor;
 
 void main(){
+#ifdef MULTI_DRAW_INDIRECT
+	FragColor = sampleMaterial(fs_in.MaterialIndex, fs_in.UV);
+#else
 	FragColor = texture(_Texture,fs_in.UV);
+#endif
 
 	vec3 normal = normalize(fs_in.WorldNormal);
 	vec3 baseFragRGB = FragColor.rgb;
 	FragColor = vec4(0, 0, 0, 0);
 
-	for (int i = 0; i < MAX_NUM_OF_LIGHTS; i++)
+	for (int i = 0; i < NUM_LIGHTS; i++)
 	{
 		vec3 lightDir = normalize(_LightsArray[i].position - fs_in.WorldPosition);
 
@@ -46,16 +55,13 @@ void main(){
 
 		viewingAngle = normalize(_cameraPos - fs_in.WorldPosition);
 
-		if (_blinnPhong)
-		{
-			vec3 h = normalize(lightDir + viewingAngle);
-			specularFactor = pow(max(dot(h, normal), 0), _shine);
-		}
-		else
-		{
-			reflectionVec = 2 * dot(lightDir, normal) * normal - lightDir;
-			specularFactor = pow(max(dot(reflectionVec, viewingAngle), 0), _shine);
-		}
+#ifdef BLINN_PHONG
+		vec3 h = normalize(lightDir + viewingAngle);
+		specularFactor = pow(max(dot(h, normal), 0), _shine);
+#else
+		reflectionVec = 2 * dot(lightDir, normal) * normal - lightDir;
+		specularFactor = pow(max(dot(reflectionVec, viewingAngle), 0), _shine);
+#endif
 
 		specularFactor *= _specular;
 
@@ -7,14 +7,36 @@ out Surface{
 	vec2 UV;
 	vec3 WorldPosition;
 	vec3 WorldNormal;
+#ifdef MULTI_DRAW_INDIRECT
+	flat uint MaterialIndex;
+#endif
 }vs_out;
 
+#ifdef MULTI_DRAW_INDIRECT
+//Model matrices come from the IndirectBatch draw data, indexed by draw
+layout(location = 3) in uint vDrawIndex;
+struct DrawData{
+	mat4 model;
+	mat4 normalMatrix;
+	uint materialIndex;
+};
+layout(std430, binding = 1) readonly buffer DrawDataBuffer{
+	DrawData _DrawData[];
+};
+#define _Model _DrawData[vDrawIndex].model
+#define _NormalMatrix _DrawData[vDrawIndex].normalMatrix
+#else
 uniform mat4 _Model;
+uniform mat4 _NormalMatrix; //ew::NormalMatrix(_Model)
+#endif
 uniform mat4 _ViewProjection;
 
 void main(){
 	vs_out.UV = vUV;
 	vs_out.WorldPosition = vec3(_Model * vec4(vPos, 1.0));
-	vs_out.WorldNormal = transpose(inverse(mat3(_Model))) * vNormal;
+	vs_out.WorldNormal = mat3(_NormalMatrix) * vNormal;
+#ifdef MULTI_DRAW_INDIRECT
+	vs_out.MaterialIndex = _DrawData[vDrawIndex].materialIndex;
+#endif
 	gl_Position = _ViewProjection * _Model * vec4(vPos,1.0);
 }
\ No newline at end of file
@@ -0,0 +1,12 @@
+struct Light
+{
+	vec3 position;
+	vec3 color;
+};
+
+#define MAX_NUM_OF_LIGHTS 4
+//Number of lights actually shaded, set per shader variant
+#ifndef NUM_LIGHTS
+#define NUM_LIGHTS MAX_NUM_OF_LIGHTS
+#endif
+uniform Light _LightsArray[MAX_NUM_OF_LIGHTS];
@@ -14,6 +14,18 @@
 #include <ew/transform.h>
 #include <ew/camera.h>
 #include <ew/cameraController.h>
+#include <ew/glState.h>
+#include <ew/renderQueue.h>
+#include <ew/geometryArena.h>
+#include <ew/frustum.h>
+#include <ew/bvh.h>
+#include <ew/picking.h>
+#include <ew/hiZ.h>
+#include <ew/occlusionRasterizer.h>
+#include <ew/profiler.h>
+#include <ew/ecs.h>
+#include <ew/renderSystem.h>
+#include <ew/materialTable.h>
 
 using namespace std;
 
@@ -29,28 +41,108 @@ ew::Vec3 bgColor = ew::Vec3(0.1f);
 ew::Camera camera;
 ew::CameraController cameraController;
 
-struct Light
-{
-	ew::Vec3 color = { 1, 1, 1 };
-	ew::Transform transform;
-};
-
 const int MAX_NUM_OF_LIGHTS = 4;
 int numLights = MAX_NUM_OF_LIGHTS;
 
-Light lightsArray[MAX_NUM_OF_LIGHTS];
+//Lights are entities with a Transform and an ew::Light. Scene objects are entities with a Transform, MeshRef, MaterialRef,
+//Bounds and Pickable, and Occluder for those drawn into the occlusion culling depth buffer
+ew::World world;
+ew::Entity lightEntities[MAX_NUM_OF_LIGHTS];
+
+//Multi-draw-indirect reads each entity's material from the table by MaterialRef::materialIndex.
+//The render queue path binds _Texture and sets the brick material's parameters as uniforms for every draw
+const unsigned int MATERIAL_TEXTURE_UNIT = 1;
+int editedMaterial = 0;
+
+bool blinnPhong = true;
+bool multiDrawIndirect = false;
+bool frustumCulling = true;
+bool bvhCulling = false;
+bool occlusionCulling = false;
+bool softwareOcclusion = false; //CPU rasterizer instead of the GPU Hi-Z pyramid
+bool cityBlocks = false;
+int cullThreads = 1;
+int numBenchmarkObjects = 0;
+bool showProfiler = false;
+
+//Triangle BVH in the entity's local space, for picking
+struct Pickable
+{
+	const ew::MeshPicker* picker;
+};
+//Triangles drawn into the occlusion culling depth buffer
+struct Occluder
+{
+	const ew::MeshData* meshData;
+};
 
-struct Material
+//A mesh in every form the scene entities need
+struct SceneShape
 {
-	float ambient = 0.1;
-	float diffuse = 0.25;
-	float specular = 1.0;
-	float shine = 128;
+	const ew::Mesh* mesh;
+	const ew::MeshData* meshData;
+	ew::MeshAllocation allocation;
+	const ew::MeshPicker* picker;
 };
 
-Material material;
+//Scene entities in creation order. Culling and picking results index this list
+std::vector<ew::Entity> sceneEntities;
 
-bool blinnPhong = true;
+void addSceneObject(const SceneShape& shape, const ew::Transform& transform, const ew::MaterialRef& material, bool occluder = false)
+{
+	ew::MeshRef meshRef;
+	meshRef.mesh = shape.mesh;
+	meshRef.allocation = shape.allocation;
+	ew::Bounds bounds;
+	bounds.local = shape.allocation.bounds;
+	if (occluder) {
+		sceneEntities.push_back(world.create(transform, meshRef, material, bounds, Pickable{ shape.picker }, Occluder{ shape.meshData }));
+	}
+	else {
+		sceneEntities.push_back(world.create(transform, meshRef, material, bounds, Pickable{ shape.picker }));
+	}
+}
+
+//Adds a grid of tall buildings with small objects in the streets between them.
+//From street level most objects are hidden behind the buildings.
+void addCityBlocks(const SceneShape& cube, const SceneShape& cylinder, const ew::MaterialRef& buildingMaterial, const ew::MaterialRef& propMaterial)
+{
+	const int NUM_BLOCKS = 24;
+	const float BLOCK_SPACING = 10.0f;
+	const float BUILDING_SIZE = 7.0f;
+	ew::Rng rng(1);
+	for (int z = 0; z < NUM_BLOCKS; z++)
+	{
+		for (int x = 0; x < NUM_BLOCKS; x++)
+		{
+			ew::Vec3 blockCenter = ew::Vec3((x - NUM_BLOCKS / 2) * BLOCK_SPACING, -1.0f, (z - NUM_BLOCKS / 2) * BLOCK_SPACING - 20.0f);
+			ew::Transform building;
+			building.scale = ew::Vec3(BUILDING_SIZE, rng.range(6.0f, 20.0f), BUILDING_SIZE);
+			building.position = blockCenter + ew::Vec3(0, building.scale.y * 0.5f, 0);
+			addSceneObject(cube, building, buildingMaterial, true);
+			//Street furniture along two sides of the block
+			for (int i = 0; i < 8; i++)
+			{
+				ew::Transform prop;
+				float along = (i % 4) * 2.5f - 3.75f;
+				prop.position = blockCenter + (i < 4 ? ew::Vec3(along, 0.5f, BLOCK_SPACING * 0.5f) : ew::Vec3(BLOCK_SPACING * 0.5f, 0.5f, along));
+				addSceneObject(i % 2 == 0 ? cube : cylinder, prop, propMaterial);
+			}
+		}
+	}
+}
+
+//Light count and specular model are compiled into shader permutations instead of branching per fragment
+ew::ShaderDefines getLightingDefines() {
+	ew::ShaderDefines defines = { { "NUM_LIGHTS", std::to_string(numLights) } };
+	if (blinnPhong) {
+		defines.push_back({ "BLINN_PHONG", "" });
+	}
+	if (multiDrawIndirect) {
+		defines.push_back({ "MULTI_DRAW_INDIRECT", "" });
+	}
+	return defines;
+}
 
 int main() {
 	printf("Initializing...");
@@ -79,20 +171,61 @@ int main() {
 	ImGui_ImplOpenGL3_Init();
 
 	//Global settings
-	glEnable(GL_CULL_FACE);
-	glCullFace(GL_BACK);
-	glEnable(GL_DEPTH_TEST);
-
-	ew::Shader shader("assets/defaultLit.vert", "assets/defaultLit.frag");
-	unsigned int brickTexture = ew::loadTexture("assets/brick_color.jpg", GL_REPEAT, GL_LINEAR);
+	ew::state::setEnabled(GL_CULL_FACE, true);
+	ew::state::cullFace(GL_BACK);
+	ew::state::setEnabled(GL_DEPTH_TEST, true);
+
+	//Brick for the shapes and props, and plain concrete for the city buildings
+	ew::MaterialTable materialTable(GL_REPEAT, GL_LINEAR);
+	ew::Material brick;
+	brick.texture = materialTable.addTexture("assets/brick_color.jpg");
+	const int brickMaterialIndex = materialTable.addMaterial(brick);
+	ew::Material concrete;
+	concrete.ambient = 0.2f;
+	concrete.diffuse = 0.5f;
+	concrete.specular = 0.2f;
+	concrete.shine = 16.0f;
+	materialTable.addMaterial(concrete);
+	materialTable.upload();
+
+	//Lit shader compiles in the background while the unlit shader is used in its place
+	ew::AsyncShader litShader("assets/defaultLit.vert", "assets/defaultLit.frag", getLightingDefines(), materialTable.getShaderHeader());
 	ew::Shader unlitShader("assets/unlit.vert", "assets/unlit.frag");
+	unsigned int brickTexture = ew::loadTexture("assets/brick_color.jpg", GL_REPEAT, GL_LINEAR);
 
 	//Create cube
-	ew::Mesh cubeMesh(ew::createCube(1.0f));
-	ew::Mesh planeMesh(ew::createPlane(5.0f, 5.0f, 10));
-	ew::Mesh sphereMesh(ew::createSphere(0.5f, 64));
-	ew::Mesh cylinderMesh(ew::createCylinder(0.5f, 1.0f, 32));
+	ew::MeshData cubeMeshData = ew::createCube(1.0f);
+	ew::MeshData planeMeshData = ew::createPlane(5.0f, 5.0f, 10);
+	ew::MeshData sphereMeshData = ew::createSphere(0.5f, 64);
+	ew::MeshData cylinderMeshData = ew::createCylinder(0.5f, 1.0f, 32);
+	ew::Mesh cubeMesh(cubeMeshData);
+	ew::Mesh planeMesh(planeMeshData);
+	ew::Mesh sphereMesh(sphereMeshData);
+	ew::Mesh cylinderMesh(cylinderMeshData);
+
+	//Same shapes packed into shared buffers for multi-draw-indirect
+	ew::GeometryArena geometryArena;
+	ew::MeshAllocation cubeAllocation = geometryArena.add(cubeMeshData);
+	ew::MeshAllocation planeAllocation = geometryArena.add(planeMeshData);
+	ew::MeshAllocation sphereAllocation = geometryArena.add(sphereMeshData);
+	ew::MeshAllocation cylinderAllocation = geometryArena.add(cylinderMeshData);
+	ew::IndirectBatch indirectBatch;
+	ew::MeshPicker cubePicker(cubeMeshData);
+	ew::MeshPicker planePicker(planeMeshData);
+	ew::MeshPicker spherePicker(sphereMeshData);
+	ew::MeshPicker cylinderPicker(cylinderMeshData);
 	ew::Mesh lightSphere(ew::createSphere(0.1f, 16));
+	const SceneShape cubeShape = { &cubeMesh, &cubeMeshData, cubeAllocation, &cubePicker };
+	const SceneShape planeShape = { &planeMesh, &planeMeshData, planeAllocation, &planePicker };
+	const SceneShape sphereShape = { &sphereMesh, &sphereMeshData, sphereAllocation, &spherePicker };
+	const SceneShape cylinderShape = { &cylinderMesh, &cylinderMeshData, cylinderAllocation, &cylinderPicker };
+	//The shader is set to the current lighting permutation each frame
+	ew::MaterialRef brickMaterial;
+	brickMaterial.shader = &unlitShader;
+	brickMaterial.texture = brickTexture;
+	brickMaterial.materialIndex = brickMaterialIndex;
+	ew::MaterialRef concreteMaterial = brickMaterial;
+	concreteMaterial.materialIndex = brickMaterialIndex + 1;
 
 	//Initialize transforms
 	ew::Transform cubeTransform;
@@ -103,20 +236,47 @@ int main() {
 	sphereTransform.position = ew::Vec3(-1.5f, 0.0f, 0.0f);
 	cylinderTransform.position = ew::Vec3(1.5f, 0.0f, 0.0f);
 
+	//Benchmark objects reuse the cube and cylinder, scattered around the shapes
+	ew::CullingBounds cullingBounds;
+	ew::BVH sceneBVH;
+	std::vector<uint8_t> visibleObjects;
+	std::vector<ew::Renderable> renderables;
+	int builtBenchmarkObjects = -1;
+	bool builtCityBlocks = false;
+	std::vector<ew::AABB> worldBounds; //Bounds::world of sceneEntities
+	std::vector<int> occluderObjects; //Indices of sceneEntities with an Occluder
+	float gatherMs = 0.0f;
+	ew::HiZCuller hiZCuller(512, 256);
+	ew::OcclusionRasterizer occlusionRasterizer(256, 128);
+	ew::PickHit pickHit;
+	float pickMs = 0.0f;
+	bool wasMouseDown = false;
+
 	resetCamera(camera,cameraController);
 
-	lightsArray[0].transform.position = { 2, 1, 2 };
-	lightsArray[0].color = { 1,0,0 };
-	lightsArray[1].transform.position = { 2, 1, -2 };
-	lightsArray[1].color = { 0,1,0 };
-	lightsArray[2].transform.position = { -2, 1, -2 };
-	lightsArray[2].color = { 0,0,1 };
-	lightsArray[3].transform.position = { -2, 1, 2 };
-	lightsArray[3].color = { 1,1,0 };
+	const ew::Vec3 lightPositions[MAX_NUM_OF_LIGHTS] = { { 2, 1, 2 }, { 2, 1, -2 }, { -2, 1, -2 }, { -2, 1, 2 } };
+	const ew::Vec3 lightColors[MAX_NUM_OF_LIGHTS] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 1, 1, 0 } };
+	for (int i = 0; i < MAX_NUM_OF_LIGHTS; i++)
+	{
+		ew::Transform lightTransform;
+		lightTransform.position = lightPositions[i];
+		ew::Light light;
+		light.color = lightColors[i];
+		lightEntities[i] = world.create(lightTransform, light);
+	}
+
+	ew::RenderQueue renderQueue;
+
+	bool firstFrame = true;
 
 	while (!glfwWindowShouldClose(window)) {
+		ew::profiler::beginFrame();
 		glfwPollEvents();
 
+		//State changes made during the previous frame
+		ew::GLStateCounters stateCounters = ew::state::getCounters();
+		ew::state::resetCounters();
+
 		float time = (float)glfwGetTime();
 		float deltaTime = time - prevTime;
 		prevTime = time;
@@ -125,47 +285,197 @@ int main() {
 		camera.aspectRatio = (float)SCREEN_WIDTH / SCREEN_HEIGHT;
 		cameraController.Move(window, &camera, deltaTime);
 
+		//Objects are static, so world space bounds are only rebuilt when the scene settings change
+		if (builtBenchmarkObjects != numBenchmarkObjects || builtCityBlocks != cityBlocks) {
+			builtBenchmarkObjects = numBenchmarkObjects;
+			builtCityBlocks = cityBlocks;
+			EW_PROFILE_SCOPE("Build scene");
+			for (ew::Entity entity : sceneEntities) {
+				world.destroy(entity);
+			}
+			sceneEntities.clear();
+			addSceneObject(cubeShape, cubeTransform, brickMaterial);
+			addSceneObject(planeShape, planeTransform, brickMaterial);
+			addSceneObject(sphereShape, sphereTransform, brickMaterial);
+			addSceneObject(cylinderShape, cylinderTransform, brickMaterial);
+			//Same seed every rebuild, so changing the object count only adds or removes objects at the end
+			ew::Rng rng(0);
+			float range = 10.0f + cbrtf((float)numBenchmarkObjects) * 2.0f;
+			for (int i = 0; i < numBenchmarkObjects; i++)
+			{
+				ew::Transform transform;
+				//One value per statement, since the order function arguments are evaluated in is unspecified
+				transform.position.x = rng.range(-range, range);
+				transform.position.y = rng.range(-range, range);
+				transform.position.z = rng.range(-range, range);
+				transform.rotation.x = rng.range(0, 360);
+				transform.rotation.y = rng.range(0, 360);
+				addSceneObject(i % 2 == 0 ? cubeShape : cylinderShape, transform, brickMaterial);
+			}
+			if (cityBlocks) {
+				addCityBlocks(cubeShape, cylinderShape, concreteMaterial, brickMaterial);
+			}
+			ew::UpdateWorldBounds(world, cullThreads);
+			worldBounds.clear();
+			occluderObjects.clear();
+			cullingBounds.clear();
+			for (size_t i = 0; i < sceneEntities.size(); i++)
+			{
+				worldBounds.push_back(world.get<ew::Bounds>(sceneEntities[i])->world);
+				cullingBounds.add(worldBounds.back());
+				if (world.has<Occluder>(sceneEntities[i])) {
+					occluderObjects.push_back((int)i);
+				}
+			}
+			sceneBVH.build(worldBounds, cullThreads);
+			pickHit = ew::PickHit();
+		}
+
+		//Left click picks the object under the cursor. The scene BVH finds candidate objects,
+		//then each candidate's triangle BVH is tested in its local space
+		bool mouseDown = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_1);
+		if (mouseDown && !wasMouseDown && !ImGui::GetIO().WantCaptureMouse) {
+			EW_PROFILE_SCOPE("Pick");
+			double startTime = glfwGetTime();
+			double cursorX, cursorY;
+			int windowWidth, windowHeight;
+			glfwGetCursorPos(window, &cursorX, &cursorY);
+			glfwGetWindowSize(window, &windowWidth, &windowHeight);
+			ew::Ray ray = ew::ScreenPointToRay(camera, (float)cursorX, (float)cursorY, windowWidth, windowHeight);
+			ew::BVHRayHit objectHit;
+			ew::PickHit closestHit;
+			sceneBVH.raycast(ray, camera.farPlane, &objectHit, [&](int object, const ew::Ray& worldRay, float maxDistance, float* distance) {
+				ew::PickHit hit;
+				const ew::Entity entity = sceneEntities[object];
+				const ew::Mat4 inverseModel = world.get<ew::Transform>(entity)->getInverseModelMatrix();
+				if (!world.get<Pickable>(entity)->picker->raycast(ew::TransformRay(worldRay, inverseModel), maxDistance, &hit)) {
+					return false;
+				}
+				hit.object = object;
+				hit.point = worldRay.origin + worldRay.direction * hit.distance;
+				closestHit = hit;
+				*distance = hit.distance;
+				return true;
+			});
+			pickHit = closestHit;
+			pickMs = (float)(glfwGetTime() - startTime) * 1000.0f;
+		}
+		wasMouseDown = mouseDown;
+
+		//Without a BVH or occlusion culling, the render system culls entities by their Bounds as it gathers them.
+		//Otherwise the scene's world bounds are culled first and only the visible entities are gathered
+		const bool gatherCulled = frustumCulling && !bvhCulling && !occlusionCulling;
+		if (frustumCulling && bvhCulling) {
+			EW_PROFILE_SCOPE("Frustum culling");
+			sceneBVH.cull(ew::CameraFrustum(camera), visibleObjects);
+		}
+		else if (frustumCulling && !gatherCulled) {
+			EW_PROFILE_SCOPE("Frustum culling");
+			cullingBounds.cull(ew::CameraFrustum(camera), visibleObjects, cullThreads);
+		}
+		else {
+			visibleObjects.assign(sceneEntities.size(), 1);
+		}
+
+		//Occluders are drawn into a small depth buffer, then everything still visible is tested against its Hi-Z pyramid
+		if (occlusionCulling && softwareOcclusion) {
+			EW_PROFILE_SCOPE("Software occlusion");
+			occlusionRasterizer.beginOccluders(camera.ProjectionMatrix() * camera.ViewMatrix());
+			for (int i : occluderObjects) {
+				if (visibleObjects[i]) {
+					occlusionRasterizer.addOccluder(*world.get<Occluder>(sceneEntities[i])->meshData, world.get<ew::Transform>(sceneEntities[i])->getModelMatrix());
+				}
+			}
+			occlusionRasterizer.endOccluders(cullThreads);
+			occlusionRasterizer.cull(worldBounds, visibleObjects, cullThreads);
+		}
+		else if (occlusionCulling) {
+			EW_PROFILE_SCOPE("Hi-Z occlusion");
+			EW_PROFILE_GPU_SCOPE("Hi-Z occlusion");
+			hiZCuller.beginOccluders(camera.ProjectionMatrix() * camera.ViewMatrix());
+			for (int i : occluderObjects) {
+				if (visibleObjects[i]) {
+					hiZCuller.drawOccluder(*world.get<ew::MeshRef>(sceneEntities[i])->mesh, world.get<ew::Transform>(sceneEntities[i])->getModelMatrix());
+				}
+			}
+			hiZCuller.endOccluders();
+			hiZCuller.cull(worldBounds, visibleObjects);
+		}
+
 		//RENDER
 		glClearColor(bgColor.x, bgColor.y,bgColor.z,1.0f);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+		//Changing the light count or specular model compiles another permutation in the background, drawn unlit until it links
+		const ew::Shader& shader = litShader.getPermutation(getLightingDefines(), unlitShader);
+		const bool litReady = &shader != &unlitShader;
 		shader.use();
-		glBindTexture(GL_TEXTURE_2D, brickTexture);
+		ew::state::bindTexture(0, GL_TEXTURE_2D, brickTexture);
 		shader.setInt("_Texture", 0);
 		shader.setMat4("_ViewProjection", camera.ProjectionMatrix() * camera.ViewMatrix());
 
-		for (int i = 0; i < MAX_NUM_OF_LIGHTS; i++)
+		for (int i = 0; i < numLights; i++)
 		{
-			if (i < numLights)
-			{
-				shader.setVec3(("_LightsArray[" + to_string(i) + "].position"), lightsArray[i].transform.position);
-				shader.setVec3(("_LightsArray[" + to_string(i) + "].color"), lightsArray[i].color);
-			}
-			else
-			{
-				shader.setVec3(("_LightsArray[" + std::to_string(i) + "].color"), ew::Vec3(0, 0, 0));
-			}
+			const ew::Light* light = world.get<ew::Light>(lightEntities[i]);
+			shader.setVec3(("_LightsArray[" + to_string(i) + "].position"), world.get<ew::Transform>(lightEntities[i])->position);
+			shader.setVec3(("_LightsArray[" + to_string(i) + "].color"), light->color * light->intensity);
 		}
 
+		const ew::Material& material = materialTable.getMaterial(brickMaterialIndex);
 		shader.setFloat("_ambient", material.ambient);
 		shader.setFloat("_diffuse", material.diffuse);
 		shader.setFloat("_shine", material.shine);
 		shader.setFloat("_specular", material.specular);
 		shader.setVec3("_cameraPos", camera.position);
-		shader.setBool("_blinnPhong", blinnPhong);
-
-		//Draw shapes
-		shader.setMat4("_Model", cubeTransform.getModelMatrix());
-		cubeMesh.draw();
-
-		shader.setMat4("_Model", planeTransform.getModelMatrix());
-		planeMesh.draw();
+		//Only uploads materials edited since the last frame
+		materialTable.upload();
+		materialTable.bind(0, MATERIAL_TEXTURE_UNIT);
+		shader.setInt("_MaterialTextures", MATERIAL_TEXTURE_UNIT);
 
-		shader.setMat4("_Model", sphereTransform.getModelMatrix());
-		sphereMesh.draw();
 
-		shader.setMat4("_Model", cylinderTransform.getModelMatrix());
-		cylinderMesh.draw();
+		//Draw shapes
+		if (brickMaterial.shader != &shader) {
+			brickMaterial.shader = &shader;
+			concreteMaterial.shader = &shader;
+			world.each<ew::MaterialRef>([&shader](ew::MaterialRef& material) {
+				material.shader = &shader;
+			});
+		}
+		{
+			EW_PROFILE_SCOPE("Gather renderables");
+			double startTime = glfwGetTime();
+			if (gatherCulled) {
+				ew::GatherRenderables(world, ew::CameraFrustum(camera), camera.position, renderables, cullThreads);
+			}
+			else {
+				ew::GatherRenderables(world, sceneEntities, visibleObjects, camera.position, renderables);
+			}
+			gatherMs = (float)(glfwGetTime() - startTime) * 1000.0f;
+		}
+		renderQueue.clear();
+		indirectBatch.clear();
+		bool useIndirect = multiDrawIndirect && litReady;
+		int trianglesSubmitted = 0;
+		for (const ew::Renderable& renderable : renderables) {
+			trianglesSubmitted += renderable.mesh->allocation.numIndices / 3;
+		}
+		if (useIndirect) {
+			ew::SubmitRenderables(renderables, indirectBatch);
+		}
+		else {
+			ew::SubmitRenderables(renderables, renderQueue);
+		}
+		if (useIndirect) {
+			EW_PROFILE_SCOPE("Draw scene");
+			EW_PROFILE_GPU_SCOPE("Draw scene");
+			//Whole scene in one draw call
+			indirectBatch.draw(geometryArena);
+		}
+		else {
+			EW_PROFILE_SCOPE("Draw scene");
+			EW_PROFILE_GPU_SCOPE("Draw scene");
+			renderQueue.execute();
+		}
 
 		//TODO: Render point lights
 		unlitShader.use();
@@ -173,13 +483,20 @@ int main() {
 
 		for (int i = 0; i < numLights; i++)
 		{
-			unlitShader.setVec3("_Color", lightsArray[i].color);
-			unlitShader.setMat4("_Model", lightsArray[i].transform.getModelMatrix());
+			unlitShader.setVec3("_Color", world.get<ew::Light>(lightEntities[i])->color);
+			unlitShader.setMat4("_Model", world.get<ew::Transform>(lightEntities[i])->getModelMatrix());
+			lightSphere.draw();
+		}
+		if (pickHit.object >= 0) {
+			unlitShader.setVec3("_Color", ew::Vec3(1.0f));
+			unlitShader.setMat4("_Model", ew::Translate(pickHit.point) * ew::Scale(ew::Vec3(0.5f)));
 			lightSphere.draw();
 		}
 
 		//Render UI
 		{
+			EW_PROFILE_SCOPE("UI");
+			EW_PROFILE_GPU_SCOPE("UI");
 			ImGui_ImplGlfw_NewFrame();
 			ImGui_ImplOpenGL3_NewFrame();
 			ImGui::NewFrame();
@@ -204,6 +521,57 @@ int main() {
 				}
 			}
 
+			if (ImGui::CollapsingHeader("Stats")) {
+				ImGui::Checkbox("Multi-draw indirect", &multiDrawIndirect);
+				ImGui::Text("State calls issued: %u", stateCounters.issued);
+				ImGui::Text("State calls filtered: %u", stateCounters.filtered);
+				const ew::RenderQueueStats& queueStats = renderQueue.getStats();
+				ImGui::Text("Queued draws: %i", queueStats.numDraws);
+				ImGui::Text("Queue state calls: %u issued, %u filtered", queueStats.stateCallsIssued, queueStats.stateCallsFiltered);
+				ImGui::Text("Queue sort: %.3fms submit: %.3fms", queueStats.sortMs, queueStats.submitMs);
+				ImGui::Checkbox("Profiler", &showProfiler);
+			}
+
+			if (ImGui::CollapsingHeader("Culling")) {
+				ImGui::Checkbox("Frustum culling", &frustumCulling);
+				ImGui::Checkbox("Use BVH", &bvhCulling);
+				ImGui::Checkbox("Occlusion culling", &occlusionCulling);
+				ImGui::Checkbox("Software rasterizer (CPU)", &softwareOcclusion);
+				ImGui::Checkbox("City blocks", &cityBlocks);
+				ImGui::SliderInt("Cull threads", &cullThreads, 1, 8);
+				ImGui::SliderInt("Benchmark objects", &numBenchmarkObjects, 0, 100000);
+				int numObjects = (int)sceneEntities.size();
+				int numDrawn = useIndirect ? indirectBatch.size() : renderQueue.size();
+				ImGui::Text("Objects: %i drawn: %i culled: %i", numObjects, numDrawn, numObjects - numDrawn);
+				float cullMs = bvhCulling ? sceneBVH.getStats().cullMs : cullingBounds.getStats().cullMs;
+				ImGui::Text("Cull time: %.3fms", frustumCulling && !gatherCulled ? cullMs : 0.0f);
+				ImGui::Text("Gather time: %.3fms%s", gatherMs, gatherCulled ? " (frustum culled)" : "");
+				ImGui::Text("BVH: %i nodes, built in %.3fms", sceneBVH.getStats().numNodes, sceneBVH.getStats().buildMs);
+				if (occlusionCulling && softwareOcclusion) {
+					const ew::RasterizerStats& rasterizerStats = occlusionRasterizer.getStats();
+					ImGui::Text("Occluders: %i triangles rasterized in %.3fms", rasterizerStats.numTriangles, rasterizerStats.rasterizeMs);
+					ImGui::Text("Occluded: %i of %i tested in %.3fms", rasterizerStats.numOccluded, rasterizerStats.numTested, rasterizerStats.cullMs);
+				}
+				else if (occlusionCulling) {
+					const ew::OcclusionStats& occlusionStats = hiZCuller.getStats();
+					ImGui::Text("Occluded (Hi-Z): %i of %i tested in %.3fms", occlusionStats.numOccluded, occlusionStats.numTested, occlusionStats.cullMs);
+				}
+				ImGui::Text("Triangles submitted: %i", trianglesSubmitted);
+			}
+
+			if (ImGui::CollapsingHeader("Picking")) {
+				ImGui::Text("Left click to pick");
+				if (pickHit.object >= 0) {
+					ImGui::Text("Object: %i triangle: %i", pickHit.object, pickHit.triangle);
+					ImGui::Text("Distance: %.3f", pickHit.distance);
+					ImGui::Text("Barycentric: %.3f %.3f %.3f", pickHit.barycentric.x, pickHit.barycentric.y, pickHit.barycentric.z);
+				}
+				else {
+					ImGui::Text("Nothing picked");
+				}
+				ImGui::Text("Pick time: %.3fms", pickMs);
+			}
+
 			ImGui::ColorEdit3("BG color", &bgColor.x);
 
 			ImGui::SliderInt("Number of lights", &numLights, 0, MAX_NUM_OF_LIGHTS);
@@ -213,29 +581,50 @@ int main() {
 				ImGui::PushID(i);
 				if (ImGui::CollapsingHeader("Light"))
 				{
-					ImGui::DragFloat3("Position", &lightsArray[i].transform.position.x, 0.1);
-					ImGui::ColorEdit3("Color", &lightsArray[i].color.x);
+					ImGui::DragFloat3("Position", &world.get<ew::Transform>(lightEntities[i])->position.x, 0.1);
+					ImGui::ColorEdit3("Color", &world.get<ew::Light>(lightEntities[i])->color.x);
 				}
 				ImGui::PopID();
 			}
 
 			if (ImGui::CollapsingHeader("Lighting Settings"))
 			{
-				ImGui::SliderFloat("Ambient", &material.ambient, 0.0f, 1.0f);
-				ImGui::SliderFloat("Diffuse", &material.diffuse, 0.0f, 1.0f);
-				ImGui::SliderFloat("Shine", &material.shine, 2.0f, 1024.0f);
-				ImGui::SliderFloat("Specular", &material.specular, 0.0f, 1.0f);
+				ImGui::SliderInt("Material", &editedMaterial, 0, materialTable.getNumMaterials() - 1);
+				ImGui::TextUnformatted(editedMaterial == brickMaterialIndex ? "Brick" : "Concrete (city buildings, multi-draw indirect only)");
+				ew::Material material = materialTable.getMaterial(editedMaterial);
+				bool edited = ImGui::SliderFloat("Ambient", &material.ambient, 0.0f, 1.0f);
+				edited |= ImGui::SliderFloat("Diffuse", &material.diffuse, 0.0f, 1.0f);
+				edited |= ImGui::SliderFloat("Shine", &material.shine, 2.0f, 1024.0f);
+				edited |= ImGui::SliderFloat("Specular", &material.specular, 0.0f, 1.0f);
+				if (edited) {
+					materialTable.setMaterial(editedMaterial, material);
+				}
 				ImGui::Checkbox("Blinn-Phong", &blinnPhong);
 			}
 
 			ImGui::End();
+
+			if (showProfiler) {
+				ew::profiler::drawWindow(&showProfiler);
+			}
 			
 			ImGui::Render();
 			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 		}
 
-		glfwSwapBuffers(window);
+		{
+			EW_PROFILE_SCOPE("Swap buffers");
+			glfwSwapBuffers(window);
+		}
+
+		//Startup time, including shader compilation or loading from the shader cache
+		if (firstFrame) {
+			firstFrame = false;
+			printf("Time to first frame: %.3fs\n", (float)glfwGetTime());
+		}
+		ew::profiler::endFrame();
 	}
+	ew::profiler::shutdown();
 	printf("Shutting down...");
 }
 
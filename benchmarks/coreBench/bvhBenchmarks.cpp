@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <ew/bvh.h>
+#include <ew/camera.h>
+#include <ew/ewMath/rng.h>
+
+//1M boxes of 0.5 to 2 units scattered in a 1000 unit cube
+static const int NUM_OBJECTS = 1000000;
+
+static std::vector<ew::AABB> randomBounds(uint64_t seed) {
+	ew::Rng rng(seed);
+	std::vector<ew::AABB> bounds(NUM_OBJECTS);
+	for (ew::AABB& box : bounds) {
+		const ew::Vec3 center(rng.range(-500.0f, 500.0f), rng.range(-500.0f, 500.0f), rng.range(-500.0f, 500.0f));
+		const ew::Vec3 extents(rng.range(0.25f, 1.0f), rng.range(0.25f, 1.0f), rng.range(0.25f, 1.0f));
+		box.min = center - extents;
+		box.max = center + extents;
+	}
+	return bounds;
+}
+
+//Built once and shared by the query benchmarks
+static ew::BVH& sharedBVH() {
+	static ew::BVH bvh;
+	if (bvh.size() == 0) {
+		bvh.build(randomBounds(1));
+	}
+	return bvh;
+}
+
+//Argument is the thread count
+static void BM_BVHBuild(benchmark::State& state) {
+	const std::vector<ew::AABB> bounds = randomBounds(1);
+	ew::BVH bvh;
+	for (auto _ : state) {
+		bvh.build(bounds, (int)state.range(0));
+	}
+	state.counters["nodes"] = (double)bvh.getStats().numNodes;
+	state.SetItemsProcessed(state.iterations() * NUM_OBJECTS);
+}
+BENCHMARK(BM_BVHBuild)->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//Every box moves by up to one unit, then the tree is refit
+static void BM_BVHRefit(benchmark::State& state) {
+	std::vector<ew::AABB> bounds = randomBounds(1);
+	ew::BVH bvh;
+	bvh.build(bounds);
+	ew::Rng rng(2);
+	for (ew::AABB& box : bounds) {
+		const ew::Vec3 offset(rng.range(-1.0f, 1.0f), rng.range(-1.0f, 1.0f), rng.range(-1.0f, 1.0f));
+		box.min += offset;
+		box.max += offset;
+	}
+	for (auto _ : state) {
+		bvh.refit(bounds);
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_OBJECTS);
+}
+BENCHMARK(BM_BVHRefit)->Unit(benchmark::kMillisecond);
+
+static void BM_BVHCull(benchmark::State& state) {
+	ew::BVH& bvh = sharedBVH();
+	ew::Camera camera;
+	camera.position = ew::Vec3(0, 0, 600);
+	camera.target = ew::Vec3(0);
+	camera.aspectRatio = 16.0f / 9.0f;
+	camera.farPlane = 1000.0f;
+	const ew::Frustum frustum = ew::CameraFrustum(camera);
+	std::vector<uint8_t> visible;
+	int numVisible = 0;
+	for (auto _ : state) {
+		numVisible = bvh.cull(frustum, visible);
+	}
+	state.counters["visible"] = (double)numVisible;
+	state.SetItemsProcessed(state.iterations() * NUM_OBJECTS);
+}
+BENCHMARK(BM_BVHCull)->Unit(benchmark::kMillisecond);
+
+//Rays from random points in random directions, hitting the boxes themselves
+static void BM_BVHRaycast(benchmark::State& state) {
+	const ew::BVH& bvh = sharedBVH();
+	const int NUM_RAYS = 4096;
+	ew::Rng rng(3);
+	std::vector<ew::Ray> rays(NUM_RAYS);
+	for (ew::Ray& ray : rays) {
+		ray.origin = ew::Vec3(rng.range(-500.0f, 500.0f), rng.range(-500.0f, 500.0f), rng.range(-500.0f, 500.0f));
+		ray.direction = rng.onUnitSphere();
+	}
+	int numHits = 0;
+	for (auto _ : state) {
+		numHits = 0;
+		for (const ew::Ray& ray : rays) {
+			ew::BVHRayHit hit;
+			numHits += bvh.raycast(ray, 2000.0f, &hit);
+		}
+	}
+	state.counters["hitRate"] = (double)numHits / NUM_RAYS;
+	state.SetItemsProcessed(state.iterations() * NUM_RAYS);
+}
+BENCHMARK(BM_BVHRaycast);
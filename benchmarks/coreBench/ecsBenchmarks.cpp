@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <ew/ecs.h>
+#include <ew/renderSystem.h>
+#include <ew/camera.h>
+
+//A scene of 1M renderable entities, a third of them with Bounds, scattered in a 1000 unit cube
+static const int NUM_ENTITIES = 1000000;
+
+//The ad-hoc layout the ECS replaces: every object is one struct holding all of its data
+struct SceneObject {
+	ew::Transform transform;
+	ew::MeshRef mesh;
+	ew::MaterialRef material;
+	ew::Bounds bounds;
+};
+
+static ew::Transform randomTransform(ew::Rng& rng) {
+	ew::Transform transform;
+	transform.position.x = rng.range(-500.0f, 500.0f);
+	transform.position.y = rng.range(-500.0f, 500.0f);
+	transform.position.z = rng.range(-500.0f, 500.0f);
+	transform.rotation.y = rng.range(0.0f, 360.0f);
+	return transform;
+}
+
+static ew::Bounds unitBounds() {
+	ew::Bounds bounds;
+	bounds.local.min = ew::Vec3(-0.5f);
+	bounds.local.max = ew::Vec3(0.5f);
+	return bounds;
+}
+
+static void createScene(ew::World& world) {
+	ew::Rng rng(1);
+	for (int i = 0; i < NUM_ENTITIES; i++)
+	{
+		if (i % 3 == 0) {
+			world.create(randomTransform(rng), ew::MeshRef(), ew::MaterialRef(), unitBounds());
+		}
+		else {
+			world.create(randomTransform(rng), ew::MeshRef(), ew::MaterialRef());
+		}
+	}
+}
+
+static ew::Camera benchmarkCamera() {
+	ew::Camera camera;
+	camera.position = ew::Vec3(0, 0, 600);
+	camera.target = ew::Vec3(0);
+	camera.aspectRatio = 16.0f / 9.0f;
+	camera.farPlane = 1000.0f;
+	return camera;
+}
+
+//Moves every object, touching only positions
+static void BM_SceneObjectsMove(benchmark::State& state) {
+	std::vector<SceneObject> objects(NUM_ENTITIES);
+	ew::Rng rng(1);
+	for (SceneObject& object : objects) {
+		object.transform = randomTransform(rng);
+		object.bounds = unitBounds();
+	}
+	for (auto _ : state) {
+		for (SceneObject& object : objects) {
+			object.transform.position.y += 0.01f;
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_ENTITIES);
+}
+BENCHMARK(BM_SceneObjectsMove)->Unit(benchmark::kMillisecond);
+
+static void BM_EcsMove(benchmark::State& state) {
+	ew::World world;
+	createScene(world);
+	for (auto _ : state) {
+		world.each<ew::Transform>([](ew::Transform& transform) {
+			transform.position.y += 0.01f;
+		});
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_ENTITIES);
+}
+BENCHMARK(BM_EcsMove)->Unit(benchmark::kMillisecond);
+
+//Argument is the thread count
+static void BM_EcsUpdateWorldBounds(benchmark::State& state) {
+	ew::World world;
+	createScene(world);
+	for (auto _ : state) {
+		ew::UpdateWorldBounds(world, (int)state.range(0));
+	}
+	state.SetItemsProcessed(state.iterations() * (NUM_ENTITIES / 3));
+}
+BENCHMARK(BM_EcsUpdateWorldBounds)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+//Culling, model matrices and depths for the render queue. Argument is the thread count
+static void BM_EcsGatherRenderables(benchmark::State& state) {
+	ew::World world;
+	createScene(world);
+	ew::UpdateWorldBounds(world, 1);
+	const ew::Camera camera = benchmarkCamera();
+	const ew::Frustum frustum = ew::CameraFrustum(camera);
+	std::vector<ew::Renderable> renderables;
+	for (auto _ : state) {
+		ew::GatherRenderables(world, frustum, camera.position, renderables, (int)state.range(0));
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_ENTITIES);
+	state.counters["renderables"] = (double)renderables.size();
+}
+BENCHMARK(BM_EcsGatherRenderables)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,158 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <math.h>
+#include <ew/ewMath/ewMath.h>
+#include <ew/ewMath/fastMath.h>
+
+//Each benchmark runs one precision tier over NUM_INPUTS random inputs. HIGH is the libm baseline.
+//maxError is measured afterwards against double precision libm, on a dense sweep of the range in the fastMath.h table
+static const int NUM_INPUTS = 4096;
+static const int NUM_ERROR_SAMPLES = 1 << 20;
+
+static std::vector<float> randomFloats(unsigned int seed, float min, float max) {
+	srand(seed);
+	std::vector<float> values(NUM_INPUTS);
+	for (float& v : values) {
+		v = ew::RandomRange(min, max);
+	}
+	return values;
+}
+
+//Inputs of the sweeps
+static float sweep(int i, float min, float max) {
+	return min + (max - min) * ((float)i / (NUM_ERROR_SAMPLES - 1));
+}
+
+//Absolute difference of two angles, ignoring whole turns
+static double angleError(double a, double b) {
+	const double error = fabs(a - b);
+	return fmin(error, fabs(error - 6.283185307179586));
+}
+
+template<ew::Precision P>
+static void BM_SinCos(benchmark::State& state) {
+	std::vector<float> angles = randomFloats(1, -100.0f, 100.0f);
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_INPUTS; i++)
+		{
+			float s, c;
+			ew::SinCos<P>(angles[i], s, c);
+			benchmark::DoNotOptimize(s);
+			benchmark::DoNotOptimize(c);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+	double maxError = 0.0;
+	for (int i = 0; i < NUM_ERROR_SAMPLES; i++)
+	{
+		const float rad = sweep(i, -1000.0f, 1000.0f);
+		float s, c;
+		ew::SinCos<P>(rad, s, c);
+		maxError = fmax(maxError, fmax(fabs(s - sin((double)rad)), fabs(c - cos((double)rad))));
+	}
+	state.counters["maxError"] = maxError;
+}
+BENCHMARK_TEMPLATE(BM_SinCos, ew::Precision::LOW);
+BENCHMARK_TEMPLATE(BM_SinCos, ew::Precision::MEDIUM);
+BENCHMARK_TEMPLATE(BM_SinCos, ew::Precision::HIGH);
+
+//MEDIUM, 8 (AVX) or 4 (SSE) angles at a time
+static void BM_SinCosBulk(benchmark::State& state) {
+	std::vector<float> angles = randomFloats(1, -100.0f, 100.0f);
+	std::vector<float> sines(NUM_INPUTS), cosines(NUM_INPUTS);
+	for (auto _ : state) {
+		ew::SinCos(angles.data(), sines.data(), cosines.data(), NUM_INPUTS);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+	std::vector<float> sweepAngles(NUM_ERROR_SAMPLES);
+	for (int i = 0; i < NUM_ERROR_SAMPLES; i++)
+	{
+		sweepAngles[i] = sweep(i, -1000.0f, 1000.0f);
+	}
+	sines.resize(NUM_ERROR_SAMPLES);
+	cosines.resize(NUM_ERROR_SAMPLES);
+	ew::SinCos(sweepAngles.data(), sines.data(), cosines.data(), NUM_ERROR_SAMPLES);
+	double maxError = 0.0;
+	for (int i = 0; i < NUM_ERROR_SAMPLES; i++)
+	{
+		maxError = fmax(maxError, fmax(fabs(sines[i] - sin((double)sweepAngles[i])), fabs(cosines[i] - cos((double)sweepAngles[i]))));
+	}
+	state.counters["maxError"] = maxError;
+}
+BENCHMARK(BM_SinCosBulk);
+
+//maxError is relative
+template<ew::Precision P>
+static void BM_Rsqrt(benchmark::State& state) {
+	std::vector<float> values = randomFloats(2, 0.001f, 1000.0f);
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_INPUTS; i++)
+		{
+			benchmark::DoNotOptimize(ew::Rsqrt<P>(values[i]));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+	double maxError = 0.0;
+	for (int i = 0; i < NUM_ERROR_SAMPLES; i++)
+	{
+		//Log spaced over 1e-6..1e6
+		const float x = powf(10.0f, sweep(i, -6.0f, 6.0f));
+		const double expected = 1.0 / sqrt((double)x);
+		maxError = fmax(maxError, fabs(ew::Rsqrt<P>(x) - expected) / expected);
+	}
+	state.counters["maxError"] = maxError;
+}
+BENCHMARK_TEMPLATE(BM_Rsqrt, ew::Precision::LOW);
+BENCHMARK_TEMPLATE(BM_Rsqrt, ew::Precision::MEDIUM);
+BENCHMARK_TEMPLATE(BM_Rsqrt, ew::Precision::HIGH);
+
+template<ew::Precision P>
+static void BM_Atan2(benchmark::State& state) {
+	std::vector<float> ys = randomFloats(3, -10.0f, 10.0f);
+	std::vector<float> xs = randomFloats(4, -10.0f, 10.0f);
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_INPUTS; i++)
+		{
+			benchmark::DoNotOptimize(ew::Atan2<P>(ys[i], xs[i]));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+	//Every direction, at a small and a large distance
+	double maxError = 0.0;
+	for (int i = 0; i < NUM_ERROR_SAMPLES; i++)
+	{
+		const double angle = sweep(i, -ew::PI, ew::PI);
+		for (float distance : { 0.001f, 1000.0f })
+		{
+			const float y = (float)(sin(angle) * distance), x = (float)(cos(angle) * distance);
+			maxError = fmax(maxError, angleError(ew::Atan2<P>(y, x), atan2((double)y, (double)x)));
+		}
+	}
+	state.counters["maxError"] = maxError;
+}
+BENCHMARK_TEMPLATE(BM_Atan2, ew::Precision::LOW);
+BENCHMARK_TEMPLATE(BM_Atan2, ew::Precision::MEDIUM);
+BENCHMARK_TEMPLATE(BM_Atan2, ew::Precision::HIGH);
+
+template<ew::Precision P>
+static void BM_Acos(benchmark::State& state) {
+	std::vector<float> values = randomFloats(5, -1.0f, 1.0f);
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_INPUTS; i++)
+		{
+			benchmark::DoNotOptimize(ew::Acos<P>(values[i]));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+	double maxError = 0.0;
+	for (int i = 0; i < NUM_ERROR_SAMPLES; i++)
+	{
+		const float x = sweep(i, -1.0f, 1.0f);
+		maxError = fmax(maxError, fabs(ew::Acos<P>(x) - acos((double)x)));
+	}
+	state.counters["maxError"] = maxError;
+}
+BENCHMARK_TEMPLATE(BM_Acos, ew::Precision::LOW);
+BENCHMARK_TEMPLATE(BM_Acos, ew::Precision::MEDIUM);
+BENCHMARK_TEMPLATE(BM_Acos, ew::Precision::HIGH);
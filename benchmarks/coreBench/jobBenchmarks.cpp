@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <vector>
+#include <thread>
+#include <math.h>
+#include <ew/jobSystem.h>
+#include <ew/procGen.h>
+
+//Scaling of JobSystem from 1 thread (no workers) to every hardware thread. The argument is the total thread count,
+//including the benchmark thread that queues the work and helps while waiting
+static void threadCounts(benchmark::internal::Benchmark* benchmark) {
+	const int maxThreads = std::max(1, (int)std::thread::hardware_concurrency());
+	for (int threads = 1; threads < maxThreads; threads *= 2)
+	{
+		benchmark->Arg(threads);
+	}
+	benchmark->Arg(maxThreads);
+	benchmark->UseRealTime();
+}
+
+//Synthetic compute bound workload: a short chain of transcendental math per element
+static const int NUM_ELEMENTS = 1 << 20;
+
+static void BM_JobsParallelFor(benchmark::State& state) {
+	ew::JobSystem jobSystem((int)state.range(0) - 1);
+	std::vector<float> values(NUM_ELEMENTS);
+	for (auto _ : state) {
+		jobSystem.parallelFor(0, NUM_ELEMENTS, 4096, [&values](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+			{
+				const float x = (float)i * 0.001f;
+				values[i] = sqrtf(sinf(x) * sinf(x) + cosf(x * 0.5f) + 2.0f);
+			}
+		});
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_ELEMENTS);
+}
+BENCHMARK(BM_JobsParallelFor)->Apply(threadCounts);
+
+//Same loop split into 64 element ranges, so scheduling overhead dominates. jobs is the number of ranges per iteration
+static void BM_JobsFineGrained(benchmark::State& state) {
+	ew::JobSystem jobSystem((int)state.range(0) - 1);
+	const int GRAIN_SIZE = 64;
+	std::vector<float> values(NUM_ELEMENTS / 16);
+	for (auto _ : state) {
+		jobSystem.parallelFor(0, values.size(), GRAIN_SIZE, [&values](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+			{
+				values[i] = (float)i * 0.5f + 1.0f;
+			}
+		});
+		benchmark::ClobberMemory();
+	}
+	state.counters["jobs"] = (double)(values.size() / GRAIN_SIZE);
+	state.SetItemsProcessed(state.iterations() * (values.size() / GRAIN_SIZE));
+}
+BENCHMARK(BM_JobsFineGrained)->Apply(threadCounts);
+
+//Independent jobs with a dependency: the second batch only starts once the first has finished
+static void BM_JobsDependentBatches(benchmark::State& state) {
+	ew::JobSystem jobSystem((int)state.range(0) - 1);
+	const int NUM_JOBS = 256;
+	std::vector<float> values(NUM_JOBS * 1024);
+	for (auto _ : state) {
+		ew::JobCounter first, second;
+		for (int job = 0; job < NUM_JOBS; job++)
+		{
+			jobSystem.run([&values, job]() {
+				for (int i = job * 1024; i < (job + 1) * 1024; i++)
+				{
+					values[i] = sinf((float)i);
+				}
+			}, &first);
+		}
+		for (int job = 0; job < NUM_JOBS; job++)
+		{
+			jobSystem.run([&values, job]() {
+				for (int i = job * 1024; i < (job + 1) * 1024; i++)
+				{
+					values[i] = sqrtf(values[i] * values[i] + 1.0f);
+				}
+			}, &second, &first);
+		}
+		jobSystem.wait(second);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_JOBS * 2);
+}
+BENCHMARK(BM_JobsDependentBatches)->Apply(threadCounts);
+
+//A batch of spheres generated in parallel, one job per sphere, as when loading a scene
+static void BM_JobsCreateSphereBatch(benchmark::State& state) {
+	ew::JobSystem jobSystem((int)state.range(0) - 1);
+	const int NUM_SPHERES = 64;
+	std::vector<ew::MeshData> spheres(NUM_SPHERES);
+	for (auto _ : state) {
+		jobSystem.parallelFor(0, NUM_SPHERES, 1, [&spheres](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+			{
+				spheres[i] = ew::createSphere(1.0f, 64);
+			}
+		});
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_SPHERES);
+}
+BENCHMARK(BM_JobsCreateSphereBatch)->Apply(threadCounts);
@@ -0,0 +1,31 @@
+#include <benchmark/benchmark.h>
+#include <string.h>
+#include <vector>
+
+//Usage: core_bench [Google Benchmark options]
+//Results are also written to core_bench.json, so runs on different commits can be compared with
+//Google Benchmark's tools/compare.py. Pass --benchmark_out to choose another file.
+int main(int argc, char* argv[]) {
+	std::vector<char*> args(argv, argv + argc);
+	bool hasOut = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strncmp(argv[i], "--benchmark_out=", 16) == 0) {
+			hasOut = true;
+		}
+	}
+	char outArg[] = "--benchmark_out=core_bench.json";
+	char formatArg[] = "--benchmark_out_format=json";
+	if (!hasOut) {
+		args.push_back(outArg);
+		args.push_back(formatArg);
+	}
+	int numArgs = (int)args.size();
+	benchmark::Initialize(&numArgs, args.data());
+	if (benchmark::ReportUnrecognizedArguments(numArgs, args.data())) {
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
@@ -0,0 +1,319 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <ew/ewMath/ewMath.h>
+#include <ew/ewMath/transformations.h>
+#include <ew/transform.h>
+
+//Inputs are generated up front with a fixed seed, so every run measures the same values
+static const int NUM_INPUTS = 1024;
+
+static std::vector<ew::Mat4> randomMatrices() {
+	srand(1);
+	std::vector<ew::Mat4> matrices(NUM_INPUTS);
+	for (ew::Mat4& m : matrices) {
+		for (int i = 0; i < 4; i++)
+		{
+			m[i] = ew::Vec4(ew::RandomRange(-1, 1), ew::RandomRange(-1, 1), ew::RandomRange(-1, 1), ew::RandomRange(-1, 1));
+		}
+	}
+	return matrices;
+}
+
+static std::vector<ew::Vec3> randomVectors() {
+	srand(2);
+	std::vector<ew::Vec3> vectors(NUM_INPUTS);
+	for (ew::Vec3& v : vectors) {
+		v = ew::Vec3(ew::RandomRange(-10, 10), ew::RandomRange(-10, 10), ew::RandomRange(-10, 10));
+	}
+	return vectors;
+}
+
+static std::vector<ew::Transform> randomTransforms() {
+	srand(3);
+	std::vector<ew::Transform> transforms(NUM_INPUTS);
+	for (ew::Transform& t : transforms) {
+		t.position = ew::Vec3(ew::RandomRange(-10, 10), ew::RandomRange(-10, 10), ew::RandomRange(-10, 10));
+		t.rotation = ew::Vec3(ew::RandomRange(0, 360), ew::RandomRange(0, 360), ew::RandomRange(0, 360));
+		t.scale = ew::Vec3(ew::RandomRange(0.5f, 2), ew::RandomRange(0.5f, 2), ew::RandomRange(0.5f, 2));
+	}
+	return transforms;
+}
+
+static void BM_Mat4Multiply(benchmark::State& state) {
+	std::vector<ew::Mat4> matrices = randomMatrices();
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_INPUTS; i++)
+		{
+			ew::Mat4 m = matrices[i] * matrices[(i + 1) % NUM_INPUTS];
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+}
+BENCHMARK(BM_Mat4Multiply);
+
+static void BM_Mat4MultiplyVec4(benchmark::State& state) {
+	std::vector<ew::Mat4> matrices = randomMatrices();
+	std::vector<ew::Vec3> vectors = randomVectors();
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_INPUTS; i++)
+		{
+			ew::Vec4 v = matrices[i] * ew::Vec4(vectors[i], 1.0f);
+			benchmark::DoNotOptimize(v);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+}
+BENCHMARK(BM_Mat4MultiplyVec4);
+
+static void BM_LookAt(benchmark::State& state) {
+	std::vector<ew::Vec3> vectors = randomVectors();
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_INPUTS; i++)
+		{
+			ew::Mat4 m = ew::LookAt(vectors[i], vectors[(i + 1) % NUM_INPUTS], ew::Vec3(0, 1, 0));
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+}
+BENCHMARK(BM_LookAt);
+
+static void BM_Perspective(benchmark::State& state) {
+	std::vector<ew::Vec3> vectors = randomVectors();
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_INPUTS; i++)
+		{
+			//Field of view 40 to 100 degrees, varied so the tangent isn't hoisted out of the loop
+			ew::Mat4 m = ew::Perspective(ew::Radians(70.0f + vectors[i].x * 3.0f), 1.777f, 0.1f, 100.0f);
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+}
+BENCHMARK(BM_Perspective);
+
+static void BM_TransformGetModelMatrix(benchmark::State& state) {
+	std::vector<ew::Transform> transforms = randomTransforms();
+	for (auto _ : state) {
+		for (const ew::Transform& transform : transforms) {
+			ew::Mat4 m = transform.getModelMatrix();
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+}
+BENCHMARK(BM_TransformGetModelMatrix);
+
+static void BM_TransformGetInverseModelMatrix(benchmark::State& state) {
+	std::vector<ew::Transform> transforms = randomTransforms();
+	for (auto _ : state) {
+		for (const ew::Transform& transform : transforms) {
+			ew::Mat4 m = transform.getInverseModelMatrix();
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+}
+BENCHMARK(BM_TransformGetInverseModelMatrix);
+
+static void BM_NormalizeVec3(benchmark::State& state) {
+	std::vector<ew::Vec3> vectors = randomVectors();
+	for (auto _ : state) {
+		for (const ew::Vec3& v : vectors) {
+			ew::Vec3 n = ew::Normalize(v);
+			benchmark::DoNotOptimize(n);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+}
+BENCHMARK(BM_NormalizeVec3);
+
+static std::vector<ew::Quat> randomRotations() {
+	srand(4);
+	std::vector<ew::Quat> rotations(NUM_INPUTS);
+	for (ew::Quat& q : rotations) {
+		q = ew::QuatFromEuler(ew::Vec3(ew::RandomRange(-ew::PI, ew::PI), ew::RandomRange(-ew::PI, ew::PI), ew::RandomRange(-ew::PI, ew::PI)));
+	}
+	return rotations;
+}
+
+static void BM_QuatTransformGetModelMatrix(benchmark::State& state) {
+	std::vector<ew::Transform> transforms = randomTransforms();
+	std::vector<ew::QuatTransform> quatTransforms(transforms.begin(), transforms.end());
+	for (auto _ : state) {
+		for (const ew::QuatTransform& transform : quatTransforms) {
+			ew::Mat4 m = transform.getModelMatrix();
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+}
+BENCHMARK(BM_QuatTransformGetModelMatrix);
+
+static void BM_QuatTransformGetInverseModelMatrix(benchmark::State& state) {
+	std::vector<ew::Transform> transforms = randomTransforms();
+	std::vector<ew::QuatTransform> quatTransforms(transforms.begin(), transforms.end());
+	for (auto _ : state) {
+		for (const ew::QuatTransform& transform : quatTransforms) {
+			ew::Mat4 m = transform.getInverseModelMatrix();
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+}
+BENCHMARK(BM_QuatTransformGetInverseModelMatrix);
+
+static void BM_QuatMultiply(benchmark::State& state) {
+	std::vector<ew::Quat> rotations = randomRotations();
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_INPUTS; i++)
+		{
+			ew::Quat q = rotations[i] * rotations[(i + 1) % NUM_INPUTS];
+			benchmark::DoNotOptimize(q);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+}
+BENCHMARK(BM_QuatMultiply);
+
+static void BM_QuatSlerp(benchmark::State& state) {
+	std::vector<ew::Quat> rotations = randomRotations();
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_INPUTS; i++)
+		{
+			ew::Quat q = ew::Slerp(rotations[i], rotations[(i + 1) % NUM_INPUTS], (i % 16) / 16.0f);
+			benchmark::DoNotOptimize(q);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+}
+BENCHMARK(BM_QuatSlerp);
+
+static void BM_QuatNlerp(benchmark::State& state) {
+	std::vector<ew::Quat> rotations = randomRotations();
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_INPUTS; i++)
+		{
+			ew::Quat q = ew::Nlerp(rotations[i], rotations[(i + 1) % NUM_INPUTS], (i % 16) / 16.0f);
+			benchmark::DoNotOptimize(q);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+}
+BENCHMARK(BM_QuatNlerp);
+
+static std::vector<ew::Mat4> randomModelMatrices() {
+	std::vector<ew::Transform> transforms = randomTransforms();
+	std::vector<ew::Mat4> matrices(NUM_INPUTS);
+	for (int i = 0; i < NUM_INPUTS; i++)
+	{
+		matrices[i] = transforms[i].getModelMatrix();
+	}
+	return matrices;
+}
+
+//Largest absolute difference between m * inverse and the identity
+static float maxIdentityError(const ew::Mat4& m, const ew::Mat4& inverse) {
+	const ew::Mat4 product = m * inverse;
+	const ew::Mat4 identity = ew::IdentityMatrix();
+	float maxError = 0.0f;
+	for (int c = 0; c < 4; c++)
+	{
+		for (int r = 0; r < 4; r++)
+		{
+			maxError = std::fmaxf(maxError, fabsf(product[c][r] - identity[c][r]));
+		}
+	}
+	return maxError;
+}
+
+static void BM_Mat4Transpose(benchmark::State& state) {
+	std::vector<ew::Mat4> matrices = randomMatrices();
+	for (auto _ : state) {
+		for (const ew::Mat4& matrix : matrices) {
+			ew::Mat4 m = ew::Transpose(matrix);
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+}
+BENCHMARK(BM_Mat4Transpose);
+
+//Random matrices are occasionally close to singular, so maxError is larger than for model matrices
+static void BM_Mat4Inverse(benchmark::State& state) {
+	std::vector<ew::Mat4> matrices = randomMatrices();
+	for (auto _ : state) {
+		for (const ew::Mat4& matrix : matrices) {
+			ew::Mat4 m = ew::Inverse(matrix);
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+	float maxError = 0.0f;
+	for (const ew::Mat4& matrix : matrices) {
+		maxError = std::fmaxf(maxError, maxIdentityError(matrix, ew::Inverse(matrix)));
+	}
+	state.counters["maxError"] = maxError;
+}
+BENCHMARK(BM_Mat4Inverse);
+
+static void BM_Mat4InverseModelMatrix(benchmark::State& state) {
+	std::vector<ew::Mat4> matrices = randomModelMatrices();
+	for (auto _ : state) {
+		for (const ew::Mat4& matrix : matrices) {
+			ew::Mat4 m = ew::Inverse(matrix);
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+	float maxError = 0.0f;
+	for (const ew::Mat4& matrix : matrices) {
+		maxError = std::fmaxf(maxError, maxIdentityError(matrix, ew::Inverse(matrix)));
+	}
+	state.counters["maxError"] = maxError;
+}
+BENCHMARK(BM_Mat4InverseModelMatrix);
+
+static void BM_Mat4AffineInverse(benchmark::State& state) {
+	std::vector<ew::Mat4> matrices = randomModelMatrices();
+	for (auto _ : state) {
+		for (const ew::Mat4& matrix : matrices) {
+			ew::Mat4 m = ew::AffineInverse(matrix);
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+	float maxError = 0.0f;
+	for (const ew::Mat4& matrix : matrices) {
+		maxError = std::fmaxf(maxError, maxIdentityError(matrix, ew::AffineInverse(matrix)));
+	}
+	state.counters["maxError"] = maxError;
+}
+BENCHMARK(BM_Mat4AffineInverse);
+
+//maxError is against the transposed general inverse
+static void BM_NormalMatrix(benchmark::State& state) {
+	std::vector<ew::Mat4> matrices = randomModelMatrices();
+	for (auto _ : state) {
+		for (const ew::Mat4& matrix : matrices) {
+			ew::Mat4 m = ew::NormalMatrix(matrix);
+			benchmark::DoNotOptimize(m);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_INPUTS);
+	float maxError = 0.0f;
+	for (const ew::Mat4& matrix : matrices) {
+		const ew::Mat4 normalMatrix = ew::NormalMatrix(matrix);
+		const ew::Mat4 expected = ew::Transpose(ew::Inverse(matrix));
+		for (int c = 0; c < 3; c++)
+		{
+			for (int r = 0; r < 3; r++)
+			{
+				maxError = std::fmaxf(maxError, fabsf(normalMatrix[c][r] - expected[c][r]));
+			}
+		}
+	}
+	state.counters["maxError"] = maxError;
+}
+BENCHMARK(BM_NormalMatrix);
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include <ew/procGen.h>
+#include <MyLibrary/procGen.h>
+
+//Reports vertices generated per second alongside time per mesh
+static void setCounters(benchmark::State& state, const ew::MeshData& meshData) {
+	state.counters["vertices"] = (double)meshData.vertices.size();
+	state.counters["indices"] = (double)meshData.indices.size();
+	state.counters["verticesPerSecond"] = benchmark::Counter((double)meshData.vertices.size(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static void BM_EwCreateCube(benchmark::State& state) {
+	ew::MeshData meshData;
+	for (auto _ : state) {
+		meshData = ew::createCube(1.0f);
+		benchmark::DoNotOptimize(meshData.vertices.data());
+	}
+	setCounters(state, meshData);
+}
+BENCHMARK(BM_EwCreateCube);
+
+static void BM_EwCreatePlane(benchmark::State& state) {
+	ew::MeshData meshData;
+	for (auto _ : state) {
+		meshData = ew::createPlane(1.0f, 1.0f, (int)state.range(0));
+		benchmark::DoNotOptimize(meshData.vertices.data());
+	}
+	setCounters(state, meshData);
+}
+BENCHMARK(BM_EwCreatePlane)->RangeMultiplier(4)->Range(4, 256);
+
+static void BM_EwCreateSphere(benchmark::State& state) {
+	ew::MeshData meshData;
+	for (auto _ : state) {
+		meshData = ew::createSphere(1.0f, (int)state.range(0));
+		benchmark::DoNotOptimize(meshData.vertices.data());
+	}
+	setCounters(state, meshData);
+}
+BENCHMARK(BM_EwCreateSphere)->RangeMultiplier(4)->Range(4, 256);
+
+static void BM_EwCreateCylinder(benchmark::State& state) {
+	ew::MeshData meshData;
+	for (auto _ : state) {
+		meshData = ew::createCylinder(0.5f, 1.0f, (int)state.range(0));
+		benchmark::DoNotOptimize(meshData.vertices.data());
+	}
+	setCounters(state, meshData);
+}
+BENCHMARK(BM_EwCreateCylinder)->RangeMultiplier(4)->Range(4, 256);
+
+static void BM_MyLibraryCreatePlane(benchmark::State& state) {
+	ew::MeshData meshData;
+	for (auto _ : state) {
+		meshData = MyLibrary::createPlane(1.0f, (int)state.range(0));
+		benchmark::DoNotOptimize(meshData.vertices.data());
+	}
+	setCounters(state, meshData);
+}
+BENCHMARK(BM_MyLibraryCreatePlane)->RangeMultiplier(4)->Range(4, 256);
+
+static void BM_MyLibraryCreateSphere(benchmark::State& state) {
+	ew::MeshData meshData;
+	for (auto _ : state) {
+		meshData = MyLibrary::createSphere(1.0f, (int)state.range(0));
+		benchmark::DoNotOptimize(meshData.vertices.data());
+	}
+	setCounters(state, meshData);
+}
+BENCHMARK(BM_MyLibraryCreateSphere)->RangeMultiplier(4)->Range(4, 256);
+
+static void BM_MyLibraryCreateCylinder(benchmark::State& state) {
+	ew::MeshData meshData;
+	for (auto _ : state) {
+		meshData = MyLibrary::createCylinder(1.0f, 0.5f, (int)state.range(0));
+		benchmark::DoNotOptimize(meshData.vertices.data());
+	}
+	setCounters(state, meshData);
+}
+BENCHMARK(BM_MyLibraryCreateCylinder)->RangeMultiplier(4)->Range(4, 256);
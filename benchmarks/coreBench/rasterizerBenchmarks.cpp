@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <ew/occlusionRasterizer.h>
+#include <ew/procGen.h>
+#include <ew/camera.h>
+#include <ew/ewMath/transformations.h>
+
+//Fixed occluder set: a 16x16 grid of buildings around the camera, with a sphere on every fourth one
+struct OccluderScene {
+	ew::MeshData cube = ew::createCube(1.0f);
+	ew::MeshData sphere = ew::createSphere(1.0f, 32);
+	std::vector<ew::Mat4> cubeModels;
+	std::vector<ew::Mat4> sphereModels;
+	ew::Mat4 viewProjection;
+	int numTriangles = 0;
+
+	OccluderScene() {
+		for (int z = 0; z < 16; z++)
+		{
+			for (int x = 0; x < 16; x++)
+			{
+				const float height = 2.0f + (float)((x * 7 + z * 3) % 5);
+				const ew::Vec3 position((x - 7.5f) * 6.0f, height * 0.5f, (z - 7.5f) * 6.0f);
+				cubeModels.push_back(ew::Translate(position) * ew::Scale(ew::Vec3(3.0f, height, 3.0f)));
+				if ((x + z) % 4 == 0) {
+					sphereModels.push_back(ew::Translate(position + ew::Vec3(0, height * 0.5f + 1.0f, 0)));
+				}
+			}
+		}
+		numTriangles = (int)(cubeModels.size() * cube.indices.size() + sphereModels.size() * sphere.indices.size()) / 3;
+		ew::Camera camera;
+		camera.position = ew::Vec3(0, 4, 40);
+		camera.target = ew::Vec3(0, 2, 0);
+		camera.aspectRatio = 2.0f;
+		camera.farPlane = 200.0f;
+		viewProjection = camera.ProjectionMatrix() * camera.ViewMatrix();
+	}
+};
+
+//Argument is the thread count
+static void BM_OcclusionRasterize(benchmark::State& state) {
+	static const OccluderScene scene;
+	ew::OcclusionRasterizer rasterizer(256, 128);
+	for (auto _ : state) {
+		rasterizer.beginOccluders(scene.viewProjection);
+		for (const ew::Mat4& model : scene.cubeModels) {
+			rasterizer.addOccluder(scene.cube, model);
+		}
+		for (const ew::Mat4& model : scene.sphereModels) {
+			rasterizer.addOccluder(scene.sphere, model);
+		}
+		rasterizer.endOccluders((int)state.range(0));
+		benchmark::DoNotOptimize(rasterizer.getDepthBuffer().data());
+	}
+	state.counters["triangles"] = benchmark::Counter((double)state.iterations() * scene.numTriangles, benchmark::Counter::kIsRate);
+	state.counters["rasterized"] = (double)rasterizer.getStats().numTrianglesRasterized;
+}
+BENCHMARK(BM_OcclusionRasterize)->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <stdlib.h>
+#include <ew/ewMath/ewMath.h>
+#include <ew/ewMath/rng.h>
+
+//Random floats in [-10, 10), the way scenes scatter objects. The threaded runs show rand() serializing on its lock,
+//while each thread's ThreadRng runs independently
+static const int NUM_VALUES = 4096;
+
+static void BM_RandRandomRange(benchmark::State& state) {
+	if (state.thread_index() == 0) {
+		srand(1);
+	}
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_VALUES; i++)
+		{
+			benchmark::DoNotOptimize(ew::RandomRange(-10.0f, 10.0f));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+BENCHMARK(BM_RandRandomRange)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_RngRange(benchmark::State& state) {
+	ew::Rng& rng = ew::ThreadRng();
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_VALUES; i++)
+		{
+			benchmark::DoNotOptimize(rng.range(-10.0f, 10.0f));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+BENCHMARK(BM_RngRange)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_RngFillFloats(benchmark::State& state) {
+	ew::Rng& rng = ew::ThreadRng();
+	std::vector<float> values(NUM_VALUES);
+	for (auto _ : state) {
+		rng.fillFloats(values.data(), NUM_VALUES, -10.0f, 10.0f);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+BENCHMARK(BM_RngFillFloats)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_RngOnUnitSphere(benchmark::State& state) {
+	ew::Rng rng(1);
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_VALUES; i++)
+		{
+			benchmark::DoNotOptimize(rng.onUnitSphere());
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+BENCHMARK(BM_RngOnUnitSphere);
+
+//meanDot is the average of Dot(sample, normal), 0.5 for a uniform hemisphere
+static void BM_RngFillHemisphere(benchmark::State& state) {
+	ew::Rng rng(1);
+	const ew::Vec3 normal = ew::Normalize(ew::Vec3(1, 2, 3));
+	ew::Vec3Stream samples;
+	for (auto _ : state) {
+		rng.fillHemisphere(normal, NUM_VALUES, samples);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+	double sumDot = 0.0;
+	for (size_t i = 0; i < samples.size(); i++)
+	{
+		sumDot += ew::Dot(samples.get(i), normal);
+	}
+	state.counters["meanDot"] = sumDot / samples.size();
+}
+BENCHMARK(BM_RngFillHemisphere);
@@ -0,0 +1,256 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <ew/ewMath/ewMath.h>
+#include <ew/ewMath/vec3Stream.h>
+#include <ew/ewMath/vec4x8.h>
+#include <ew/ewMath/transformations.h>
+#include <ew/mesh.h>
+
+//Each pair runs the same operation on an array of Vec3s (AoS, the scalar ewMath path) and on a Vec3Stream (SoA),
+//or on an array of Vec4s and on Vec4x8 packets.
+//The count fits in L2, so the comparison is compute bound
+static const int NUM_VECTORS = 16384;
+
+static std::vector<ew::Vec3> randomVec3s(unsigned int seed) {
+	srand(seed);
+	std::vector<ew::Vec3> vectors(NUM_VECTORS);
+	for (ew::Vec3& v : vectors) {
+		v = ew::Vec3(ew::RandomRange(-10, 10), ew::RandomRange(-10, 10), ew::RandomRange(-10, 10));
+	}
+	return vectors;
+}
+
+//Particle integration, position += velocity * dt
+static void BM_AoSMulAdd(benchmark::State& state) {
+	std::vector<ew::Vec3> positions = randomVec3s(1);
+	std::vector<ew::Vec3> velocities = randomVec3s(2);
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_VECTORS; i++)
+		{
+			positions[i] += velocities[i] * 0.016f;
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_AoSMulAdd);
+
+static void BM_SoAMulAdd(benchmark::State& state) {
+	ew::Vec3Stream positions(randomVec3s(1));
+	ew::Vec3Stream velocities(randomVec3s(2));
+	for (auto _ : state) {
+		ew::MulAdd(velocities, 0.016f, positions, positions);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_SoAMulAdd);
+
+static void BM_AoSNormalize(benchmark::State& state) {
+	std::vector<ew::Vec3> vectors = randomVec3s(1);
+	std::vector<ew::Vec3> normalized(NUM_VECTORS);
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_VECTORS; i++)
+		{
+			normalized[i] = ew::Normalize(vectors[i]);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_AoSNormalize);
+
+//maxError is the largest distance from the scalar Normalize
+static void BM_SoANormalize(benchmark::State& state) {
+	std::vector<ew::Vec3> input = randomVec3s(1);
+	ew::Vec3Stream vectors(input);
+	ew::Vec3Stream normalized;
+	for (auto _ : state) {
+		ew::Normalize(vectors, normalized);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+	float maxError = 0.0f;
+	for (int i = 0; i < NUM_VECTORS; i++)
+	{
+		maxError = std::fmaxf(maxError, ew::Magnitude(normalized.get(i) - ew::Normalize(input[i])));
+	}
+	state.counters["maxError"] = maxError;
+}
+BENCHMARK(BM_SoANormalize);
+
+static void BM_AoSCross(benchmark::State& state) {
+	std::vector<ew::Vec3> a = randomVec3s(1);
+	std::vector<ew::Vec3> b = randomVec3s(2);
+	std::vector<ew::Vec3> result(NUM_VECTORS);
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_VECTORS; i++)
+		{
+			result[i] = ew::Cross(a[i], b[i]);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_AoSCross);
+
+static void BM_SoACross(benchmark::State& state) {
+	ew::Vec3Stream a(randomVec3s(1));
+	ew::Vec3Stream b(randomVec3s(2));
+	ew::Vec3Stream result;
+	for (auto _ : state) {
+		ew::Cross(a, b, result);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_SoACross);
+
+static void BM_AoSDot(benchmark::State& state) {
+	std::vector<ew::Vec3> a = randomVec3s(1);
+	std::vector<ew::Vec3> b = randomVec3s(2);
+	std::vector<float> result(NUM_VECTORS);
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_VECTORS; i++)
+		{
+			result[i] = ew::Dot(a[i], b[i]);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_AoSDot);
+
+static void BM_SoADot(benchmark::State& state) {
+	ew::Vec3Stream a(randomVec3s(1));
+	ew::Vec3Stream b(randomVec3s(2));
+	std::vector<float> result;
+	for (auto _ : state) {
+		ew::Dot(a, b, result);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_SoADot);
+
+static void BM_AoSLerp(benchmark::State& state) {
+	std::vector<ew::Vec3> a = randomVec3s(1);
+	std::vector<ew::Vec3> b = randomVec3s(2);
+	std::vector<ew::Vec3> result(NUM_VECTORS);
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_VECTORS; i++)
+		{
+			result[i] = a[i] + (b[i] - a[i]) * 0.25f;
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_AoSLerp);
+
+static void BM_SoALerp(benchmark::State& state) {
+	ew::Vec3Stream a(randomVec3s(1));
+	ew::Vec3Stream b(randomVec3s(2));
+	ew::Vec3Stream result;
+	for (auto _ : state) {
+		ew::Lerp(a, b, 0.25f, result);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_SoALerp);
+
+//Cost of converting mesh vertices to a stream and back, to weigh against the savings above
+static void BM_GatherPositions(benchmark::State& state) {
+	std::vector<ew::Vec3> positions = randomVec3s(1);
+	std::vector<ew::Vertex> vertices(NUM_VECTORS);
+	for (int i = 0; i < NUM_VECTORS; i++)
+	{
+		vertices[i].pos = positions[i];
+	}
+	ew::Vec3Stream stream;
+	for (auto _ : state) {
+		ew::GatherPositions(vertices, stream);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_GatherPositions);
+
+static void BM_ScatterPositions(benchmark::State& state) {
+	ew::Vec3Stream stream(randomVec3s(1));
+	std::vector<ew::Vertex> vertices(NUM_VECTORS);
+	for (auto _ : state) {
+		ew::ScatterPositions(stream, vertices);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_ScatterPositions);
+
+//Vec4 pairs: Vec4x8 packets against the same operation on an array of Vec4s
+static std::vector<ew::Vec4> randomVec4s(unsigned int seed) {
+	std::vector<ew::Vec3> vectors = randomVec3s(seed);
+	std::vector<ew::Vec4> result(NUM_VECTORS);
+	for (int i = 0; i < NUM_VECTORS; i++)
+	{
+		result[i] = ew::Vec4(vectors[i], 1.0f);
+	}
+	return result;
+}
+
+static const ew::Mat4 TRANSFORM_MATRIX = ew::Perspective(1.0f, 1.5f, 0.1f, 100.0f) * ew::Translate(ew::Vec3(1, 2, -20)) * ew::RotateY(0.5f);
+
+static void BM_AoSTransform(benchmark::State& state) {
+	std::vector<ew::Vec4> vectors = randomVec4s(1);
+	std::vector<ew::Vec4> result(NUM_VECTORS);
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_VECTORS; i++)
+		{
+			result[i] = TRANSFORM_MATRIX * vectors[i];
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_AoSTransform);
+
+static void BM_Vec4x8Transform(benchmark::State& state) {
+	std::vector<ew::Vec4x8> vectors;
+	ew::Pack(randomVec4s(1), vectors);
+	std::vector<ew::Vec4x8> result;
+	for (auto _ : state) {
+		ew::Transform(TRANSFORM_MATRIX, vectors, result);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_Vec4x8Transform);
+
+static void BM_AoSNormalize4(benchmark::State& state) {
+	std::vector<ew::Vec4> vectors = randomVec4s(1);
+	std::vector<ew::Vec4> normalized(NUM_VECTORS);
+	for (auto _ : state) {
+		for (int i = 0; i < NUM_VECTORS; i++)
+		{
+			const ew::Vec4& v = vectors[i];
+			const float invMagnitude = 1.0f / sqrtf(v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w);
+			normalized[i] = ew::Vec4(v.x * invMagnitude, v.y * invMagnitude, v.z * invMagnitude, v.w * invMagnitude);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_AoSNormalize4);
+
+static void BM_Vec4x8Normalize(benchmark::State& state) {
+	std::vector<ew::Vec4x8> vectors;
+	ew::Pack(randomVec4s(1), vectors);
+	std::vector<ew::Vec4x8> normalized;
+	for (auto _ : state) {
+		ew::Normalize(vectors, normalized);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NUM_VECTORS);
+}
+BENCHMARK(BM_Vec4x8Normalize);
@@ -0,0 +1,532 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <deque>
+#include <chrono>
+
+#include <ew/external/glad.h>
+#include <ew/ewMath/ewMath.h>
+#include <ew/ewMath/transformations.h>
+
+#include <ew/headless.h>
+#include <ew/shader.h>
+#include <ew/procGen.h>
+#include <ew/glState.h>
+#include <ew/renderQueue.h>
+#include <ew/geometryArena.h>
+#include <ew/materialTable.h>
+#include <ew/imageWrite.h>
+#include <ew/ewMath/rng.h>
+
+//Usage: draw_bench [--frames N] [--warmup N] [--draws LIST] [--uniforms LIST] [--textures LIST] [--texture-size S] [--queue LIST] [--materials LIST] [--output PATH]
+//LIST is comma separated, e.g. --draws 100,1000,10000. Each scenario renders frames offscreen with ew::runHeadless,
+//which times the scenario's GL calls on the CPU and with timestamp queries on the GPU.
+//Scenarios:
+//  draws      N cubes, each with Shader::setMat4 and Mesh::draw
+//  instanced  The same N cubes as one instanced draw, with matrices uploaded to a storage buffer
+//  uniforms   N Shader::setMat4 calls without drawing
+//  textures   M glTexSubImage2D uploads of S x S RGBA8 textures
+//  queue      N draws of 2 meshes with random shaders (of 4) and textures (of 8), sorted and issued by ew::RenderQueue
+//  unsorted   The same N draws issued in submission order, as without a RenderQueue
+//  materials  The same N draws with random materials (of 64, sharing the 8 textures) from one ew::MaterialTable,
+//             recorded into an ew::IndirectBatch each frame and issued as one multi-draw-indirect call
+//callsPerFrame counts draws, instances, uniform sets or uploads.
+//queue and unsorted also report the GL state calls issued and filtered by ew::state, and submitMs, the CPU time issuing draws.
+
+static const char* VERTEX_SOURCE = R"(#version 450
+layout(location = 0) in vec3 vPos;
+layout(location = 1) in vec3 vNormal;
+uniform mat4 _Model;
+uniform mat4 _ViewProjection;
+out vec3 Normal;
+void main(){
+	Normal = mat3(_Model) * vNormal;
+	gl_Position = _ViewProjection * _Model * vec4(vPos, 1.0);
+}
+)";
+
+static const char* INSTANCED_VERTEX_SOURCE = R"(#version 450
+layout(location = 0) in vec3 vPos;
+layout(location = 1) in vec3 vNormal;
+layout(std430, binding = 0) readonly buffer ModelBuffer{
+	mat4 _Models[];
+};
+uniform mat4 _ViewProjection;
+out vec3 Normal;
+void main(){
+	mat4 model = _Models[gl_InstanceID];
+	Normal = mat3(model) * vNormal;
+	gl_Position = _ViewProjection * model * vec4(vPos, 1.0);
+}
+)";
+
+static const char* FRAGMENT_SOURCE = R"(#version 450
+in vec3 Normal;
+out vec4 FragColor;
+void main(){
+	FragColor = vec4(vec3(0.5 + 0.5 * normalize(Normal).y), 1.0);
+}
+)";
+
+//Textured fragment shader for the mixed material scene. Each program defines its own TINT so they are distinct programs
+static const char* QUEUE_FRAGMENT_SOURCE = R"(#version 450
+in vec3 Normal;
+out vec4 FragColor;
+uniform sampler2D _Texture;
+void main(){
+	FragColor = vec4(TINT * texture(_Texture, normalize(Normal).xy * 0.5 + 0.5).rgb, 1.0);
+}
+)";
+
+//Multi-draw-indirect version of the mixed material scene. Model matrices and material indices come from the IndirectBatch draw data
+static const char* MATERIAL_VERTEX_SOURCE = R"(#version 450
+layout(location = 0) in vec3 vPos;
+layout(location = 1) in vec3 vNormal;
+layout(location = 3) in uint vDrawIndex;
+struct DrawData{
+	mat4 model;
+	mat4 normalMatrix;
+	uint materialIndex;
+};
+layout(std430, binding = 1) readonly buffer DrawDataBuffer{
+	DrawData _DrawData[];
+};
+uniform mat4 _ViewProjection;
+out vec3 Normal;
+flat out uint MaterialIndex;
+void main(){
+	mat4 model = _DrawData[vDrawIndex].model;
+	Normal = mat3(model) * vNormal;
+	MaterialIndex = _DrawData[vDrawIndex].materialIndex;
+	gl_Position = _ViewProjection * model * vec4(vPos, 1.0);
+}
+)";
+
+//Inserted after the MaterialTable header, which declares _Materials and sampleMaterial
+static const char* MATERIAL_FRAGMENT_SOURCE = R"(#version 450
+in vec3 Normal;
+flat in uint MaterialIndex;
+out vec4 FragColor;
+void main(){
+	vec3 color = sampleMaterial(MaterialIndex, normalize(Normal).xy * 0.5 + 0.5).rgb;
+	FragColor = vec4(_Materials[MaterialIndex].diffuse * color, 1.0);
+}
+)";
+
+//A draw of the multi-draw-indirect scene
+struct MaterialDraw {
+	int mesh; //Index into the scene's arena allocations
+	ew::Mat4 model;
+	uint32_t materialIndex;
+};
+
+//Draws of the mixed material scene, and the state changes and submit times they produced
+struct QueueScene {
+	std::vector<ew::DrawItem> items;
+	bool sorted;
+	ew::RenderQueue queue;
+	std::vector<float> submitMs;
+	unsigned int stateCallsIssued = 0;
+	unsigned int stateCallsFiltered = 0;
+};
+
+struct Scenario {
+	std::string name;
+	int count;
+	int callsPerFrame;
+	double bytesPerFrame; //Data uploaded per frame, 0 if not meaningful
+	std::function<void()> issue;
+	QueueScene* queueScene = nullptr;
+};
+
+struct Summary {
+	double mean = 0.0, median = 0.0, p95 = 0.0, min = 0.0;
+};
+
+static Summary summarize(std::vector<float> values) {
+	Summary summary;
+	if (values.empty()) {
+		return summary;
+	}
+	std::sort(values.begin(), values.end());
+	for (float v : values) {
+		summary.mean += v;
+	}
+	summary.mean /= values.size();
+	summary.median = values[values.size() / 2];
+	summary.p95 = values[(size_t)(0.95 * (values.size() - 1) + 0.5)];
+	summary.min = values.front();
+	return summary;
+}
+
+/// <summary>
+/// Issues one frame of the mixed material scene, through the RenderQueue or in submission order
+/// </summary>
+static void issueQueueScene(QueueScene& scene) {
+	if (scene.sorted) {
+		scene.queue.clear();
+		for (const ew::DrawItem& item : scene.items) {
+			scene.queue.submit(*item.mesh, *item.shader, item.texture, item.model, item.depth);
+		}
+		scene.queue.execute();
+		const ew::RenderQueueStats& stats = scene.queue.getStats();
+		scene.submitMs.push_back(stats.submitMs);
+		scene.stateCallsIssued = stats.stateCallsIssued;
+		scene.stateCallsFiltered = stats.stateCallsFiltered;
+		return;
+	}
+	//The same calls RenderQueue::execute makes per draw
+	ew::GLStateCounters countersBefore = ew::state::getCounters();
+	auto start = std::chrono::high_resolution_clock::now();
+	for (const ew::DrawItem& item : scene.items) {
+		item.shader->use();
+		ew::state::bindTexture(0, GL_TEXTURE_2D, item.texture);
+		item.shader->setMat4("_Model", item.model);
+		item.shader->setMat4("_NormalMatrix", ew::NormalMatrix(item.model));
+		item.mesh->draw();
+	}
+	scene.submitMs.push_back(std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count());
+	ew::GLStateCounters countersAfter = ew::state::getCounters();
+	scene.stateCallsIssued = countersAfter.issued - countersBefore.issued;
+	scene.stateCallsFiltered = countersAfter.filtered - countersBefore.filtered;
+}
+
+static std::vector<int> parseList(const char* text) {
+	std::vector<int> values;
+	for (const char* c = text; *c; ) {
+		values.push_back(atoi(c));
+		const char* comma = strchr(c, ',');
+		if (comma == nullptr) {
+			break;
+		}
+		c = comma + 1;
+	}
+	return values;
+}
+
+/// <summary>
+/// Scale and offset for N cubes in a grid covering the screen, so each draw covers only a few pixels
+/// and the timings measure submission rather than fill rate
+/// </summary>
+static std::vector<ew::Mat4> gridMatrices(int count) {
+	std::vector<ew::Mat4> matrices(count);
+	int side = std::max((int)ceilf(sqrtf((float)count)), 1);
+	float cellSize = 2.0f / side;
+	for (int i = 0; i < count; i++)
+	{
+		ew::Vec3 position(-1.0f + ((i % side) + 0.5f) * cellSize, -1.0f + ((i / side) + 0.5f) * cellSize, 0.0f);
+		matrices[i] = ew::Translate(position) * ew::RotateY(i * 0.1f) * ew::RotateX(0.5f) * ew::Scale(ew::Vec3(cellSize * 0.5f));
+	}
+	return matrices;
+}
+
+int main(int argc, char* argv[]) {
+	ew::HeadlessOptions options;
+	options.width = 256;
+	options.height = 256;
+	options.numFrames = 30;
+	options.captureInterval = -1;
+	int warmupFrames = 3;
+	std::vector<int> drawCounts = { 100, 1000, 10000 };
+	std::vector<int> uniformCounts = { 1000, 10000, 100000 };
+	std::vector<int> textureCounts = { 1, 8, 32 };
+	std::vector<int> queueCounts = { 1000, 10000 };
+	std::vector<int> materialCounts = { 1000, 10000 };
+	int textureSize = 256;
+	std::string outputPath = "draw_bench.json";
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		const char* value = argv[i + 1];
+		if (strcmp(argv[i], "--frames") == 0) {
+			options.numFrames = atoi(value);
+		}
+		else if (strcmp(argv[i], "--warmup") == 0) {
+			warmupFrames = atoi(value);
+		}
+		else if (strcmp(argv[i], "--draws") == 0) {
+			drawCounts = parseList(value);
+		}
+		else if (strcmp(argv[i], "--uniforms") == 0) {
+			uniformCounts = parseList(value);
+		}
+		else if (strcmp(argv[i], "--textures") == 0) {
+			textureCounts = parseList(value);
+		}
+		else if (strcmp(argv[i], "--texture-size") == 0) {
+			textureSize = atoi(value);
+		}
+		else if (strcmp(argv[i], "--queue") == 0) {
+			queueCounts = parseList(value);
+		}
+		else if (strcmp(argv[i], "--materials") == 0) {
+			materialCounts = parseList(value);
+		}
+		else if (strcmp(argv[i], "--output") == 0) {
+			outputPath = value;
+		}
+		else {
+			printf("Unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+	if (options.numFrames < 1 || warmupFrames < 0 || textureSize < 1) {
+		printf("Invalid frame count or texture size\n");
+		return 1;
+	}
+
+	ew::HeadlessContext context;
+	if (!context.create(4, 5)) {
+		return 1;
+	}
+	printf("Benchmarking on %s\n", (const char*)glGetString(GL_RENDERER));
+	ew::state::setEnabled(GL_CULL_FACE, true);
+	ew::state::cullFace(GL_BACK);
+	ew::state::setEnabled(GL_DEPTH_TEST, true);
+
+	ew::Shader shader(ew::createShaderProgram(VERTEX_SOURCE, FRAGMENT_SOURCE));
+	ew::Shader instancedShader(ew::createShaderProgram(INSTANCED_VERTEX_SOURCE, FRAGMENT_SOURCE));
+	ew::Mesh cubeMesh(ew::createCube(1.0f));
+	instancedShader.use();
+	instancedShader.setMat4("_ViewProjection", ew::Identity());
+	shader.use();
+	shader.setMat4("_ViewProjection", ew::Identity());
+
+	int maxDraws = 0;
+	for (int count : drawCounts) {
+		maxDraws = std::max(maxDraws, count);
+	}
+	unsigned int modelBuffer;
+	glCreateBuffers(1, &modelBuffer);
+	glNamedBufferStorage(modelBuffer, sizeof(ew::Mat4) * std::max(maxDraws, 1), NULL, GL_DYNAMIC_STORAGE_BIT);
+
+	int maxTextures = 0;
+	for (int count : textureCounts) {
+		maxTextures = std::max(maxTextures, count);
+	}
+	std::vector<unsigned int> textures(maxTextures);
+	if (maxTextures > 0) {
+		glCreateTextures(GL_TEXTURE_2D, maxTextures, textures.data());
+	}
+	for (unsigned int texture : textures) {
+		glTextureStorage2D(texture, 1, GL_RGBA8, textureSize, textureSize);
+	}
+	std::vector<unsigned char> pixels((size_t)textureSize * textureSize * 4);
+	srand(0);
+	for (unsigned char& p : pixels) {
+		p = (unsigned char)(rand() & 0xFF);
+	}
+
+	//Mixed material scene: 4 programs, 8 small textures and 2 meshes
+	const int NUM_QUEUE_SHADERS = 4;
+	const int NUM_QUEUE_TEXTURES = 8;
+	std::vector<ew::Shader> queueShaders;
+	for (int i = 0; i < NUM_QUEUE_SHADERS; i++)
+	{
+		const std::string tint = "#define TINT vec3(" + std::to_string(0.4f + 0.2f * i) + ")\n";
+		const std::string fragmentSource = ew::insertAfterVersion(QUEUE_FRAGMENT_SOURCE, tint);
+		queueShaders.push_back(ew::Shader(ew::createShaderProgram(VERTEX_SOURCE, fragmentSource.c_str())));
+		queueShaders.back().use();
+		queueShaders.back().setMat4("_ViewProjection", ew::Identity());
+		queueShaders.back().setInt("_Texture", 0);
+	}
+	unsigned int queueTextures[NUM_QUEUE_TEXTURES];
+	glCreateTextures(GL_TEXTURE_2D, NUM_QUEUE_TEXTURES, queueTextures);
+	std::vector<unsigned char> queuePixels(16 * 16 * 4);
+	for (size_t i = 0; i < queuePixels.size(); i++)
+	{
+		queuePixels[i] = (unsigned char)(i * 37);
+	}
+	for (unsigned int texture : queueTextures) {
+		glTextureStorage2D(texture, 1, GL_RGBA8, 16, 16);
+		glTextureSubImage2D(texture, 0, 0, 0, 16, 16, GL_RGBA, GL_UNSIGNED_BYTE, queuePixels.data());
+	}
+	ew::Mesh sphereMesh(ew::createSphere(0.5f, 8));
+	const ew::Mesh* queueMeshes[2] = { &cubeMesh, &sphereMesh };
+
+	//The same scene as materials in one table. MaterialTable loads textures from files, so the queue textures are written out first
+	const int NUM_MATERIALS = 64;
+	ew::MaterialTable materialTable(GL_REPEAT, GL_LINEAR);
+	std::vector<std::string> materialTexturePaths;
+	for (int i = 0; i < NUM_QUEUE_TEXTURES; i++)
+	{
+		materialTexturePaths.push_back("draw_bench_texture_" + std::to_string(i) + ".png");
+		if (!ew::writePNG(materialTexturePaths.back(), 16, 16, 4, queuePixels.data())) {
+			printf("Failed to write %s\n", materialTexturePaths.back().c_str());
+			return 1;
+		}
+		materialTable.addTexture(materialTexturePaths.back().c_str());
+	}
+	for (int i = 0; i < NUM_MATERIALS; i++)
+	{
+		ew::Material material;
+		material.texture = i % NUM_QUEUE_TEXTURES;
+		material.diffuse = 0.4f + 0.6f * i / NUM_MATERIALS;
+		materialTable.addMaterial(material);
+	}
+	materialTable.upload();
+	for (const std::string& path : materialTexturePaths) {
+		remove(path.c_str());
+	}
+	const std::string materialFragmentSource = ew::insertAfterVersion(MATERIAL_FRAGMENT_SOURCE, materialTable.getShaderHeader());
+	ew::Shader materialShader(ew::createShaderProgram(MATERIAL_VERTEX_SOURCE, materialFragmentSource.c_str()));
+	materialShader.use();
+	materialShader.setMat4("_ViewProjection", ew::Identity());
+	materialShader.setInt("_MaterialTextures", 0);
+	ew::GeometryArena geometryArena;
+	const ew::MeshAllocation materialMeshes[2] = { geometryArena.add(ew::createCube(1.0f)), geometryArena.add(ew::createSphere(0.5f, 8)) };
+	ew::IndirectBatch materialBatch;
+
+	std::vector<Scenario> scenarios;
+	std::vector<std::vector<ew::Mat4>> grids;
+	grids.reserve(drawCounts.size());
+	for (int count : drawCounts) {
+		grids.push_back(gridMatrices(count));
+		const std::vector<ew::Mat4>& models = grids.back();
+		scenarios.push_back({ "draws", count, count, 0.0, [&shader, &cubeMesh, &models]() {
+			shader.use();
+			for (const ew::Mat4& model : models) {
+				shader.setMat4("_Model", model);
+				cubeMesh.draw();
+			}
+		} });
+		scenarios.push_back({ "instanced", count, count, (double)sizeof(ew::Mat4) * count, [&instancedShader, &cubeMesh, &models, modelBuffer]() {
+			instancedShader.use();
+			glNamedBufferSubData(modelBuffer, 0, sizeof(ew::Mat4) * models.size(), models.data());
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, modelBuffer);
+			ew::state::bindVertexArray(cubeMesh.getVAO());
+			glDrawElementsInstanced(GL_TRIANGLES, cubeMesh.getNumIndices(), GL_UNSIGNED_INT, NULL, (int)models.size());
+		} });
+	}
+	for (int count : uniformCounts) {
+		scenarios.push_back({ "uniforms", count, count, 0.0, [&shader, count]() {
+			shader.use();
+			ew::Mat4 model = ew::Identity();
+			for (int i = 0; i < count; i++)
+			{
+				model[3][0] = (float)i;
+				shader.setMat4("_Model", model);
+			}
+		} });
+	}
+	for (int count : textureCounts) {
+		scenarios.push_back({ "textures", count, count, (double)pixels.size() * count, [&textures, &pixels, count, textureSize]() {
+			for (int i = 0; i < count; i++)
+			{
+				glTextureSubImage2D(textures[i], 0, 0, 0, textureSize, textureSize, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+			}
+		} });
+	}
+	//Shared by the sorted and unsorted runs of each count. A deque keeps the scenes in place as it grows
+	std::deque<QueueScene> queueScenes;
+	for (int count : queueCounts) {
+		const std::vector<ew::Mat4> models = gridMatrices(count);
+		ew::Rng rng(7);
+		std::vector<ew::DrawItem> items(count);
+		for (int i = 0; i < count; i++)
+		{
+			items[i].mesh = queueMeshes[rng.nextUInt(2)];
+			items[i].shader = &queueShaders[rng.nextUInt(NUM_QUEUE_SHADERS)];
+			items[i].texture = queueTextures[rng.nextUInt(NUM_QUEUE_TEXTURES)];
+			items[i].model = models[i];
+			items[i].depth = rng.range(1.0f, 100.0f);
+			items[i].transparent = false;
+		}
+		for (bool sorted : { true, false }) {
+			queueScenes.emplace_back();
+			QueueScene& scene = queueScenes.back();
+			scene.items = items;
+			scene.sorted = sorted;
+			Scenario scenario = { sorted ? "queue" : "unsorted", count, count, 0.0, [&scene]() { issueQueueScene(scene); } };
+			scenario.queueScene = &scene;
+			scenarios.push_back(scenario);
+		}
+	}
+	//A deque keeps each count's draws in place as it grows
+	std::deque<std::vector<MaterialDraw>> materialScenes;
+	for (int count : materialCounts) {
+		const std::vector<ew::Mat4> models = gridMatrices(count);
+		ew::Rng rng(7);
+		materialScenes.emplace_back(count);
+		std::vector<MaterialDraw>& draws = materialScenes.back();
+		for (int i = 0; i < count; i++)
+		{
+			draws[i].mesh = (int)rng.nextUInt(2);
+			draws[i].model = models[i];
+			draws[i].materialIndex = rng.nextUInt(NUM_MATERIALS);
+		}
+		scenarios.push_back({ "materials", count, count, 0.0, [&materialShader, &materialTable, &materialBatch, &geometryArena, &materialMeshes, &draws]() {
+			materialShader.use();
+			materialTable.bind(0, 0);
+			materialBatch.clear();
+			for (const MaterialDraw& draw : draws) {
+				materialBatch.add(materialMeshes[draw.mesh], draw.model, draw.materialIndex);
+			}
+			materialBatch.draw(geometryArena);
+		} });
+	}
+
+	FILE* file = fopen(outputPath.c_str(), "w");
+	if (file == nullptr) {
+		printf("Failed to open %s for writing\n", outputPath.c_str());
+		return 1;
+	}
+	fprintf(file, "{\n");
+	fprintf(file, "  \"renderer\": \"%s\",\n", (const char*)glGetString(GL_RENDERER));
+	fprintf(file, "  \"version\": \"%s\",\n", (const char*)glGetString(GL_VERSION));
+	fprintf(file, "  \"width\": %i,\n  \"height\": %i,\n  \"numFrames\": %i,\n  \"warmupFrames\": %i,\n", options.width, options.height, options.numFrames, warmupFrames);
+	fprintf(file, "  \"scenarios\": [\n");
+	printf("%-10s %8s %12s %12s %12s %14s %10s\n", "scenario", "count", "cpu ms", "cpu p95 ms", "gpu ms", "calls/s", "MB/s");
+	ew::HeadlessOptions runOptions = options;
+	runOptions.numFrames = options.numFrames + warmupFrames;
+	for (size_t i = 0; i < scenarios.size(); i++)
+	{
+		const Scenario& scenario = scenarios[i];
+		std::vector<ew::FrameTiming> timings = ew::runHeadless(runOptions, [&scenario](int, float, float) {
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+			scenario.issue();
+		});
+		if (timings.empty()) {
+			fclose(file);
+			return 1;
+		}
+		std::vector<float> cpuMs, gpuMs;
+		for (size_t frame = warmupFrames; frame < timings.size(); frame++)
+		{
+			cpuMs.push_back(timings[frame].cpuMs);
+			if (timings[frame].gpuMs >= 0.0f) {
+				gpuMs.push_back(timings[frame].gpuMs);
+			}
+		}
+		Summary cpu = summarize(cpuMs);
+		Summary gpu = summarize(gpuMs);
+		double callsPerSecond = cpu.mean > 0.0 ? scenario.callsPerFrame / (cpu.mean / 1000.0) : 0.0;
+		double megabytesPerSecond = cpu.mean > 0.0 ? scenario.bytesPerFrame / (1024.0 * 1024.0) / (cpu.mean / 1000.0) : 0.0;
+		printf("%-10s %8i %12.3f %12.3f %12.3f %14.0f %10.1f\n", scenario.name.c_str(), scenario.count, cpu.mean, cpu.p95, gpu.mean, callsPerSecond, megabytesPerSecond);
+		fprintf(file, "    { \"name\": \"%s\", \"count\": %i, \"callsPerFrame\": %i, \"bytesPerFrame\": %.0f, \"callsPerSecond\": %.1f, \"megabytesPerSecond\": %.2f,\n",
+			scenario.name.c_str(), scenario.count, scenario.callsPerFrame, scenario.bytesPerFrame, callsPerSecond, megabytesPerSecond);
+		if (scenario.queueScene) {
+			const QueueScene& scene = *scenario.queueScene;
+			Summary submit = summarize(std::vector<float>(scene.submitMs.begin() + std::min((size_t)warmupFrames, scene.submitMs.size()), scene.submitMs.end()));
+			printf("%-10s %8s state calls issued %u, filtered %u, submit ms %.3f\n", "", "", scene.stateCallsIssued, scene.stateCallsFiltered, submit.mean);
+			fprintf(file, "      \"stateCallsIssued\": %u, \"stateCallsFiltered\": %u, \"submitMs\": { \"mean\": %.4f, \"min\": %.4f, \"median\": %.4f, \"p95\": %.4f },\n",
+				scene.stateCallsIssued, scene.stateCallsFiltered, submit.mean, submit.min, submit.median, submit.p95);
+		}
+		fprintf(file, "      \"cpuMs\": { \"mean\": %.4f, \"min\": %.4f, \"median\": %.4f, \"p95\": %.4f },\n", cpu.mean, cpu.min, cpu.median, cpu.p95);
+		fprintf(file, "      \"gpuMs\": { \"mean\": %.4f, \"min\": %.4f, \"median\": %.4f, \"p95\": %.4f } }%s\n", gpu.mean, gpu.min, gpu.median, gpu.p95, i + 1 < scenarios.size() ? "," : "");
+	}
+	fprintf(file, "  ]\n}\n");
+	fclose(file);
+	printf("Wrote %s\n", outputPath.c_str());
+
+	glDeleteBuffers(1, &modelBuffer);
+	glDeleteTextures(NUM_QUEUE_TEXTURES, queueTextures);
+	if (maxTextures > 0) {
+		glDeleteTextures(maxTextures, textures.data());
+	}
+	return 0;
+}
@@ -61,6 +61,7 @@ namespace MyLibrary
 			mesh.indices.push_back(sideStart + i + 1);
 		}
 
+		mesh.bounds = ew::ComputeBounds(mesh.vertices);
 		return mesh;
 	}
 
@@ -122,6 +123,7 @@ namespace MyLibrary
 			mesh.indices.push_back(start + columns + 1);
 			mesh.indices.push_back(start + columns);
 		}
+		mesh.bounds = ew::ComputeBounds(mesh.vertices);
 		return mesh;
 	}
 
@@ -159,40 +161,49 @@ namespace MyLibrary
 				mesh.indices.push_back(start);
 			}
 		}
+		mesh.bounds = ew::ComputeBounds(mesh.vertices);
 		return mesh;
 	}
 
 	void circlePush(std::vector<ew::Vertex>* verticiesList, int subDivisions, float radius, ringTypes ringType, ew::Vec3 posOffset, float angOffset)
 	{
 		float thetaStep = ew::TAU / subDivisions;
+		vector<float> thetas(subDivisions + 1), sines(subDivisions + 1), cosines(subDivisions + 1);
+		for (int i = 0; i <= subDivisions; i++)
+		{
+			thetas[i] = i * thetaStep;
+		}
+		ew::SinCos(thetas.data(), sines.data(), cosines.data(), thetas.size());
+		float sinOffset, cosOffset;
+		ew::SinCos(angOffset, sinOffset, cosOffset);
 		for (int i = 0; i <= subDivisions; i++)
 		{
 			ew::Vertex v;
-			float theta = i * thetaStep;
-			v.pos.x = (cos(theta) * radius) + posOffset.x;
+			float theta = thetas[i];
+			v.pos.x = (cosines[i] * radius) + posOffset.x;
 			v.pos.y = posOffset.y;
-			v.pos.z = (sin(theta) * radius) + posOffset.z;
+			v.pos.z = (sines[i] * radius) + posOffset.z;
 			switch (ringType)
 			{
 			case TOP_FACE:
 				v.normal = { 0, 1, 0 };
-				v.uv = { (cos(theta) + 1) / 2, (sin(theta) + 1) / 2 };
+				v.uv = { (cosines[i] + 1) / 2, (sines[i] + 1) / 2 };
 				break;
 			case BOTTOM_FACE:
 				v.normal = { 0, -1, 0 };
-				v.uv = { (cos(theta) + 1) / 2, (sin(theta) + 1) / 2 };
+				v.uv = { (cosines[i] + 1) / 2, (sines[i] + 1) / 2 };
 				break;
 			case TOP_EDGE:
-				v.normal = { cos(theta), 0, sin(theta) };
+				v.normal = { cosines[i], 0, sines[i] };
 				v.uv = { theta / ew::TAU, 1 };
 				break;
 			case BOTTOM_EDGE:
-				v.normal = { cos(theta), 0, sin(theta) };
+				v.normal = { cosines[i], 0, sines[i] };
 				v.uv = { theta / ew::TAU, 0 };
 				break;
 			case ANGLED:
-				v.pos.x = v.pos.x * cos(angOffset) - v.pos.y * sin(angOffset);
-				v.pos.y = v.pos.x * sin(angOffset) - v.pos.y * cos(angOffset);
+				v.pos.x = v.pos.x * cosOffset - v.pos.y * sinOffset;
+				v.pos.y = v.pos.x * sinOffset - v.pos.y * cosOffset;
 				v.normal = ew::Normalize(v.pos);
 				break;
 			}
@@ -1,4 +1,5 @@
 #include "shader.h"
+#include "../ew/glState.h"
 #include <stdio.h>
 #include <fstream>
 #include <sstream>
@@ -66,7 +67,7 @@ namespace MyLibrary {
 	{
 		unsigned int vao;
 		glGenVertexArrays(1, &vao);
-		glBindVertexArray(vao);
+		ew::state::bindVertexArray(vao);
 
 		//Define a new buffer id
 		unsigned int vbo;
@@ -100,7 +101,7 @@ namespace MyLibrary {
 
 	void Shader::use()
 	{
-		glUseProgram(m_id);
+		ew::state::useProgram(m_id);
 	}
 
 	void Shader::setInt(const std::string& name, int v) const
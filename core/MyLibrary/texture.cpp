@@ -1,6 +1,7 @@
 #include "texture.h"
 #include "../ew/external/stb_image.h"
 #include "../ew/external/glad.h"
+#include "../ew/glState.h"
 
 namespace MyLibrary {
 	unsigned int loadTexture(const char* filePath, int wrapMode, int filterMode)
@@ -23,7 +24,7 @@ namespace MyLibrary {
 		// Creates new texture name
 		glGenTextures(1, &texture);
 		// Binds texture name to GL_TEXTURE_2D alias
-		glBindTexture(GL_TEXTURE_2D, texture);
+		ew::state::bindTexture(0, GL_TEXTURE_2D, texture);
 
 		GLenum format;
 		GLint internalFormat;
@@ -65,7 +66,7 @@ namespace MyLibrary {
 		glGenerateMipmap(GL_TEXTURE_2D);
 
 		// Handling
-		glBindTexture(GL_TEXTURE_2D, 0);
+		ew::state::bindTexture(0, GL_TEXTURE_2D, 0);
 		stbi_image_free(data);
 
 		return texture;
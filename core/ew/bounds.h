@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include <float.h>
+#include "ewMath/ewMath.h"
+
+namespace ew {
+	//Axis aligned bounding box
+	struct AABB {
+		ew::Vec3 min = ew::Vec3(FLT_MAX);
+		ew::Vec3 max = ew::Vec3(-FLT_MAX);
+
+		inline ew::Vec3 center()const { return (min + max) * 0.5f; }
+		inline ew::Vec3 extents()const { return (max - min) * 0.5f; }
+		inline bool isValid()const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+		//Grows the box to contain p
+		inline void encapsulate(const ew::Vec3& p) {
+			//Plain comparisons compile to single min/max instructions, unlike fminf
+			min.x = p.x < min.x ? p.x : min.x; max.x = p.x > max.x ? p.x : max.x;
+			min.y = p.y < min.y ? p.y : min.y; max.y = p.y > max.y ? p.y : max.y;
+			min.z = p.z < min.z ? p.z : min.z; max.z = p.z > max.z ? p.z : max.z;
+		}
+		//Grows the box to contain b
+		inline void encapsulate(const AABB& b) {
+			min.x = b.min.x < min.x ? b.min.x : min.x; max.x = b.max.x > max.x ? b.max.x : max.x;
+			min.y = b.min.y < min.y ? b.min.y : min.y; max.y = b.max.y > max.y ? b.max.y : max.y;
+			min.z = b.min.z < min.z ? b.min.z : min.z; max.z = b.max.z > max.z ? b.max.z : max.z;
+		}
+	};
+
+	//Box enclosing every position in vertices. Works on any vertex struct with a Vec3 pos
+	template<typename VertexType>
+	inline AABB ComputeBounds(const std::vector<VertexType>& vertices) {
+		AABB bounds;
+		for (const VertexType& v : vertices) {
+			bounds.encapsulate(v.pos);
+		}
+		return bounds;
+	}
+
+	//World space box enclosing a local space box transformed by m (Arvo's method)
+	inline AABB TransformBounds(const AABB& b, const ew::Mat4& m) {
+		ew::Vec3 center = b.center();
+		ew::Vec3 extents = b.extents();
+		ew::Vec3 worldCenter = (m * ew::Vec4(center, 1.0f)).toVec3();
+		ew::Vec3 worldExtents;
+		for (int row = 0; row < 3; row++)
+		{
+			(&worldExtents.x)[row] = fabsf(m[0][row]) * extents.x + fabsf(m[1][row]) * extents.y + fabsf(m[2][row]) * extents.z;
+		}
+		AABB result;
+		result.min = worldCenter - worldExtents;
+		result.max = worldCenter + worldExtents;
+		return result;
+	}
+}
@@ -0,0 +1,454 @@
+#include "bvh.h"
+#include "jobSystem.h"
+#include <chrono>
+#include <stdio.h>
+
+static const int NUM_BINS = 16;
+static const int MAX_DEPTH = 60; //Keeps traversal stacks a fixed size
+static const int STACK_SIZE = 64;
+
+/// <summary>
+/// Half the surface area of a box, proportional to the chance of a random ray hitting it
+/// </summary>
+static float halfArea(const ew::AABB& b) {
+	if (!b.isValid()) {
+		return 0.0f;
+	}
+	ew::Vec3 d = b.max - b.min;
+	return d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+/// <summary>
+/// Distance from a plane to a box's center, and how far the box reaches towards the plane
+/// </summary>
+static void planeDistance(const ew::Plane& plane, const ew::AABB& b, float* distance, float* reach) {
+	ew::Vec3 center = b.center();
+	ew::Vec3 extents = b.extents();
+	*distance = ew::Dot(plane.normal, center) + plane.distance;
+	*reach = fabsf(plane.normal.x) * extents.x + fabsf(plane.normal.y) * extents.y + fabsf(plane.normal.z) * extents.z;
+}
+
+static bool overlaps(const ew::AABB& a, const ew::AABB& b) {
+	return a.min.x <= b.max.x && a.max.x >= b.min.x
+		&& a.min.y <= b.max.y && a.max.y >= b.min.y
+		&& a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+namespace ew {
+	/// <summary>
+	/// Slab test of a ray against a box
+	/// </summary>
+	/// <param name="inverseDirection">1 / ray.direction per component, precomputed once per ray</param>
+	/// <param name="distance">Distance along the ray where it enters the box, 0 if it starts inside</param>
+	/// <returns>True if the ray enters the box before maxDistance</returns>
+	bool IntersectRayAABB(const Ray& ray, const ew::Vec3& inverseDirection, const AABB& bounds, float maxDistance, float* distance)
+	{
+		float tx1 = (bounds.min.x - ray.origin.x) * inverseDirection.x;
+		float tx2 = (bounds.max.x - ray.origin.x) * inverseDirection.x;
+		float tMin = fminf(tx1, tx2), tMax = fmaxf(tx1, tx2);
+		float ty1 = (bounds.min.y - ray.origin.y) * inverseDirection.y;
+		float ty2 = (bounds.max.y - ray.origin.y) * inverseDirection.y;
+		tMin = fmaxf(tMin, fminf(ty1, ty2)); tMax = fminf(tMax, fmaxf(ty1, ty2));
+		float tz1 = (bounds.min.z - ray.origin.z) * inverseDirection.z;
+		float tz2 = (bounds.max.z - ray.origin.z) * inverseDirection.z;
+		tMin = fmaxf(tMin, fminf(tz1, tz2)); tMax = fminf(tMax, fmaxf(tz1, tz2));
+		tMin = fmaxf(tMin, 0.0f);
+		if (tMax < tMin || tMin >= maxDistance) {
+			return false;
+		}
+		*distance = tMin;
+		return true;
+	}
+
+	/// <summary>
+	/// Builds the hierarchy from scratch
+	/// </summary>
+	/// <param name="bounds">World space bounds of each primitive, e.g. from Transform::getWorldBounds</param>
+	/// <param name="numThreads">Subtrees near the root are built on up to this many threads</param>
+	/// <param name="maxLeafSize">Nodes with this many primitives or fewer are never split</param>
+	void BVH::build(const std::vector<AABB>& bounds, int numThreads, int maxLeafSize)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		const int count = (int)bounds.size();
+		m_bounds = bounds;
+		m_maxLeafSize = maxLeafSize;
+		m_indices.resize(count);
+		m_centers.resize(count);
+		for (int i = 0; i < count; i++)
+		{
+			m_indices[i] = i;
+			m_centers[i] = bounds[i].center();
+		}
+		m_nodes.clear();
+		if (count > 0) {
+			//A binary tree with count leaves has at most 2 * count - 1 nodes. Allocating them up front
+			//lets threads claim nodes with an atomic counter without the vector moving under them
+			m_nodes.resize(2 * count - 1);
+			m_nodes[0].leftFirst = 0;
+			m_nodes[0].count = count;
+			updateBounds(0);
+			m_nodesUsed = 1;
+			int threadDepth = 0;
+			while ((1 << threadDepth) < numThreads) {
+				threadDepth++;
+			}
+			subdivide(0, 0, threadDepth);
+			m_nodes.resize(m_nodesUsed);
+		}
+		m_stats.numNodes = (int)m_nodes.size();
+		m_stats.numLeaves = 0;
+		for (const BVHNode& node : m_nodes) {
+			m_stats.numLeaves += node.isLeaf() ? 1 : 0;
+		}
+		m_stats.buildMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+	/// <summary>
+	/// Sets a node's bounds to enclose all of its primitives
+	/// </summary>
+	void BVH::updateBounds(int nodeIndex)
+	{
+		BVHNode& node = m_nodes[nodeIndex];
+		node.bounds = AABB();
+		for (int i = node.leftFirst; i < node.leftFirst + node.count; i++)
+		{
+			node.bounds.encapsulate(m_bounds[m_indices[i]]);
+		}
+	}
+	/// <summary>
+	/// Splits a leaf where the surface area heuristic estimates it is cheapest to traverse,
+	/// testing NUM_BINS evenly spaced candidate planes per axis, then recurses into both halves
+	/// </summary>
+	/// <param name="threadDepth">Depth above which one half is built as a job on DefaultJobSystem</param>
+	void BVH::subdivide(int nodeIndex, int depth, int threadDepth)
+	{
+		BVHNode& node = m_nodes[nodeIndex];
+		if (node.count <= m_maxLeafSize || depth >= MAX_DEPTH) {
+			return;
+		}
+		const int first = node.leftFirst;
+		const int last = node.leftFirst + node.count;
+		AABB centerBounds;
+		for (int i = first; i < last; i++)
+		{
+			centerBounds.encapsulate(m_centers[m_indices[i]]);
+		}
+
+		//Bin all three axes in a single pass over the primitives
+		AABB binBounds[3][NUM_BINS];
+		int binCounts[3][NUM_BINS] = {};
+		float axisMin[3], scale[3];
+		for (int axis = 0; axis < 3; axis++)
+		{
+			axisMin[axis] = (&centerBounds.min.x)[axis];
+			float extent = (&centerBounds.max.x)[axis] - axisMin[axis];
+			scale[axis] = extent > 0.0f ? NUM_BINS / extent : 0.0f;
+		}
+		for (int i = first; i < last; i++)
+		{
+			int primitive = m_indices[i];
+			const ew::Vec3& center = m_centers[primitive];
+			const AABB& bounds = m_bounds[primitive];
+			for (int axis = 0; axis < 3; axis++)
+			{
+				int bin = (int)(((&center.x)[axis] - axisMin[axis]) * scale[axis]);
+				bin = bin < NUM_BINS - 1 ? bin : NUM_BINS - 1;
+				binCounts[axis][bin]++;
+				binBounds[axis][bin].encapsulate(bounds);
+			}
+		}
+
+		int bestAxis = -1;
+		int bestSplit = 0;
+		float bestCost = node.count * halfArea(node.bounds);
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (scale[axis] == 0.0f) {
+				continue;
+			}
+			//Sweep from both sides to get the cost of splitting after each bin
+			float leftArea[NUM_BINS - 1], rightArea[NUM_BINS - 1];
+			int leftCount[NUM_BINS - 1], rightCount[NUM_BINS - 1];
+			AABB leftBox, rightBox;
+			int leftSum = 0, rightSum = 0;
+			for (int i = 0; i < NUM_BINS - 1; i++)
+			{
+				leftSum += binCounts[axis][i];
+				leftCount[i] = leftSum;
+				leftBox.encapsulate(binBounds[axis][i]);
+				leftArea[i] = halfArea(leftBox);
+				rightSum += binCounts[axis][NUM_BINS - 1 - i];
+				rightCount[NUM_BINS - 2 - i] = rightSum;
+				rightBox.encapsulate(binBounds[axis][NUM_BINS - 1 - i]);
+				rightArea[NUM_BINS - 2 - i] = halfArea(rightBox);
+			}
+			for (int i = 0; i < NUM_BINS - 1; i++)
+			{
+				float cost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+				if (leftCount[i] > 0 && rightCount[i] > 0 && cost < bestCost) {
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = i + 1;
+				}
+			}
+		}
+		if (bestAxis < 0) {
+			return;
+		}
+
+		//Partition primitives in place around the chosen bin boundary
+		int i = first;
+		int j = last - 1;
+		while (i <= j)
+		{
+			int bin = (int)(((&m_centers[m_indices[i]].x)[bestAxis] - axisMin[bestAxis]) * scale[bestAxis]);
+			bin = bin < NUM_BINS - 1 ? bin : NUM_BINS - 1;
+			if (bin < bestSplit) {
+				i++;
+			}
+			else {
+				std::swap(m_indices[i], m_indices[j--]);
+			}
+		}
+		int leftCount = i - first;
+		if (leftCount == 0 || leftCount == node.count) {
+			return;
+		}
+
+		int leftChild = m_nodesUsed.fetch_add(2);
+		m_nodes[leftChild].leftFirst = first;
+		m_nodes[leftChild].count = leftCount;
+		m_nodes[leftChild + 1].leftFirst = i;
+		m_nodes[leftChild + 1].count = node.count - leftCount;
+		//Child bounds are the union of their bins, which saves another pass over the primitives
+		m_nodes[leftChild].bounds = AABB();
+		m_nodes[leftChild + 1].bounds = AABB();
+		for (int bin = 0; bin < NUM_BINS; bin++)
+		{
+			m_nodes[leftChild + (bin < bestSplit ? 0 : 1)].bounds.encapsulate(binBounds[bestAxis][bin]);
+		}
+		node.leftFirst = leftChild;
+		node.count = 0;
+
+		if (depth < threadDepth) {
+			JobSystem& jobSystem = DefaultJobSystem();
+			JobCounter counter;
+			jobSystem.run([this, leftChild, depth, threadDepth]() { subdivide(leftChild, depth + 1, threadDepth); }, &counter);
+			subdivide(leftChild + 1, depth + 1, threadDepth);
+			jobSystem.wait(counter);
+		}
+		else {
+			subdivide(leftChild, depth + 1, threadDepth);
+			subdivide(leftChild + 1, depth + 1, threadDepth);
+		}
+	}
+	/// <summary>
+	/// Updates node bounds after primitives moved, keeping the tree structure.
+	/// Much cheaper than build, but the tree gets less efficient the further primitives move.
+	/// </summary>
+	/// <param name="bounds">New bounds of every primitive, in the same order as passed to build</param>
+	void BVH::refit(const std::vector<AABB>& bounds)
+	{
+		if (bounds.size() != m_bounds.size()) {
+			printf("BVH refit with %i primitives, built with %i. Call build instead\n", (int)bounds.size(), (int)m_bounds.size());
+			return;
+		}
+		auto start = std::chrono::high_resolution_clock::now();
+		m_bounds = bounds;
+		//Children are always allocated after their parent, so a reverse walk visits children first
+		for (int i = (int)m_nodes.size() - 1; i >= 0; i--)
+		{
+			BVHNode& node = m_nodes[i];
+			if (node.isLeaf()) {
+				updateBounds(i);
+			}
+			else {
+				node.bounds = m_nodes[node.leftFirst].bounds;
+				node.bounds.encapsulate(m_nodes[node.leftFirst + 1].bounds);
+			}
+		}
+		m_stats.refitMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+	/// <summary>
+	/// Hierarchical frustum culling. Subtrees fully outside a plane are skipped, and planes a node
+	/// is fully inside of are not tested again for its children.
+	/// </summary>
+	/// <param name="visible">Resized to size(). 1 for primitives that may be visible, 0 otherwise</param>
+	/// <returns>Number of visible primitives</returns>
+	int BVH::cull(const Frustum& frustum, std::vector<uint8_t>& visible)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		visible.assign(m_bounds.size(), 0);
+		if (m_nodes.empty()) {
+			return 0;
+		}
+		int numVisible = 0;
+		int stack[STACK_SIZE];
+		uint8_t planeMasks[STACK_SIZE];
+		int stackSize = 0;
+		stack[stackSize] = 0;
+		planeMasks[stackSize++] = 0x3F;
+		while (stackSize > 0)
+		{
+			stackSize--;
+			const BVHNode& node = m_nodes[stack[stackSize]];
+			uint8_t mask = planeMasks[stackSize];
+			bool outside = false;
+			for (int p = 0; p < 6 && mask != 0; p++)
+			{
+				if (!(mask & (1 << p))) {
+					continue;
+				}
+				float distance, reach;
+				planeDistance(frustum.planes[p], node.bounds, &distance, &reach);
+				if (distance + reach < 0.0f) {
+					outside = true;
+					break;
+				}
+				if (distance - reach >= 0.0f) {
+					mask &= ~(1 << p);
+				}
+			}
+			if (outside) {
+				continue;
+			}
+			if (!node.isLeaf()) {
+				stack[stackSize] = node.leftFirst;
+				planeMasks[stackSize++] = mask;
+				stack[stackSize] = node.leftFirst + 1;
+				planeMasks[stackSize++] = mask;
+				continue;
+			}
+			for (int i = node.leftFirst; i < node.leftFirst + node.count; i++)
+			{
+				int primitive = m_indices[i];
+				bool inside = true;
+				for (int p = 0; p < 6 && mask != 0; p++)
+				{
+					if (!(mask & (1 << p))) {
+						continue;
+					}
+					float distance, reach;
+					planeDistance(frustum.planes[p], m_bounds[primitive], &distance, &reach);
+					if (distance + reach < 0.0f) {
+						inside = false;
+						break;
+					}
+				}
+				if (inside) {
+					visible[primitive] = 1;
+					numVisible++;
+				}
+			}
+		}
+		m_stats.cullMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		return numVisible;
+	}
+	/// <summary>
+	/// Finds the closest primitive hit by a ray
+	/// </summary>
+	/// <param name="maxDistance">Hits at or beyond this distance are ignored</param>
+	/// <param name="hit">Closest primitive and its distance</param>
+	/// <param name="intersect">Exact test against a primitive. If null, primitive bounds are used</param>
+	/// <returns>True if anything was hit</returns>
+	bool BVH::raycast(const Ray& ray, float maxDistance, BVHRayHit* hit, const BVHRayCallback& intersect) const
+	{
+		ew::Vec3 inverseDirection(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+		hit->primitive = -1;
+		hit->distance = traverse(ray, maxDistance, [&](int first, int count, float* closest) {
+			for (int i = first; i < first + count; i++)
+			{
+				int primitive = m_indices[i];
+				float distance;
+				bool isHit = intersect
+					? intersect(primitive, ray, *closest, &distance)
+					: IntersectRayAABB(ray, inverseDirection, m_bounds[primitive], *closest, &distance);
+				if (isHit && distance < *closest) {
+					*closest = distance;
+					hit->primitive = primitive;
+				}
+			}
+		});
+		return hit->primitive >= 0;
+	}
+	/// <summary>
+	/// Visits the leaves a ray passes through, nearest child first, so that farther subtrees
+	/// can be skipped once something closer has been hit
+	/// </summary>
+	/// <param name="maxDistance">Leaves entered at or beyond this distance are skipped</param>
+	/// <param name="visitLeaf">Tests the primitives at getIndices()[first, first + count), lowering closest on a nearer hit</param>
+	/// <returns>Closest hit distance, or maxDistance if nothing was hit</returns>
+	float BVH::traverse(const Ray& ray, float maxDistance, const BVHLeafCallback& visitLeaf) const
+	{
+		if (m_nodes.empty()) {
+			return maxDistance;
+		}
+		ew::Vec3 inverseDirection(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+		float closest = maxDistance;
+		float distance;
+		int stack[STACK_SIZE];
+		int stackSize = 0;
+		if (IntersectRayAABB(ray, inverseDirection, m_nodes[0].bounds, closest, &distance)) {
+			stack[stackSize++] = 0;
+		}
+		while (stackSize > 0)
+		{
+			const BVHNode& node = m_nodes[stack[--stackSize]];
+			//Retest, since a hit found after this node was pushed may be closer than it
+			if (!IntersectRayAABB(ray, inverseDirection, node.bounds, closest, &distance)) {
+				continue;
+			}
+			if (node.isLeaf()) {
+				visitLeaf(node.leftFirst, node.count, &closest);
+				continue;
+			}
+			float leftDistance, rightDistance;
+			bool hitLeft = IntersectRayAABB(ray, inverseDirection, m_nodes[node.leftFirst].bounds, closest, &leftDistance);
+			bool hitRight = IntersectRayAABB(ray, inverseDirection, m_nodes[node.leftFirst + 1].bounds, closest, &rightDistance);
+			if (hitLeft && hitRight) {
+				//Push the farther child first so the nearer one is popped next
+				bool leftFirst = leftDistance <= rightDistance;
+				stack[stackSize++] = leftFirst ? node.leftFirst + 1 : node.leftFirst;
+				stack[stackSize++] = leftFirst ? node.leftFirst : node.leftFirst + 1;
+			}
+			else if (hitLeft) {
+				stack[stackSize++] = node.leftFirst;
+			}
+			else if (hitRight) {
+				stack[stackSize++] = node.leftFirst + 1;
+			}
+		}
+		return closest;
+	}
+	/// <summary>
+	/// Finds every primitive whose bounds overlap a box
+	/// </summary>
+	/// <param name="results">Primitive indices are appended</param>
+	void BVH::query(const AABB& bounds, std::vector<int>& results) const
+	{
+		if (m_nodes.empty()) {
+			return;
+		}
+		int stack[STACK_SIZE];
+		int stackSize = 0;
+		stack[stackSize++] = 0;
+		while (stackSize > 0)
+		{
+			const BVHNode& node = m_nodes[stack[--stackSize]];
+			if (!overlaps(node.bounds, bounds)) {
+				continue;
+			}
+			if (node.isLeaf()) {
+				for (int i = node.leftFirst; i < node.leftFirst + node.count; i++)
+				{
+					if (overlaps(m_bounds[m_indices[i]], bounds)) {
+						results.push_back(m_indices[i]);
+					}
+				}
+			}
+			else {
+				stack[stackSize++] = node.leftFirst;
+				stack[stackSize++] = node.leftFirst + 1;
+			}
+		}
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <functional>
+#include <stdint.h>
+#include "ewMath/ewMath.h"
+#include "bounds.h"
+#include "frustum.h"
+
+namespace ew {
+	struct Ray {
+		ew::Vec3 origin;
+		ew::Vec3 direction; //Normalized for world space rays. Hit distances are in units of its length
+	};
+
+	bool IntersectRayAABB(const Ray& ray, const ew::Vec3& inverseDirection, const AABB& bounds, float maxDistance, float* distance);
+
+	//Leaves have count > 0 and store their primitives at indices [leftFirst, leftFirst + count).
+	//Interior nodes have count == 0 and children at leftFirst and leftFirst + 1.
+	struct BVHNode {
+		AABB bounds;
+		int leftFirst = 0;
+		int count = 0;
+		inline bool isLeaf()const { return count > 0; }
+	};
+
+	struct BVHRayHit {
+		int primitive = -1; //-1 for no hit
+		float distance = 0.0f;
+	};
+
+	struct BVHStats {
+		int numNodes = 0;
+		int numLeaves = 0;
+		float buildMs = 0.0f;
+		float refitMs = 0.0f;
+		float cullMs = 0.0f;
+	};
+
+	//Returns true and sets distance if the ray hits the primitive closer than maxDistance
+	typedef std::function<bool(int primitive, const Ray& ray, float maxDistance, float* distance)> BVHRayCallback;
+	//Tests the primitives getIndices()[first, first + count) of a leaf, lowering closest on a nearer hit
+	typedef std::function<void(int first, int count, float* closest)> BVHLeafCallback;
+
+	//Bounding volume hierarchy over world space boxes, built with binned SAH.
+	//Primitives are referred to by their index in the bounds passed to build.
+	class BVH {
+	public:
+		void build(const std::vector<AABB>& bounds, int numThreads = 1, int maxLeafSize = 2);
+		void refit(const std::vector<AABB>& bounds);
+		int cull(const Frustum& frustum, std::vector<uint8_t>& visible);
+		bool raycast(const Ray& ray, float maxDistance, BVHRayHit* hit, const BVHRayCallback& intersect = nullptr)const;
+		float traverse(const Ray& ray, float maxDistance, const BVHLeafCallback& visitLeaf)const;
+		void query(const AABB& bounds, std::vector<int>& results)const;
+		inline const std::vector<BVHNode>& getNodes()const { return m_nodes; }
+		inline const std::vector<int>& getIndices()const { return m_indices; } //Primitive indices in leaf order
+		inline int size()const { return (int)m_bounds.size(); }
+		inline const BVHStats& getStats()const { return m_stats; }
+	private:
+		void subdivide(int nodeIndex, int depth, int threadDepth);
+		void updateBounds(int nodeIndex);
+		std::vector<BVHNode> m_nodes;
+		std::vector<int> m_indices;
+		std::vector<AABB> m_bounds;
+		std::vector<ew::Vec3> m_centers;
+		std::atomic<int> m_nodesUsed{ 0 };
+		int m_maxLeafSize = 2;
+		BVHStats m_stats;
+	};
+}
@@ -0,0 +1,210 @@
+#include "ecs.h"
+#include "jobSystem.h"
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace ew {
+	int NextComponentId()
+	{
+		static std::atomic<int> nextId(0);
+		const int id = nextId++;
+		if (id >= MAX_COMPONENT_TYPES) {
+			//Masks and column tables are sized for MAX_COMPONENT_TYPES, so there is no way to continue
+			printf("Too many component types, the limit is %d\n", MAX_COMPONENT_TYPES);
+			abort();
+		}
+		return id;
+	}
+
+	World::World()
+	{
+		memset(m_componentSizes, 0, sizeof(m_componentSizes));
+		//Entities without components
+		findOrCreateArchetype(0);
+	}
+
+	Entity World::create()
+	{
+		return allocateEntity(findOrCreateArchetype(0));
+	}
+
+	void World::destroy(Entity entity)
+	{
+		if (!isAlive(entity)) {
+			return;
+		}
+		EntityRecord& record = m_records[entity.index];
+		removeRow(record.archetype, record.row);
+		record.archetype = -1;
+		record.generation++;
+		m_freeIndices.push_back(entity.index);
+		m_numAlive--;
+	}
+
+	/// <summary>
+	/// Destroys every entity. Archetypes and their memory are kept for reuse
+	/// </summary>
+	void World::clear()
+	{
+		for (Archetype& archetype : m_archetypes) {
+			for (const Entity& entity : archetype.entities) {
+				m_records[entity.index].archetype = -1;
+				m_records[entity.index].generation++;
+				m_freeIndices.push_back(entity.index);
+			}
+			archetype.entities.clear();
+			for (Archetype::Column& column : archetype.columns) {
+				column.bytes.clear();
+			}
+		}
+		m_numAlive = 0;
+	}
+
+	bool World::isAlive(Entity entity)const
+	{
+		return entity.index < m_records.size() && m_records[entity.index].archetype >= 0 && m_records[entity.index].generation == entity.generation;
+	}
+
+	int World::findOrCreateArchetype(ComponentMask mask)
+	{
+		auto it = m_archetypeIndex.find(mask);
+		if (it != m_archetypeIndex.end()) {
+			return it->second;
+		}
+		Archetype archetype;
+		archetype.mask = mask;
+		for (int component = 0; component < MAX_COMPONENT_TYPES; component++)
+		{
+			archetype.columnOf[component] = -1;
+			if (mask & (ComponentMask(1) << component)) {
+				archetype.columnOf[component] = (int)archetype.columns.size();
+				archetype.columns.push_back({ component, m_componentSizes[component], {} });
+			}
+		}
+		m_archetypes.push_back(std::move(archetype));
+		m_archetypeIndex[mask] = (int)m_archetypes.size() - 1;
+		return (int)m_archetypes.size() - 1;
+	}
+
+	/// <summary>
+	/// Adds a zero initialized row to the archetype for a new or recycled entity index
+	/// </summary>
+	Entity World::allocateEntity(int archetypeIndex)
+	{
+		Entity entity;
+		if (!m_freeIndices.empty()) {
+			entity.index = m_freeIndices.back();
+			m_freeIndices.pop_back();
+		}
+		else {
+			entity.index = (uint32_t)m_records.size();
+			m_records.push_back(EntityRecord());
+		}
+		Archetype& archetype = m_archetypes[archetypeIndex];
+		EntityRecord& record = m_records[entity.index];
+		entity.generation = record.generation;
+		record.archetype = archetypeIndex;
+		record.row = (uint32_t)archetype.size();
+		archetype.entities.push_back(entity);
+		for (Archetype::Column& column : archetype.columns) {
+			column.bytes.resize(column.bytes.size() + column.elementSize);
+		}
+		m_numAlive++;
+		return entity;
+	}
+
+	/// <summary>
+	/// Moves an entity's row to another archetype, copying the components both have.
+	/// Components only the new archetype has are zero initialized
+	/// </summary>
+	void World::moveEntity(uint32_t index, int toArchetype)
+	{
+		EntityRecord& record = m_records[index];
+		const int fromArchetype = record.archetype;
+		const uint32_t fromRow = record.row;
+		Archetype& to = m_archetypes[toArchetype];
+		Archetype& from = m_archetypes[fromArchetype];
+		const uint32_t toRow = (uint32_t)to.size();
+		to.entities.push_back(from.entities[fromRow]);
+		for (Archetype::Column& column : to.columns) {
+			column.bytes.resize(column.bytes.size() + column.elementSize);
+			const int fromColumn = from.columnOf[column.component];
+			if (fromColumn >= 0) {
+				memcpy(to.row(to.columnOf[column.component], toRow), from.row(fromColumn, fromRow), column.elementSize);
+			}
+		}
+		removeRow(fromArchetype, fromRow);
+		record.archetype = toArchetype;
+		record.row = toRow;
+	}
+
+	/// <summary>
+	/// Removes a row by moving the archetype's last row into it
+	/// </summary>
+	void World::removeRow(int archetypeIndex, uint32_t row)
+	{
+		Archetype& archetype = m_archetypes[archetypeIndex];
+		const uint32_t last = (uint32_t)archetype.size() - 1;
+		if (row != last) {
+			archetype.entities[row] = archetype.entities[last];
+			m_records[archetype.entities[row].index].row = row;
+			for (size_t column = 0; column < archetype.columns.size(); column++)
+			{
+				memcpy(archetype.row((int)column, row), archetype.row((int)column, last), archetype.columns[column].elementSize);
+			}
+		}
+		archetype.entities.pop_back();
+		for (Archetype::Column& column : archetype.columns) {
+			column.bytes.resize(column.bytes.size() - column.elementSize);
+		}
+	}
+
+	std::vector<ChunkView> World::matchingChunks(ComponentMask mask)
+	{
+		std::vector<ChunkView> chunks;
+		for (Archetype& archetype : m_archetypes) {
+			if ((archetype.mask & mask) == mask && archetype.size() > 0) {
+				chunks.push_back(ChunkView(&archetype, 0, archetype.size()));
+			}
+		}
+		return chunks;
+	}
+
+	/// <summary>
+	/// Runs the chunks of thread 0 on the calling thread and the others as jobs on DefaultJobSystem, then waits for all of them
+	/// </summary>
+	void World::runChunks(const std::vector<std::vector<ChunkView>>& threadChunks, void (*run)(void* context, int thread, const ChunkView& chunk), void* context)
+	{
+		struct RunContext {
+			const std::vector<std::vector<ChunkView>>* threadChunks;
+			void (*run)(void* context, int thread, const ChunkView& chunk);
+			void* context;
+		};
+		RunContext runContext = { &threadChunks, run, context };
+		auto runThread = [](const Job& job) {
+			const RunContext& shared = *static_cast<const RunContext*>(job.data);
+			for (const ChunkView& chunk : (*shared.threadChunks)[job.begin]) {
+				shared.run(shared.context, (int)job.begin, chunk);
+			}
+		};
+		//Each range is one job, so the thread index passed to f stays a valid index into per-thread data
+		JobSystem& jobSystem = DefaultJobSystem();
+		JobCounter counter;
+		for (size_t thread = 1; thread < threadChunks.size(); thread++)
+		{
+			if (!threadChunks[thread].empty()) {
+				Job job;
+				job.function = runThread;
+				job.data = &runContext;
+				job.begin = thread;
+				job.counter = &counter;
+				jobSystem.run(job);
+			}
+		}
+		Job first;
+		first.data = &runContext;
+		runThread(first);
+		jobSystem.wait(counter);
+	}
+}
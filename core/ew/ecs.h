@@ -0,0 +1,295 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <tuple>
+#include <algorithm>
+#include <type_traits>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "ewMath/ewMath.h"
+#include "transform.h"
+#include "bounds.h"
+#include "geometryArena.h"
+
+namespace ew {
+	class Mesh;
+	class Shader;
+
+	//Renderable components. Entities with Transform, MeshRef and MaterialRef are drawn by the render system (renderSystem.h)
+	struct MeshRef {
+		const Mesh* mesh = nullptr; //Drawn by RenderQueue
+		MeshAllocation allocation; //Drawn by IndirectBatch
+	};
+	struct MaterialRef {
+		const Shader* shader = nullptr; //RenderQueue only
+		unsigned int texture = 0; //GL texture bound to unit 0, RenderQueue only
+		uint32_t materialIndex = 0; //Index returned by MaterialTable::addMaterial, IndirectBatch only
+		bool transparent = false;
+	};
+	//Point light at the entity's Transform position
+	struct Light {
+		ew::Vec3 color = ew::Vec3(1.0f);
+		float intensity = 1.0f;
+	};
+	//Local space bounds (e.g. MeshData::bounds) and the world space box around them, kept up to date by UpdateWorldBounds.
+	//Rendered entities with Bounds are frustum culled
+	struct Bounds {
+		AABB local;
+		AABB world;
+	};
+
+	//Handle to an entity. The generation changes when an index is reused, so handles to destroyed entities stay invalid
+	struct Entity {
+		uint32_t index = 0xFFFFFFFF;
+		uint32_t generation = 0;
+		inline bool operator==(const Entity& other)const { return index == other.index && generation == other.generation; }
+		inline bool operator!=(const Entity& other)const { return !(*this == other); }
+	};
+
+	typedef uint64_t ComponentMask;
+	const int MAX_COMPONENT_TYPES = 64;
+
+	//Every component type gets a bit in ComponentMask on first use, shared by all Worlds
+	int NextComponentId();
+	template<typename T>
+	inline int ComponentId() {
+		static const int id = NextComponentId();
+		return id;
+	}
+	template<typename... Ts>
+	inline ComponentMask ComponentMaskOf() {
+		return (ComponentMask(0) | ... | (ComponentMask(1) << ComponentId<Ts>()));
+	}
+
+	//All entities with exactly the same set of components. Each component type is one contiguous array (column),
+	//and row i of every column belongs to entities[i]
+	struct Archetype {
+		struct Column {
+			int component;
+			size_t elementSize;
+			std::vector<unsigned char> bytes;
+		};
+		ComponentMask mask = 0;
+		std::vector<Entity> entities;
+		std::vector<Column> columns;
+		int columnOf[MAX_COMPONENT_TYPES]; //-1 for components not in the archetype
+
+		inline size_t size()const { return entities.size(); }
+		inline unsigned char* row(int column, size_t i) { return columns[column].bytes.data() + i * columns[column].elementSize; }
+	};
+
+	//Rows [begin, begin + count) of one archetype
+	class ChunkView {
+	public:
+		ChunkView(Archetype* archetype, size_t begin, size_t count) :m_archetype(archetype), m_begin(begin), m_count(count) {};
+		inline size_t size()const { return m_count; }
+		inline const Entity* entities()const { return m_archetype->entities.data() + m_begin; }
+		//count rows starting at offset within this chunk
+		inline ChunkView subrange(size_t offset, size_t count)const { return ChunkView(m_archetype, m_begin + offset, count); }
+		//Contiguous array of size() components, or nullptr if the archetype doesn't have T
+		template<typename T>
+		inline T* get()const {
+			const int column = m_archetype->columnOf[ComponentId<T>()];
+			return column < 0 ? nullptr : reinterpret_cast<T*>(m_archetype->row(column, m_begin));
+		}
+	private:
+		Archetype* m_archetype;
+		size_t m_begin;
+		size_t m_count;
+	};
+
+	//Entity-component store grouping entities by archetype, so systems iterate tightly packed component arrays.
+	//Components must be trivially copyable structs; they are moved between archetypes with memcpy.
+	//Adding or removing entities and components invalidates component pointers and must not happen while iterating
+	class World {
+	public:
+		World();
+		Entity create();
+		template<typename... Ts>
+		Entity create(const Ts&... components);
+		void destroy(Entity entity);
+		void clear();
+		bool isAlive(Entity entity)const;
+		inline int size()const { return m_numAlive; }
+
+		//Adds the component, or overwrites it if the entity already has one
+		template<typename T>
+		void add(Entity entity, const T& component);
+		template<typename T>
+		void remove(Entity entity);
+		template<typename T>
+		bool has(Entity entity)const;
+		//nullptr if the entity is destroyed or doesn't have T
+		template<typename T>
+		T* get(Entity entity);
+
+		//Calls f(Ts&... components) for every entity that has all of Ts
+		template<typename... Ts, typename F>
+		void each(F f);
+		//Calls f(const ChunkView&) once per archetype that has all of Ts
+		template<typename... Ts, typename F>
+		void eachChunk(F f);
+		//Splits the entities that have all of Ts into up to numThreads ranges, run as jobs on DefaultJobSystem (jobSystem.h)
+		//with the first range on the calling thread. Calls f(int thread, const ChunkView&) with the range index as thread,
+		//possibly several times per range. f may only write to the components of its chunk and to data owned by its thread index
+		template<typename... Ts, typename F>
+		void parallelEachChunk(F f, int numThreads);
+		//Calls f(Ts&... components) for every entity that has all of Ts, split into up to numThreads jobs
+		template<typename... Ts, typename F>
+		void parallelEach(F f, int numThreads);
+		//Number of ranges parallelEachChunk splits numEntities entities into when given numThreads.
+		//Each range holds at most numEntities / ranges entities, rounded up
+		static int parallelRanges(size_t numEntities, int numThreads);
+	private:
+		struct EntityRecord {
+			uint32_t generation = 0;
+			int archetype = -1; //-1 when destroyed
+			uint32_t row = 0;
+		};
+		template<typename T>
+		void registerComponent();
+		int findOrCreateArchetype(ComponentMask mask);
+		Entity allocateEntity(int archetype);
+		void moveEntity(uint32_t index, int toArchetype);
+		void removeRow(int archetype, uint32_t row);
+		void runChunks(const std::vector<std::vector<ChunkView>>& threadChunks, void (*run)(void* context, int thread, const ChunkView& chunk), void* context);
+		std::vector<ChunkView> matchingChunks(ComponentMask mask);
+		std::vector<Archetype> m_archetypes;
+		std::unordered_map<ComponentMask, int> m_archetypeIndex;
+		std::vector<EntityRecord> m_records;
+		std::vector<uint32_t> m_freeIndices;
+		size_t m_componentSizes[MAX_COMPONENT_TYPES];
+		int m_numAlive = 0;
+	};
+
+	template<typename T>
+	inline void World::registerComponent() {
+		static_assert(std::is_trivially_copyable<T>::value, "Components are moved with memcpy");
+		static_assert(alignof(T) <= alignof(std::max_align_t), "Component columns are only aligned to max_align_t");
+		m_componentSizes[ComponentId<T>()] = sizeof(T);
+	}
+
+	template<typename... Ts>
+	inline Entity World::create(const Ts&... components) {
+		(registerComponent<Ts>(), ...);
+		const int archetypeIndex = findOrCreateArchetype(ComponentMaskOf<Ts...>());
+		const Entity entity = allocateEntity(archetypeIndex);
+		Archetype& archetype = m_archetypes[archetypeIndex];
+		const size_t row = m_records[entity.index].row;
+		(memcpy(archetype.row(archetype.columnOf[ComponentId<Ts>()], row), &components, sizeof(Ts)), ...);
+		return entity;
+	}
+
+	template<typename T>
+	inline void World::add(Entity entity, const T& component) {
+		if (!isAlive(entity)) {
+			return;
+		}
+		registerComponent<T>();
+		const ComponentMask mask = m_archetypes[m_records[entity.index].archetype].mask | ComponentMaskOf<T>();
+		if (mask != m_archetypes[m_records[entity.index].archetype].mask) {
+			moveEntity(entity.index, findOrCreateArchetype(mask));
+		}
+		memcpy(get<T>(entity), &component, sizeof(T));
+	}
+
+	template<typename T>
+	inline void World::remove(Entity entity) {
+		if (!has<T>(entity)) {
+			return;
+		}
+		const ComponentMask mask = m_archetypes[m_records[entity.index].archetype].mask & ~ComponentMaskOf<T>();
+		moveEntity(entity.index, findOrCreateArchetype(mask));
+	}
+
+	template<typename T>
+	inline bool World::has(Entity entity)const {
+		return isAlive(entity) && (m_archetypes[m_records[entity.index].archetype].mask & ComponentMaskOf<T>()) != 0;
+	}
+
+	template<typename T>
+	inline T* World::get(Entity entity) {
+		if (!isAlive(entity)) {
+			return nullptr;
+		}
+		const EntityRecord& record = m_records[entity.index];
+		Archetype& archetype = m_archetypes[record.archetype];
+		const int column = archetype.columnOf[ComponentId<T>()];
+		return column < 0 ? nullptr : reinterpret_cast<T*>(archetype.row(column, record.row));
+	}
+
+	template<typename... Ts, typename F>
+	inline void World::eachChunk(F f) {
+		for (const ChunkView& chunk : matchingChunks(ComponentMaskOf<Ts...>())) {
+			f(chunk);
+		}
+	}
+
+	template<typename... Ts, typename F>
+	inline void World::each(F f) {
+		eachChunk<Ts...>([&f](const ChunkView& chunk) {
+			const std::tuple<Ts*...> arrays(chunk.get<Ts>()...);
+			for (size_t i = 0; i < chunk.size(); i++)
+			{
+				f(std::get<Ts*>(arrays)[i]...);
+			}
+		});
+	}
+
+	template<typename... Ts, typename F>
+	inline void World::parallelEachChunk(F f, int numThreads) {
+		const std::vector<ChunkView> chunks = matchingChunks(ComponentMaskOf<Ts...>());
+		size_t total = 0;
+		for (const ChunkView& chunk : chunks) {
+			total += chunk.size();
+		}
+		numThreads = parallelRanges(total, numThreads);
+		if (numThreads <= 1) {
+			for (const ChunkView& chunk : chunks) {
+				f(0, chunk);
+			}
+			return;
+		}
+		//Even ranges of entities, splitting archetypes across threads where needed
+		std::vector<std::vector<ChunkView>> threadChunks(numThreads);
+		const size_t perThread = (total + numThreads - 1) / numThreads;
+		size_t range = 0, rangeFilled = 0;
+		for (const ChunkView& chunk : chunks) {
+			size_t offset = 0;
+			while (offset < chunk.size()) {
+				const size_t count = std::min(chunk.size() - offset, perThread - rangeFilled);
+				threadChunks[range].push_back(chunk.subrange(offset, count));
+				offset += count;
+				rangeFilled += count;
+				if (rangeFilled == perThread) {
+					range++;
+					rangeFilled = 0;
+				}
+			}
+		}
+		runChunks(threadChunks, [](void* context, int thread, const ChunkView& chunk) {
+			(*static_cast<F*>(context))(thread, chunk);
+		}, &f);
+	}
+
+	inline int World::parallelRanges(size_t numEntities, int numThreads) {
+		//Below this many entities per range, queuing jobs costs more than it saves
+		const size_t MIN_ENTITIES_PER_THREAD = 4096;
+		if ((size_t)numThreads > numEntities / MIN_ENTITIES_PER_THREAD) {
+			numThreads = (int)(numEntities / MIN_ENTITIES_PER_THREAD);
+		}
+		return numThreads < 1 ? 1 : numThreads;
+	}
+
+	template<typename... Ts, typename F>
+	inline void World::parallelEach(F f, int numThreads) {
+		parallelEachChunk<Ts...>([&f](int, const ChunkView& chunk) {
+			const std::tuple<Ts*...> arrays(chunk.get<Ts>()...);
+			for (size_t i = 0; i < chunk.size(); i++)
+			{
+				f(std::get<Ts*>(arrays)[i]...);
+			}
+		}, numThreads);
+	}
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <math.h>
+#include <limits>
+
+//Lets math functions run their constexpr fallbacks at compile time and the C library at runtime.
+//Without the builtin they are plain inline functions
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define EW_HAS_CONSTANT_EVALUATED
+#endif
+#endif
+#if !defined(EW_HAS_CONSTANT_EVALUATED) && ((defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925))
+#define EW_HAS_CONSTANT_EVALUATED
+#endif
+
+#if defined(EW_HAS_CONSTANT_EVALUATED)
+#define EW_CONSTEXPR_MATH constexpr
+#define EW_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define EW_CONSTEXPR_MATH inline
+#define EW_IS_CONSTANT_EVALUATED() false
+#endif
+
+namespace ew {
+	//Compile time versions of the C library functions. Evaluated in double, then rounded to float
+	namespace constexprMath {
+		constexpr float Sqrt(float x) {
+			if (x < 0.0f || x != x) {
+				return std::numeric_limits<float>::quiet_NaN();
+			}
+			if (x == 0.0f || x == std::numeric_limits<float>::infinity()) {
+				return x;
+			}
+			//Newton's method converges from above when started above the root
+			double guess = x > 1.0f ? (double)x : 1.0;
+			for (int i = 0; i < 128; i++)
+			{
+				const double next = 0.5 * (guess + x / guess);
+				if (next >= guess) {
+					break;
+				}
+				guess = next;
+			}
+			return (float)guess;
+		}
+
+		//Angle in [-pi, pi] with the same sine and cosine as rad
+		constexpr double WrapAngle(double rad) {
+			const double tau = 6.283185307179586476925;
+			const double turns = rad / tau;
+			const long long nearest = (long long)(turns < 0.0 ? turns - 0.5 : turns + 0.5);
+			return rad - (double)nearest * tau;
+		}
+
+		constexpr float Sin(float rad) {
+			//Taylor series, which converges quickly once the angle is wrapped
+			const double x = WrapAngle(rad);
+			double term = x;
+			double sum = x;
+			for (int n = 1; n < 32 && term != 0.0; n++)
+			{
+				term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+				sum += term;
+			}
+			return (float)sum;
+		}
+
+		constexpr float Cos(float rad) {
+			const double x = WrapAngle(rad);
+			double term = 1.0;
+			double sum = 1.0;
+			for (int n = 1; n < 32 && term != 0.0; n++)
+			{
+				term *= -x * x / ((2.0 * n - 1.0) * (2.0 * n));
+				sum += term;
+			}
+			return (float)sum;
+		}
+
+		constexpr float Tan(float rad) {
+			return Sin(rad) / Cos(rad);
+		}
+	}
+
+	EW_CONSTEXPR_MATH float Sqrt(float x) {
+		if (EW_IS_CONSTANT_EVALUATED()) {
+			return constexprMath::Sqrt(x);
+		}
+		return sqrtf(x);
+	}
+
+	EW_CONSTEXPR_MATH float Sin(float rad) {
+		if (EW_IS_CONSTANT_EVALUATED()) {
+			return constexprMath::Sin(rad);
+		}
+		return sinf(rad);
+	}
+
+	EW_CONSTEXPR_MATH float Cos(float rad) {
+		if (EW_IS_CONSTANT_EVALUATED()) {
+			return constexprMath::Cos(rad);
+		}
+		return cosf(rad);
+	}
+
+	EW_CONSTEXPR_MATH float Tan(float rad) {
+		if (EW_IS_CONSTANT_EVALUATED()) {
+			return constexprMath::Tan(rad);
+		}
+		return tanf(rad);
+	}
+}
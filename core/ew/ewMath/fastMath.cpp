@@ -0,0 +1,53 @@
+#include "fastMath.h"
+#include "simdLanes.h"
+
+using namespace ew::simd;
+
+namespace ew {
+	void SinCos(const float* rad, float* sines, float* cosines, size_t count)
+	{
+		size_t i = 0;
+#if defined(EW_SIMD_LANES)
+		//Same steps as the scalar SinCos, with the quadrant kept in floats so AVX doesn't need integer ops
+		const Lanes signMask = splat(-0.0f);
+		const Lanes one = splat(1.0f);
+		const Lanes half = splat(0.5f);
+		const Lanes fastRange = splat(SINCOS_FAST_RANGE);
+		for (; i + LANE_COUNT <= count; i += LANE_COUNT)
+		{
+			const Lanes x = load(rad + i);
+			const Lanes sign = bitAnd(x, signMask);
+			const Lanes a = bitAndNot(signMask, x);
+			//Angles out of range, infinite or NaN would overflow the truncation, so the scalar version takes them
+			if (!allTrue(lessEqual(a, fastRange))) {
+				for (size_t lane = i; lane < i + LANE_COUNT; lane++)
+				{
+					SinCos(rad[lane], sines[lane], cosines[lane]);
+				}
+				continue;
+			}
+			Lanes j = truncate(mul(a, splat(1.27323954473516f)));
+			j = mul(truncate(mul(add(j, one), half)), splat(2.0f));
+			const Lanes r = sub(sub(sub(a, mul(j, splat(0.78515625f))), mul(j, splat(2.4187564849853515625e-4f))), mul(j, splat(3.77489497744594108e-8f)));
+			const Lanes z = mul(r, r);
+			const Lanes sinR = add(r, mul(mul(r, z), mulAdd(z, mulAdd(z, splat(-1.9515295891e-4f), splat(8.3321608736e-3f)), splat(-1.6666654611e-1f))));
+			const Lanes cosPoly = mulAdd(z, mulAdd(z, splat(2.443315711809948e-5f), splat(-1.388731625493765e-3f)), splat(4.166664568298827e-2f));
+			const Lanes cosR = add(sub(one, mul(half, z)), mul(mul(z, z), cosPoly));
+
+			//Quadrant 0-3: odd quadrants swap sin and cos, 2-3 negate sin, 1-2 negate cos
+			const Lanes q = sub(mul(j, half), mul(truncate(mul(j, splat(0.125f))), splat(4.0f)));
+			const Lanes swap = equal(sub(q, mul(truncate(mul(q, half)), splat(2.0f))), one);
+			const Lanes negateSin = less(splat(1.5f), q);
+			const Lanes negateCos = less(bitAndNot(signMask, sub(q, splat(1.5f))), one);
+			const Lanes s = select(swap, cosR, sinR);
+			const Lanes c = select(swap, sinR, cosR);
+			store(sines + i, bitXor(bitXor(s, bitAnd(negateSin, signMask)), sign));
+			store(cosines + i, bitXor(c, bitAnd(negateCos, signMask)));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			SinCos(rad[i], sines[i], cosines[i]);
+		}
+	}
+}
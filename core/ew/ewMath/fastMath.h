@@ -0,0 +1,158 @@
+#pragma once
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+#include "constexprMath.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EW_FAST_MATH_SSE
+#endif
+
+namespace ew {
+	//Accuracy tiers of the approximations below. HIGH calls the C library.
+	//Max absolute error, reported as maxError by the core_bench fastMath benchmarks, over the ranges listed:
+	//                                 LOW        MEDIUM     HIGH
+	//  SinCos  |rad| <= 1000          3.3e-4     9.3e-8     libm    (libm past SINCOS_FAST_RANGE)
+	//  Rsqrt   (relative) 1e-6..1e6   3.3e-4     2.5e-7     libm    (1.8e-3 and 4.7e-6 without SSE)
+	//  Atan2   any                    1.5e-3     2.0e-6     libm
+	//  Acos    [-1, 1]                6.8e-5     4.3e-7     libm
+	enum class Precision {
+		LOW = 0,
+		MEDIUM = 1,
+		HIGH = 2
+	};
+
+	//Largest |rad| the LOW and MEDIUM SinCos reduce themselves. Past it the reduction loses precision, so they call the C library
+	constexpr float SINCOS_FAST_RANGE = 8192.0f;
+
+	//Sine and cosine of one angle, sharing the range reduction. NaN for infinite or NaN input
+	template<Precision P = Precision::MEDIUM>
+	EW_CONSTEXPR_MATH void SinCos(float rad, float& s, float& c) {
+		if constexpr (P == Precision::HIGH) {
+			s = ew::Sin(rad);
+			c = ew::Cos(rad);
+			return;
+		}
+		else {
+			const float a = rad < 0.0f ? -rad : rad;
+			//Also catches infinity and NaN, before they reach the integer conversion below
+			if (!(a <= SINCOS_FAST_RANGE)) {
+				s = ew::Sin(rad);
+				c = ew::Cos(rad);
+				return;
+			}
+			//Reduce to r in [-pi/4, pi/4] and quadrant q (Cody-Waite, with pi/4 split into 3 parts)
+			long long j = (long long)(a * 1.27323954473516f); //4 / pi
+			j = (j + 1) & ~1ll;
+			const float y = (float)j;
+			const float r = ((a - y * 0.78515625f) - y * 2.4187564849853515625e-4f) - y * 3.77489497744594108e-8f;
+			const float z = r * r;
+			float sinR = 0.0f, cosR = 0.0f;
+			if constexpr (P == Precision::LOW) {
+				sinR = r + r * z * (-1.6666667e-1f + z * 8.3333333e-3f);
+				cosR = 1.0f - 0.5f * z + z * z * 4.1666667e-2f;
+			}
+			else {
+				sinR = r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+				cosR = 1.0f - 0.5f * z + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+			}
+			const int q = (int)((j >> 1) & 3);
+			const bool swap = (q & 1) != 0;
+			s = swap ? cosR : sinR;
+			c = swap ? sinR : cosR;
+			if (q >= 2) {
+				s = -s;
+			}
+			if (q == 1 || q == 2) {
+				c = -c;
+			}
+			if (rad < 0.0f) {
+				s = -s;
+			}
+		}
+	}
+
+	//Bulk MEDIUM SinCos, 8 (AVX) or 4 (SSE) angles per instruction, with the same algorithm and range as the scalar version
+	void SinCos(const float* rad, float* sines, float* cosines, size_t count);
+
+	//1 / sqrt(x) for x > 0
+	template<Precision P = Precision::MEDIUM>
+	inline float Rsqrt(float x) {
+		if constexpr (P == Precision::HIGH) {
+			return 1.0f / sqrtf(x);
+		}
+		else {
+#if defined(EW_FAST_MATH_SSE)
+			//12 bit hardware estimate
+			float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+#else
+			//Initial guess from the exponent bits, then an extra Newton step to make up for it
+			unsigned int bits;
+			memcpy(&bits, &x, sizeof(bits));
+			bits = 0x5f3759df - (bits >> 1);
+			float y;
+			memcpy(&y, &bits, sizeof(y));
+			y = y * (1.5f - 0.5f * x * y * y);
+#endif
+			if constexpr (P == Precision::MEDIUM) {
+				y = y * (1.5f - 0.5f * x * y * y);
+			}
+			return y;
+		}
+	}
+
+	//Angle of (x, y) from the +x axis in radians, in [-pi, pi]. 0 for (0, 0)
+	template<Precision P = Precision::MEDIUM>
+	inline float Atan2(float y, float x) {
+		if constexpr (P == Precision::HIGH) {
+			return atan2f(y, x);
+		}
+		else {
+			const float ax = fabsf(x), ay = fabsf(y);
+			const float maxXY = ax > ay ? ax : ay;
+			if (maxXY == 0.0f) {
+				return 0.0f;
+			}
+			//atan(t) for t in [0, 1]
+			const float t = (ax < ay ? ax : ay) / maxXY;
+			float angle = 0.0f;
+			if constexpr (P == Precision::LOW) {
+				angle = 0.78539816f * t - t * (t - 1.0f) * (0.2447f + 0.0663f * t);
+			}
+			else {
+				const float t2 = t * t;
+				angle = t * (0.99997726f + t2 * (-0.33262347f + t2 * (0.19354346f + t2 * (-0.11643287f + t2 * (0.05265332f + t2 * -0.01172120f)))));
+			}
+			if (ay > ax) {
+				angle = 1.57079633f - angle;
+			}
+			if (x < 0.0f) {
+				angle = 3.14159265f - angle;
+			}
+			return y < 0.0f ? -angle : angle;
+		}
+	}
+
+	//Arc cosine in radians. x is clamped to [-1, 1]
+	template<Precision P = Precision::MEDIUM>
+	inline float Acos(float x) {
+		if constexpr (P == Precision::HIGH) {
+			return acosf(x < -1.0f ? -1.0f : (x > 1.0f ? 1.0f : x));
+		}
+		else {
+			//Abramowitz and Stegun 4.4.45 (LOW) and 4.4.46 (MEDIUM) for x in [0, 1], mirrored for negative x
+			const float a = fminf(fabsf(x), 1.0f);
+			float p = 0.0f;
+			if constexpr (P == Precision::LOW) {
+				p = 1.5707288f + a * (-0.2121144f + a * (0.0742610f + a * -0.0187293f));
+			}
+			else {
+				p = 1.5707963050f + a * (-0.2145988016f + a * (0.0889789874f + a * (-0.0501743046f + a * (0.0308918810f
+					+ a * (-0.0170881256f + a * (0.0066700901f + a * -0.0012624911f))))));
+			}
+			const float angle = sqrtf(1.0f - a) * p;
+			return x < 0.0f ? 3.14159265f - angle : angle;
+		}
+	}
+}
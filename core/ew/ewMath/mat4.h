@@ -6,75 +6,77 @@
 #include "vec4.h"
 #include <cstddef>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EW_MAT4_SSE
+#endif
+
 namespace ew {
 	struct Mat4 {
 	private:
 		float n[4][4];
 	public:
 		Mat4() = default;
-		Mat4(float n00)
+		constexpr Mat4(float n00)
+			:n{ { n00, n00, n00, n00 }, { n00, n00, n00, n00 }, { n00, n00, n00, n00 }, { n00, n00, n00, n00 } }
 		{
-			n[0][0] = n00; n[1][0] = n00; n[2][0] = n00; n[3][0] = n00;
-			n[0][1] = n00; n[1][1] = n00; n[2][1] = n00; n[3][1] = n00;
-			n[0][2] = n00; n[1][2] = n00; n[2][2] = n00; n[3][2] = n00;
-			n[0][3] = n00; n[1][3] = n00; n[2][3] = n00; n[3][3] = n00;
 		};
-		Mat4(float n00, float n10, float n20, float n30,
+		constexpr Mat4(float n00, float n10, float n20, float n30,
 			 float n01, float n11, float n21, float n31,
 			 float n02, float n12, float n22, float n32,
 			 float n03, float n13, float n23, float n33)
+			:n{ { n00, n01, n02, n03 }, { n10, n11, n12, n13 }, { n20, n21, n22, n23 }, { n30, n31, n32, n33 } }
 		{
-			n[0][0] = n00; n[1][0] = n10; n[2][0] = n20; n[3][0] = n30;
-			n[0][1] = n01; n[1][1] = n11; n[2][1] = n21; n[3][1] = n31;
-			n[0][2] = n02; n[1][2] = n12; n[2][2] = n22; n[3][2] = n32;
-			n[0][3] = n03; n[1][3] = n13; n[2][3] = n23; n[3][3] = n33;
 		};
-		Mat4(const Vec4& a, const Vec4& b, const Vec4& c, const Vec4& d) {
-			n[0][0] = a.x; n[0][1] = a.y; n[0][2] = a.z; n[0][3] = a.w;
-			n[1][0] = b.x; n[1][1] = b.y; n[1][2] = b.z; n[1][3] = b.w;
-			n[2][0] = c.x; n[2][1] = c.y; n[2][2] = c.z; n[2][3] = c.w;
-			n[3][0] = d.x; n[3][1] = d.y; n[3][2] = d.z; n[3][3] = d.w;
+		constexpr Mat4(const Vec4& a, const Vec4& b, const Vec4& c, const Vec4& d)
+			:n{ { a.x, a.y, a.z, a.w }, { b.x, b.y, b.z, b.w }, { c.x, c.y, c.z, c.w }, { d.x, d.y, d.z, d.w } }
+		{
 		}
+		//Not constexpr, since a column is reinterpreted as a Vec4. Use at() in constant expressions
 		inline Vec4& operator[](int i) {
 			return (*reinterpret_cast<Vec4*>(n[i]));
 		}
 		inline const Vec4& operator[](int i) const{
 			return (*reinterpret_cast<const Vec4*>(n[i]));
 		}
-		inline friend Vec4 operator * (const Mat4& m, const Vec4& v) {
+		//Element at column, row
+		constexpr float at(int column, int row) const {
+			return n[column][row];
+		}
+		constexpr friend Vec4 operator * (const Mat4& m, const Vec4& v) {
 			return Vec4(
-				m[0][0] * v.x + m[1][0] * v.y + m[2][0] * v.z + m[3][0] * v.w,
-				m[0][1] * v.x + m[1][1] * v.y + m[2][1] * v.z + m[3][1] * v.w,
-				m[0][2] * v.x + m[1][2] * v.y + m[2][2] * v.z + m[3][2] * v.w,
-				m[0][3] * v.x + m[1][3] * v.y + m[2][3] * v.z + m[3][3] * v.w
+				m.n[0][0] * v.x + m.n[1][0] * v.y + m.n[2][0] * v.z + m.n[3][0] * v.w,
+				m.n[0][1] * v.x + m.n[1][1] * v.y + m.n[2][1] * v.z + m.n[3][1] * v.w,
+				m.n[0][2] * v.x + m.n[1][2] * v.y + m.n[2][2] * v.z + m.n[3][2] * v.w,
+				m.n[0][3] * v.x + m.n[1][3] * v.y + m.n[2][3] * v.z + m.n[3][3] * v.w
 			);
 		}
-		inline friend Mat4 operator * (const Mat4& l, const Mat4& r) {
-			Mat4 m;
+		constexpr friend Mat4 operator * (const Mat4& l, const Mat4& r) {
+			Mat4 m(0.0f);
 			//Row 0
-			m[0][0] = l[0][0] * r[0][0] + l[1][0] * r[0][1] + l[2][0] * r[0][2] + l[3][0] * r[0][3];//dot(l_row_0,r_col_0)
-			m[1][0] = l[0][0] * r[1][0] + l[1][0] * r[1][1] + l[2][0] * r[1][2] + l[3][0] * r[1][3];//dot(l_row_0,r_col_1)
-			m[2][0] = l[0][0] * r[2][0] + l[1][0] * r[2][1] + l[2][0] * r[2][2] + l[3][0] * r[2][3];//dot(l_row_0,r_col_2)
-			m[3][0] = l[0][0] * r[3][0] + l[1][0] * r[3][1] + l[2][0] * r[3][2] + l[3][0] * r[3][3];//dot(l_row_0,r_col_3)
+			m.n[0][0] = l.n[0][0] * r.n[0][0] + l.n[1][0] * r.n[0][1] + l.n[2][0] * r.n[0][2] + l.n[3][0] * r.n[0][3];//dot(l_row_0,r_col_0)
+			m.n[1][0] = l.n[0][0] * r.n[1][0] + l.n[1][0] * r.n[1][1] + l.n[2][0] * r.n[1][2] + l.n[3][0] * r.n[1][3];//dot(l_row_0,r_col_1)
+			m.n[2][0] = l.n[0][0] * r.n[2][0] + l.n[1][0] * r.n[2][1] + l.n[2][0] * r.n[2][2] + l.n[3][0] * r.n[2][3];//dot(l_row_0,r_col_2)
+			m.n[3][0] = l.n[0][0] * r.n[3][0] + l.n[1][0] * r.n[3][1] + l.n[2][0] * r.n[3][2] + l.n[3][0] * r.n[3][3];//dot(l_row_0,r_col_3)
 			// Row 1		  		    		  		    		  		    		  
-			m[0][1] = l[0][1] * r[0][0] + l[1][1] * r[0][1] + l[2][1] * r[0][2] + l[3][1] * r[0][3];//dot(l_row_1,r_col_0)
-			m[1][1] = l[0][1] * r[1][0] + l[1][1] * r[1][1] + l[2][1] * r[1][2] + l[3][1] * r[1][3];//dot(l_row_1,r_col_1)
-			m[2][1] = l[0][1] * r[2][0] + l[1][1] * r[2][1] + l[2][1] * r[2][2] + l[3][1] * r[2][3];//dot(l_row_1,r_col_2)
-			m[3][1] = l[0][1] * r[3][0] + l[1][1] * r[3][1] + l[2][1] * r[3][2] + l[3][1] * r[3][3];//dot(l_row_1,r_col_3)
+			m.n[0][1] = l.n[0][1] * r.n[0][0] + l.n[1][1] * r.n[0][1] + l.n[2][1] * r.n[0][2] + l.n[3][1] * r.n[0][3];//dot(l_row_1,r_col_0)
+			m.n[1][1] = l.n[0][1] * r.n[1][0] + l.n[1][1] * r.n[1][1] + l.n[2][1] * r.n[1][2] + l.n[3][1] * r.n[1][3];//dot(l_row_1,r_col_1)
+			m.n[2][1] = l.n[0][1] * r.n[2][0] + l.n[1][1] * r.n[2][1] + l.n[2][1] * r.n[2][2] + l.n[3][1] * r.n[2][3];//dot(l_row_1,r_col_2)
+			m.n[3][1] = l.n[0][1] * r.n[3][0] + l.n[1][1] * r.n[3][1] + l.n[2][1] * r.n[3][2] + l.n[3][1] * r.n[3][3];//dot(l_row_1,r_col_3)
 			// Row  2		  		    		  		    		  		    		  
-			m[0][2] = l[0][2] * r[0][0] + l[1][2] * r[0][1] + l[2][2] * r[0][2] + l[3][2] * r[0][3];//dot(l_row_2,r_col_0)
-			m[1][2] = l[0][2] * r[1][0] + l[1][2] * r[1][1] + l[2][2] * r[1][2] + l[3][2] * r[1][3];//dot(l_row_2,r_col_1)
-			m[2][2] = l[0][2] * r[2][0] + l[1][2] * r[2][1] + l[2][2] * r[2][2] + l[3][2] * r[2][3];//dot(l_row_2,r_col_2)
-			m[3][2] = l[0][2] * r[3][0] + l[1][2] * r[3][1] + l[2][2] * r[3][2] + l[3][2] * r[3][3];//dot(l_row_2,r_col_3)
+			m.n[0][2] = l.n[0][2] * r.n[0][0] + l.n[1][2] * r.n[0][1] + l.n[2][2] * r.n[0][2] + l.n[3][2] * r.n[0][3];//dot(l_row_2,r_col_0)
+			m.n[1][2] = l.n[0][2] * r.n[1][0] + l.n[1][2] * r.n[1][1] + l.n[2][2] * r.n[1][2] + l.n[3][2] * r.n[1][3];//dot(l_row_2,r_col_1)
+			m.n[2][2] = l.n[0][2] * r.n[2][0] + l.n[1][2] * r.n[2][1] + l.n[2][2] * r.n[2][2] + l.n[3][2] * r.n[2][3];//dot(l_row_2,r_col_2)
+			m.n[3][2] = l.n[0][2] * r.n[3][0] + l.n[1][2] * r.n[3][1] + l.n[2][2] * r.n[3][2] + l.n[3][2] * r.n[3][3];//dot(l_row_2,r_col_3)
 			// Row  3		 			 		 			 		 			 		    
-			m[0][3] = l[0][3] * r[0][0] + l[1][3] * r[0][1] + l[2][3] * r[0][2] + l[3][3] * r[0][3];//dot(l_row_3,r_col_0)
-			m[1][3] = l[0][3] * r[1][0] + l[1][3] * r[1][1] + l[2][3] * r[1][2] + l[3][3] * r[1][3];//dot(l_row_3,r_col_1)
-			m[2][3] = l[0][3] * r[2][0] + l[1][3] * r[2][1] + l[2][3] * r[2][2] + l[3][3] * r[2][3];//dot(l_row_3,r_col_2)
-			m[3][3] = l[0][3] * r[3][0] + l[1][3] * r[3][1] + l[2][3] * r[3][2] + l[3][3] * r[3][3];//dot(l_row_3,r_col_3)
+			m.n[0][3] = l.n[0][3] * r.n[0][0] + l.n[1][3] * r.n[0][1] + l.n[2][3] * r.n[0][2] + l.n[3][3] * r.n[0][3];//dot(l_row_3,r_col_0)
+			m.n[1][3] = l.n[0][3] * r.n[1][0] + l.n[1][3] * r.n[1][1] + l.n[2][3] * r.n[1][2] + l.n[3][3] * r.n[1][3];//dot(l_row_3,r_col_1)
+			m.n[2][3] = l.n[0][3] * r.n[2][0] + l.n[1][3] * r.n[2][1] + l.n[2][3] * r.n[2][2] + l.n[3][3] * r.n[2][3];//dot(l_row_3,r_col_2)
+			m.n[3][3] = l.n[0][3] * r.n[3][0] + l.n[1][3] * r.n[3][1] + l.n[2][3] * r.n[3][2] + l.n[3][3] * r.n[3][3];//dot(l_row_3,r_col_3)
 			return m;		  
 		}
 	};
-	inline Mat4 IdentityMatrix() {
+	constexpr Mat4 IdentityMatrix() {
 		return Mat4(
 			1.0f, 0.0f, 0.0f, 0.0f,
 			0.0f, 1.0f, 0.0f, 0.0f,
@@ -82,4 +84,248 @@ namespace ew {
 			0.0f, 0.0f, 0.0f, 1.0f
 		);
 	}
+
+	//Portable versions of the functions below, used when SSE is unavailable. Always compiled, so tests can compare against them
+	namespace mat4scalar {
+		//Rows of the inverse of the upper 3x3 of m
+		inline void InverseRows3x3(const Mat4& m, Vec3& r0, Vec3& r1, Vec3& r2) {
+			const Vec3 c0 = m[0].toVec3(), c1 = m[1].toVec3(), c2 = m[2].toVec3();
+			r0 = Cross(c1, c2);
+			r1 = Cross(c2, c0);
+			r2 = Cross(c0, c1);
+			const float invDet = 1.0f / Dot(c0, r0);
+			r0 = r0 * invDet;
+			r1 = r1 * invDet;
+			r2 = r2 * invDet;
+		}
+		inline Mat4 Transpose(const Mat4& m) {
+			Mat4 r;
+			for (int c = 0; c < 4; c++)
+			{
+				for (int i = 0; i < 4; i++)
+				{
+					r[c][i] = m[i][c];
+				}
+			}
+			return r;
+		}
+		inline Mat4 Inverse(const Mat4& m) {
+			Mat4 r;
+			//Cofactors from the 2x2 determinants of the first two and last two columns
+			const float s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+			const float s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+			const float s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+			const float s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+			const float s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+			const float s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+			const float c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+			const float c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+			const float c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+			const float c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+			const float c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+			const float c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+			const float invDet = 1.0f / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+
+			r[0][0] = (m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * invDet;
+			r[0][1] = (-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * invDet;
+			r[0][2] = (m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * invDet;
+			r[0][3] = (-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * invDet;
+
+			r[1][0] = (-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * invDet;
+			r[1][1] = (m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * invDet;
+			r[1][2] = (-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * invDet;
+			r[1][3] = (m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * invDet;
+
+			r[2][0] = (m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * invDet;
+			r[2][1] = (-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * invDet;
+			r[2][2] = (m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * invDet;
+			r[2][3] = (-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * invDet;
+
+			r[3][0] = (-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * invDet;
+			r[3][1] = (m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * invDet;
+			r[3][2] = (-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * invDet;
+			r[3][3] = (m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * invDet;
+			return r;
+		}
+		inline Mat4 AffineInverse(const Mat4& m) {
+			Mat4 r;
+			Vec3 r0, r1, r2;
+			InverseRows3x3(m, r0, r1, r2);
+			const Vec3 t = m[3].toVec3();
+			r[0] = Vec4(r0.x, r1.x, r2.x, 0.0f);
+			r[1] = Vec4(r0.y, r1.y, r2.y, 0.0f);
+			r[2] = Vec4(r0.z, r1.z, r2.z, 0.0f);
+			r[3] = Vec4(-Dot(r0, t), -Dot(r1, t), -Dot(r2, t), 1.0f);
+			return r;
+		}
+		inline Mat4 NormalMatrix(const Mat4& m) {
+			Mat4 r;
+			Vec3 r0, r1, r2;
+			InverseRows3x3(m, r0, r1, r2);
+			r[0] = Vec4(r0, 0.0f);
+			r[1] = Vec4(r1, 0.0f);
+			r[2] = Vec4(r2, 0.0f);
+			r[3] = Vec4(0.0f, 0.0f, 0.0f, 1.0f);
+			return r;
+		}
+	}
+
+	inline Mat4 Transpose(const Mat4& m) {
+#if defined(EW_MAT4_SSE)
+		Mat4 r;
+		__m128 c0 = _mm_loadu_ps(&m[0][0]);
+		__m128 c1 = _mm_loadu_ps(&m[1][0]);
+		__m128 c2 = _mm_loadu_ps(&m[2][0]);
+		__m128 c3 = _mm_loadu_ps(&m[3][0]);
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		_mm_storeu_ps(&r[0][0], c0);
+		_mm_storeu_ps(&r[1][0], c1);
+		_mm_storeu_ps(&r[2][0], c2);
+		_mm_storeu_ps(&r[3][0], c3);
+		return r;
+#else
+		return mat4scalar::Transpose(m);
+#endif
+	}
+
+#if defined(EW_MAT4_SSE)
+	namespace mat4sse {
+		//2x2 matrices are packed in one register as (m00, m01, m10, m11)
+		inline __m128 Mat2Mul(__m128 a, __m128 b) {
+			return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+				_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+		}
+		//adjugate(a) * b
+		inline __m128 Mat2AdjMul(__m128 a, __m128 b) {
+			return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+				_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+		}
+		//a * adjugate(b)
+		inline __m128 Mat2MulAdj(__m128 a, __m128 b) {
+			return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+				_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+		}
+		//Cross product of the xyz lanes, with w = 0
+		inline __m128 Cross(__m128 a, __m128 b) {
+			const __m128 t = _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1))),
+				_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)), b));
+			return _mm_shuffle_ps(t, t, _MM_SHUFFLE(3, 0, 2, 1));
+		}
+		//Rows of the inverse of the upper 3x3 of m, with w = 0
+		inline void InverseRows3x3(const Mat4& m, __m128& r0, __m128& r1, __m128& r2) {
+			const __m128 c0 = _mm_loadu_ps(&m[0][0]);
+			const __m128 c1 = _mm_loadu_ps(&m[1][0]);
+			const __m128 c2 = _mm_loadu_ps(&m[2][0]);
+			r0 = Cross(c1, c2);
+			r1 = Cross(c2, c0);
+			r2 = Cross(c0, c1);
+			__m128 det = _mm_mul_ps(c0, r0);
+			det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(2, 3, 0, 1)));
+			det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(1, 0, 3, 2)));
+			const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+			r0 = _mm_mul_ps(r0, invDet);
+			r1 = _mm_mul_ps(r1, invDet);
+			r2 = _mm_mul_ps(r2, invDet);
+		}
+	}
+#endif
+
+	//General 4x4 inverse. m must be invertible; a singular matrix gives non-finite values.
+	//Prefer AffineInverse for model and view matrices
+	inline Mat4 Inverse(const Mat4& m) {
+#if defined(EW_MAT4_SSE)
+		Mat4 r;
+		//Blockwise inverse of the matrix split into 2x2 blocks A B / C D, using adjugates instead of 2x2 inverses.
+		//Works on the columns as if they were rows, which gives the transposed inverse stored transposed
+		const __m128 c0 = _mm_loadu_ps(&m[0][0]);
+		const __m128 c1 = _mm_loadu_ps(&m[1][0]);
+		const __m128 c2 = _mm_loadu_ps(&m[2][0]);
+		const __m128 c3 = _mm_loadu_ps(&m[3][0]);
+		const __m128 a = _mm_movelh_ps(c0, c1);
+		const __m128 b = _mm_movehl_ps(c1, c0);
+		const __m128 c = _mm_movelh_ps(c2, c3);
+		const __m128 d = _mm_movehl_ps(c3, c2);
+
+		//(|A|, |B|, |C|, |D|)
+		const __m128 detSub = _mm_sub_ps(
+			_mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(3, 1, 3, 1))),
+			_mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(2, 0, 2, 0))));
+		const __m128 detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+		const __m128 detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+		const __m128 detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+		const __m128 detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+		const __m128 dc = mat4sse::Mat2AdjMul(d, c);
+		const __m128 ab = mat4sse::Mat2AdjMul(a, b);
+		//Adjugates of the four blocks of the inverse, before dividing by |M|
+		__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mat4sse::Mat2Mul(b, dc));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mat4sse::Mat2Mul(c, ab));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), mat4sse::Mat2MulAdj(d, ab));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mat4sse::Mat2MulAdj(a, dc));
+
+		//|M| = |A||D| + |B||C| - trace(adj(A)B adj(D)C)
+		__m128 tr = _mm_mul_ps(ab, _mm_shuffle_ps(dc, dc, _MM_SHUFFLE(3, 1, 2, 0)));
+		tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(2, 3, 0, 1)));
+		tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 0, 3, 2)));
+		const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+		//Signs of the adjugate applied along with 1 / |M|
+		const __m128 invDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+		x = _mm_mul_ps(x, invDet);
+		y = _mm_mul_ps(y, invDet);
+		z = _mm_mul_ps(z, invDet);
+		w = _mm_mul_ps(w, invDet);
+
+		//Adjugate swizzle and store in one shuffle
+		_mm_storeu_ps(&r[0][0], _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_storeu_ps(&r[1][0], _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+		_mm_storeu_ps(&r[2][0], _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_storeu_ps(&r[3][0], _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+		return r;
+#else
+		return mat4scalar::Inverse(m);
+#endif
+	}
+
+	//Inverse of a matrix whose bottom row is (0, 0, 0, 1), e.g. any combination of translation, rotation and scale.
+	//Inverts the upper 3x3 with cross products and applies it to the negated translation
+	inline Mat4 AffineInverse(const Mat4& m) {
+#if defined(EW_MAT4_SSE)
+		Mat4 r;
+		__m128 c0, c1, c2;
+		mat4sse::InverseRows3x3(m, c0, c1, c2);
+		__m128 c3 = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		const __m128 t = _mm_loadu_ps(&m[3][0]);
+		const __m128 invT = _mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(c0, _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0))),
+			_mm_mul_ps(c1, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)))),
+			_mm_mul_ps(c2, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2))));
+		_mm_storeu_ps(&r[0][0], c0);
+		_mm_storeu_ps(&r[1][0], c1);
+		_mm_storeu_ps(&r[2][0], c2);
+		_mm_storeu_ps(&r[3][0], _mm_sub_ps(c3, invT));
+		return r;
+#else
+		return mat4scalar::AffineInverse(m);
+#endif
+	}
+
+	//transpose(inverse(mat3(m))) in the upper 3x3 and identity elsewhere. Transforms normals by m
+	//under non-uniform scale. Upload it so shaders don't invert the model matrix per vertex
+	inline Mat4 NormalMatrix(const Mat4& m) {
+#if defined(EW_MAT4_SSE)
+		Mat4 r;
+		//Rows of the inverse are the columns of its transpose
+		__m128 c0, c1, c2;
+		mat4sse::InverseRows3x3(m, c0, c1, c2);
+		_mm_storeu_ps(&r[0][0], c0);
+		_mm_storeu_ps(&r[1][0], c1);
+		_mm_storeu_ps(&r[2][0], c2);
+		_mm_storeu_ps(&r[3][0], _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+		return r;
+#else
+		return mat4scalar::NormalMatrix(m);
+#endif
+	}
 }
@@ -0,0 +1,166 @@
+#pragma once
+#include <math.h>
+#include "vec3.h"
+#include "vec4.h"
+#include "mat4.h"
+#include "fastMath.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EW_QUAT_SSE
+#endif
+
+namespace ew {
+	//Rotation as a unit quaternion. xyz is the rotation axis scaled by sin(angle / 2), w is cos(angle / 2).
+	//Default constructed to the identity rotation.
+	struct Quat {
+		float x, y, z, w;
+
+		constexpr Quat() :x(0), y(0), z(0), w(1) {};
+		constexpr Quat(float x, float y, float z, float w) :x(x), y(y), z(z), w(w) {};
+
+		friend Quat operator*(const Quat& a, const Quat& b);
+		friend constexpr Vec3 operator*(const Quat& q, const Vec3& v);
+	};
+
+	//Rotation by b, then a
+	inline Quat operator*(const Quat& a, const Quat& b)
+	{
+#if defined(EW_QUAT_SSE)
+		//Each component of a times b with its lanes reordered and signs flipped
+		const __m128 va = _mm_loadu_ps(&a.x);
+		const __m128 vb = _mm_loadu_ps(&b.x);
+		__m128 r = _mm_mul_ps(_mm_shuffle_ps(va, va, _MM_SHUFFLE(3, 3, 3, 3)), vb);
+		__m128 t = _mm_mul_ps(_mm_shuffle_ps(va, va, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(0, 1, 2, 3)));
+		r = _mm_add_ps(r, _mm_xor_ps(t, _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f)));
+		t = _mm_mul_ps(_mm_shuffle_ps(va, va, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(1, 0, 3, 2)));
+		r = _mm_add_ps(r, _mm_xor_ps(t, _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f)));
+		t = _mm_mul_ps(_mm_shuffle_ps(va, va, _MM_SHUFFLE(2, 2, 2, 2)), _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(2, 3, 0, 1)));
+		r = _mm_add_ps(r, _mm_xor_ps(t, _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f)));
+		Quat q;
+		_mm_storeu_ps(&q.x, r);
+		return q;
+#else
+		return Quat(
+			a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+			a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+			a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+			a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+		);
+#endif
+	}
+
+	//Rotates v. Expanded form of q * v * conjugate(q)
+	constexpr Vec3 operator*(const Quat& q, const Vec3& v)
+	{
+		const Vec3 axis(q.x, q.y, q.z);
+		const Vec3 t = Cross(axis, v) * 2.0f;
+		return v + t * q.w + Cross(axis, t);
+	}
+
+	constexpr float Dot(const Quat& a, const Quat& b) {
+		return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+	}
+
+	EW_CONSTEXPR_MATH Quat Normalize(const Quat& q)
+	{
+		float mag = ew::Sqrt(Dot(q, q));
+		if (mag == 0)
+			return Quat();
+		float invMag = 1.0f / mag;
+		return Quat(q.x * invMag, q.y * invMag, q.z * invMag, q.w * invMag);
+	}
+
+	//Inverse of a unit quaternion
+	constexpr Quat Conjugate(const Quat& q) {
+		return Quat(-q.x, -q.y, -q.z, q.w);
+	}
+
+	//Rotation around a unit length axis in radians
+	EW_CONSTEXPR_MATH Quat AngleAxis(float rad, const Vec3& axis) {
+		float s = 0.0f, c = 0.0f;
+		ew::SinCos(rad * 0.5f, s, c);
+		return Quat(axis.x * s, axis.y * s, axis.z * s, c);
+	}
+
+	//Euler angles in radians, applied in the same order as Transform: Z, then X, then Y.
+	//Closed form of AngleAxis(y, up) * AngleAxis(x, right) * AngleAxis(z, forward)
+	EW_CONSTEXPR_MATH Quat QuatFromEuler(const Vec3& rad) {
+		float sx = 0.0f, cx = 0.0f, sy = 0.0f, cy = 0.0f, sz = 0.0f, cz = 0.0f;
+		ew::SinCos(rad.x * 0.5f, sx, cx);
+		ew::SinCos(rad.y * 0.5f, sy, cy);
+		ew::SinCos(rad.z * 0.5f, sz, cz);
+		return Quat(
+			cy * sx * cz + sy * cx * sz,
+			sy * cx * cz - cy * sx * sz,
+			cy * cx * sz - sy * sx * cz,
+			cy * cx * cz + sy * sx * sz
+		);
+	}
+
+	//Normalized linear interpolation along the shortest path. Cheaper than Slerp, but the angular
+	//speed varies slightly over t
+	EW_CONSTEXPR_MATH Quat Nlerp(const Quat& a, const Quat& b, float t) {
+		const float sign = Dot(a, b) < 0.0f ? -1.0f : 1.0f;
+		const float ta = 1.0f - t, tb = t * sign;
+		return Normalize(Quat(a.x * ta + b.x * tb, a.y * ta + b.y * tb, a.z * ta + b.z * tb, a.w * ta + b.w * tb));
+	}
+
+	//Spherical linear interpolation along the shortest path, at constant angular speed
+	inline Quat Slerp(const Quat& a, const Quat& b, float t) {
+		float cosAngle = Dot(a, b);
+		const float sign = cosAngle < 0.0f ? -1.0f : 1.0f;
+		cosAngle *= sign;
+		//Nearly parallel: sin(angle) is too small to divide by and the arc is close to a line
+		if (cosAngle > 0.9995f) {
+			return Nlerp(a, b, t);
+		}
+		const float angle = acosf(cosAngle);
+		const float invSin = 1.0f / sinf(angle);
+		const float ta = sinf((1.0f - t) * angle) * invSin;
+		const float tb = sinf(t * angle) * invSin * sign;
+		return Quat(a.x * ta + b.x * tb, a.y * ta + b.y * tb, a.z * ta + b.z * tb, a.w * ta + b.w * tb);
+	}
+
+	//Rotation matrix of a unit quaternion
+	constexpr Mat4 ToMat4(const Quat& q) {
+		const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+		const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+		const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+		return Mat4(
+			1.0f - 2.0f * (yy + zz), 2.0f * (xy - wz), 2.0f * (xz + wy), 0.0f,
+			2.0f * (xy + wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz - wx), 0.0f,
+			2.0f * (xz - wy), 2.0f * (yz + wx), 1.0f - 2.0f * (xx + yy), 0.0f,
+			0.0f, 0.0f, 0.0f, 1.0f
+		);
+	}
+
+	//Translate(t) * ToMat4(r) * Scale(s), written directly
+	constexpr Mat4 TRS(const Vec3& t, const Quat& r, const Vec3& s) {
+		const float xx = r.x * r.x, yy = r.y * r.y, zz = r.z * r.z;
+		const float xy = r.x * r.y, xz = r.x * r.z, yz = r.y * r.z;
+		const float wx = r.w * r.x, wy = r.w * r.y, wz = r.w * r.z;
+		return Mat4(
+			(1.0f - 2.0f * (yy + zz)) * s.x, 2.0f * (xy - wz) * s.y, 2.0f * (xz + wy) * s.z, t.x,
+			2.0f * (xy + wz) * s.x, (1.0f - 2.0f * (xx + zz)) * s.y, 2.0f * (yz - wx) * s.z, t.y,
+			2.0f * (xz - wy) * s.x, 2.0f * (yz + wx) * s.y, (1.0f - 2.0f * (xx + yy)) * s.z, t.z,
+			0.0f, 0.0f, 0.0f, 1.0f
+		);
+	}
+
+	//Inverse of TRS(t, r, s): Scale(1 / s) * transpose(ToMat4(r)) * Translate(-t), written directly
+	inline Mat4 InverseTRS(const Vec3& t, const Quat& r, const Vec3& s) {
+		const Mat4 rotation = ToMat4(r);
+		const Vec3 invScale(1.0f / s.x, 1.0f / s.y, 1.0f / s.z);
+		//Rows of the inverse rotation are the columns of the rotation
+		const Vec3 row0 = rotation[0].toVec3() * invScale.x;
+		const Vec3 row1 = rotation[1].toVec3() * invScale.y;
+		const Vec3 row2 = rotation[2].toVec3() * invScale.z;
+		return Mat4(
+			row0.x, row0.y, row0.z, -Dot(row0, t),
+			row1.x, row1.y, row1.z, -Dot(row1, t),
+			row2.x, row2.y, row2.z, -Dot(row2, t),
+			0.0f, 0.0f, 0.0f, 1.0f
+		);
+	}
+}
@@ -0,0 +1,204 @@
+#include "rng.h"
+#include "ewMath.h"
+#include "fastMath.h"
+#include "simdLanes.h"
+#include <atomic>
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EW_RNG_SSE
+#endif
+
+static inline uint32_t rotateLeft(uint32_t x, int k) {
+	return (x << k) | (x >> (32 - k));
+}
+
+namespace ew {
+	Rng::Rng(uint64_t seed, uint64_t stream)
+	{
+		//Seeding procedure of the PCG reference implementation, so nextUInt matches its pcg32
+		m_increment = (stream << 1) | 1;
+		nextUInt();
+		m_state += seed;
+		nextUInt();
+		//The xoshiro generators are seeded by SplitMix64 from the same seed and stream
+		uint64_t splitMix = seed ^ (stream * 0xd1b54a32d192ed03ull);
+		for (int generator = 0; generator < 4; generator++)
+		{
+			for (int word = 0; word < 4; word += 2)
+			{
+				splitMix += 0x9e3779b97f4a7c15ull;
+				uint64_t z = splitMix;
+				z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+				z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+				z = z ^ (z >> 31);
+				m_lanes[word][generator] = (uint32_t)z;
+				m_lanes[word + 1][generator] = (uint32_t)(z >> 32);
+			}
+			//xoshiro never leaves the all zero state
+			if ((m_lanes[0][generator] | m_lanes[1][generator] | m_lanes[2][generator] | m_lanes[3][generator]) == 0) {
+				m_lanes[0][generator] = 1;
+			}
+		}
+	}
+
+	/// <summary>
+	/// Lemire's multiply and reject method. Rejection only happens for the (2^32 mod bound) lowest products
+	/// </summary>
+	uint32_t Rng::nextUInt(uint32_t bound)
+	{
+		uint64_t product = (uint64_t)nextUInt() * bound;
+		uint32_t low = (uint32_t)product;
+		if (low < bound) {
+			const uint32_t threshold = (0u - bound) % bound;
+			while (low < threshold) {
+				product = (uint64_t)nextUInt() * bound;
+				low = (uint32_t)product;
+			}
+		}
+		return (uint32_t)(product >> 32);
+	}
+
+	Vec3 Rng::onUnitSphere()
+	{
+		//Uniform height and angle around the axis is uniform over the sphere (Archimedes)
+		const float z = range(-1.0f, 1.0f);
+		float s, c;
+		SinCos(nextFloat() * TAU, s, c);
+		const float r = sqrtf(fmaxf(0.0f, 1.0f - z * z));
+		return Vec3(r * c, r * s, z);
+	}
+
+	Vec3 Rng::onHemisphere(const Vec3& normal)
+	{
+		const Vec3 v = onUnitSphere();
+		return Dot(v, normal) < 0.0f ? -v : v;
+	}
+
+	/// <summary>
+	/// Advances the 4 xoshiro128+ generators once, writing one value from each
+	/// </summary>
+	void Rng::nextLanes(uint32_t out[4])
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			uint32_t& s0 = m_lanes[0][i], & s1 = m_lanes[1][i], & s2 = m_lanes[2][i], & s3 = m_lanes[3][i];
+			out[i] = s0 + s3;
+			const uint32_t t = s1 << 9;
+			s2 ^= s0;
+			s3 ^= s1;
+			s1 ^= s2;
+			s0 ^= s3;
+			s2 ^= t;
+			s3 = rotateLeft(s3, 11);
+		}
+	}
+
+	/// <summary>
+	/// Fills out with uniform floats in [min, max). Values are taken 4 at a time, one from each generator,
+	/// so the SSE and scalar paths produce the same sequence. A partial last group discards its extra values.
+	/// </summary>
+	void Rng::fillFloats(float* out, size_t count, float min, float max)
+	{
+		const float scale = (max - min) * (1.0f / 16777216.0f);
+		size_t i = 0;
+#if defined(EW_RNG_SSE)
+		__m128i s0 = _mm_load_si128(reinterpret_cast<const __m128i*>(m_lanes[0]));
+		__m128i s1 = _mm_load_si128(reinterpret_cast<const __m128i*>(m_lanes[1]));
+		__m128i s2 = _mm_load_si128(reinterpret_cast<const __m128i*>(m_lanes[2]));
+		__m128i s3 = _mm_load_si128(reinterpret_cast<const __m128i*>(m_lanes[3]));
+		const __m128 scale4 = _mm_set1_ps(scale);
+		const __m128 min4 = _mm_set1_ps(min);
+		for (; i + 4 <= count; i += 4)
+		{
+			//Top 24 bits, which convert to float exactly
+			const __m128i bits = _mm_srli_epi32(_mm_add_epi32(s0, s3), 8);
+			const __m128i t = _mm_slli_epi32(s1, 9);
+			s2 = _mm_xor_si128(s2, s0);
+			s3 = _mm_xor_si128(s3, s1);
+			s1 = _mm_xor_si128(s1, s2);
+			s0 = _mm_xor_si128(s0, s3);
+			s2 = _mm_xor_si128(s2, t);
+			s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+			_mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(bits), scale4), min4));
+		}
+		_mm_store_si128(reinterpret_cast<__m128i*>(m_lanes[0]), s0);
+		_mm_store_si128(reinterpret_cast<__m128i*>(m_lanes[1]), s1);
+		_mm_store_si128(reinterpret_cast<__m128i*>(m_lanes[2]), s2);
+		_mm_store_si128(reinterpret_cast<__m128i*>(m_lanes[3]), s3);
+#endif
+		uint32_t bits[4];
+		for (; i < count; i += 4)
+		{
+			nextLanes(bits);
+			for (size_t j = 0; j < 4 && i + j < count; j++)
+			{
+				out[i + j] = (float)(bits[j] >> 8) * scale + min;
+			}
+		}
+	}
+
+	void Rng::fillUnitSphere(size_t count, Vec3Stream& out)
+	{
+		out.resize(count);
+		std::vector<float> angles(count);
+		fillFloats(out.z.data(), count, -1.0f, 1.0f);
+		fillFloats(angles.data(), count, 0.0f, TAU);
+		SinCos(angles.data(), out.y.data(), out.x.data(), count);
+		//Scale the unit circle by the radius at each height, sqrt(1 - z^2)
+		float* x = out.x.data(), * y = out.y.data();
+		const float* z = out.z.data();
+		size_t i = 0;
+#if defined(EW_SIMD_LANES)
+		const simd::Lanes one = simd::splat(1.0f);
+		for (; i + simd::LANE_COUNT <= count; i += simd::LANE_COUNT)
+		{
+			const simd::Lanes vz = simd::load(z + i);
+			const simd::Lanes r = simd::squareRoot(simd::sub(one, simd::mul(vz, vz)));
+			simd::store(x + i, simd::mul(simd::load(x + i), r));
+			simd::store(y + i, simd::mul(simd::load(y + i), r));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			const float r = sqrtf(1.0f - z[i] * z[i]);
+			x[i] *= r;
+			y[i] *= r;
+		}
+	}
+
+	void Rng::fillHemisphere(const Vec3& normal, size_t count, Vec3Stream& out)
+	{
+		fillUnitSphere(count, out);
+		//Mirror the samples below the plane of the normal
+		float* x = out.x.data(), * y = out.y.data(), * z = out.z.data();
+		size_t i = 0;
+#if defined(EW_SIMD_LANES)
+		const simd::Lanes nx = simd::splat(normal.x), ny = simd::splat(normal.y), nz = simd::splat(normal.z);
+		const simd::Lanes signMask = simd::splat(-0.0f);
+		for (; i + simd::LANE_COUNT <= count; i += simd::LANE_COUNT)
+		{
+			const simd::Lanes vx = simd::load(x + i), vy = simd::load(y + i), vz = simd::load(z + i);
+			const simd::Lanes sign = simd::bitAnd(simd::mulAdd(vz, nz, simd::mulAdd(vy, ny, simd::mul(vx, nx))), signMask);
+			simd::store(x + i, simd::bitXor(vx, sign));
+			simd::store(y + i, simd::bitXor(vy, sign));
+			simd::store(z + i, simd::bitXor(vz, sign));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			const float flip = x[i] * normal.x + y[i] * normal.y + z[i] * normal.z < 0.0f ? -1.0f : 1.0f;
+			x[i] *= flip;
+			y[i] *= flip;
+			z[i] *= flip;
+		}
+	}
+
+	Rng& ThreadRng()
+	{
+		static std::atomic<uint64_t> nextStream(0);
+		thread_local Rng rng(0x853c49e6748fea9bull, nextStream++);
+		return rng;
+	}
+}
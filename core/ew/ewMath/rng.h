@@ -0,0 +1,49 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "vec3.h"
+#include "vec3Stream.h"
+
+namespace ew {
+	//Seedable random number generator. The same seed and stream give the same random bits on every platform.
+	//Single values come from PCG32. The bulk fills run 4 interleaved xoshiro128+ generators, which SSE advances together.
+	//Not thread safe: give each thread or job its own Rng, or use ThreadRng()
+	class Rng {
+	public:
+		//Rngs with the same seed and different streams give independent sequences, e.g. one stream per emitter or job
+		explicit Rng(uint64_t seed = 0x853c49e6748fea9bull, uint64_t stream = 0);
+
+		inline uint32_t nextUInt() {
+			const uint64_t old = m_state;
+			m_state = old * 6364136223846793005ull + m_increment;
+			const uint32_t xorShifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+			const uint32_t rotation = (uint32_t)(old >> 59);
+			return (xorShifted >> rotation) | (xorShifted << ((0u - rotation) & 31));
+		}
+		//[0, bound) without modulo bias
+		uint32_t nextUInt(uint32_t bound);
+		//[0, 1), 24 bits of precision
+		inline float nextFloat() { return (nextUInt() >> 8) * (1.0f / 16777216.0f); }
+		//[min, max)
+		inline float range(float min, float max) { return min + (max - min) * nextFloat(); }
+		//Uniformly distributed unit vectors
+		Vec3 onUnitSphere();
+		//Uniformly distributed unit vectors with Dot(v, normal) >= 0
+		Vec3 onHemisphere(const Vec3& normal);
+
+		//Bulk versions of the above. They draw from the xoshiro generators only, so mixing them with single
+		//value calls doesn't change either sequence
+		void fillFloats(float* out, size_t count, float min = 0.0f, float max = 1.0f);
+		void fillUnitSphere(size_t count, Vec3Stream& out);
+		void fillHemisphere(const Vec3& normal, size_t count, Vec3Stream& out);
+	private:
+		void nextLanes(uint32_t out[4]);
+		uint64_t m_state = 0;
+		uint64_t m_increment = 0;
+		alignas(16) uint32_t m_lanes[4][4]; //xoshiro128+ state word, then generator
+	};
+
+	//Generator of the calling thread, created on first use with the default seed. Every thread gets its own stream,
+	//numbered in the order threads first call this. For results that must not depend on thread timing, use explicit streams
+	Rng& ThreadRng();
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <math.h>
+#include <stddef.h>
+
+//Shared by the SIMD kernels in ewMath and core .cpp files (bulk math, culling, picking, occlusion). Not part of the public math API.
+//AVX is only used when the compiler targets it (e.g. -mavx or /arch:AVX), and FMA when it targets that too.
+//SSE is part of every x86-64 target. Other targets only get the float overloads, so kernels fall back to their scalar loops.
+#if defined(__AVX__)
+#include <immintrin.h>
+#define EW_SIMD_LANES_AVX
+#define EW_SIMD_LANES
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EW_SIMD_LANES_SSE
+#define EW_SIMD_LANES
+#endif
+
+namespace ew {
+	//Kernels are written once against these overloads. The SIMD loop calls them with a register of
+	//LANE_COUNT floats, then the remainder calls them with single floats.
+	namespace simd {
+		inline float broadcast(float s, float) { return s; }
+		inline float add(float a, float b) { return a + b; }
+		inline float sub(float a, float b) { return a - b; }
+		inline float mul(float a, float b) { return a * b; }
+		inline float div(float a, float b) { return a / b; }
+		inline float mulAdd(float a, float b, float c) { return a * b + c; }
+		inline float minimum(float a, float b) { return a < b ? a : b; }
+		inline float maximum(float a, float b) { return a > b ? a : b; }
+		inline float squareRoot(float a) { return sqrtf(a); }
+		inline float rsqrt(float a) { return 1.0f / sqrtf(a); }
+		inline float selectPositive(float condition, float a, float b) { return condition > 0.0f ? a : b; }
+
+#if defined(EW_SIMD_LANES_AVX)
+		typedef __m256 Lanes;
+		const size_t LANE_COUNT = 8;
+		inline Lanes load(const float* p) { return _mm256_loadu_ps(p); }
+		inline void store(float* p, Lanes v) { _mm256_storeu_ps(p, v); }
+		inline Lanes broadcast(float s, Lanes) { return _mm256_set1_ps(s); }
+		inline Lanes splat(float s) { return _mm256_set1_ps(s); }
+		inline Lanes ramp(float start) { return _mm256_setr_ps(start, start + 1.0f, start + 2.0f, start + 3.0f, start + 4.0f, start + 5.0f, start + 6.0f, start + 7.0f); } //start + lane
+		inline Lanes add(Lanes a, Lanes b) { return _mm256_add_ps(a, b); }
+		inline Lanes sub(Lanes a, Lanes b) { return _mm256_sub_ps(a, b); }
+		inline Lanes mul(Lanes a, Lanes b) { return _mm256_mul_ps(a, b); }
+		inline Lanes div(Lanes a, Lanes b) { return _mm256_div_ps(a, b); }
+#if defined(__FMA__)
+		inline Lanes mulAdd(Lanes a, Lanes b, Lanes c) { return _mm256_fmadd_ps(a, b, c); }
+#else
+		inline Lanes mulAdd(Lanes a, Lanes b, Lanes c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+#endif
+		inline Lanes minimum(Lanes a, Lanes b) { return _mm256_min_ps(a, b); }
+		inline Lanes maximum(Lanes a, Lanes b) { return _mm256_max_ps(a, b); }
+		inline Lanes squareRoot(Lanes a) { return _mm256_sqrt_ps(a); }
+		//Rounds toward zero. Inputs must fit in an int
+		inline Lanes truncate(Lanes a) { return _mm256_cvtepi32_ps(_mm256_cvttps_epi32(a)); }
+		inline Lanes bitAnd(Lanes a, Lanes b) { return _mm256_and_ps(a, b); }
+		inline Lanes bitOr(Lanes a, Lanes b) { return _mm256_or_ps(a, b); }
+		inline Lanes bitAndNot(Lanes a, Lanes b) { return _mm256_andnot_ps(a, b); } //~a & b
+		inline Lanes bitXor(Lanes a, Lanes b) { return _mm256_xor_ps(a, b); }
+		//All bits set where the comparison holds
+		inline Lanes equal(Lanes a, Lanes b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+		inline Lanes less(Lanes a, Lanes b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+		inline Lanes lessEqual(Lanes a, Lanes b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); } //False for NaN
+		inline Lanes greaterEqual(Lanes a, Lanes b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+		inline int laneBits(Lanes mask) { return _mm256_movemask_ps(mask); } //Bit i set where lane i of the mask is
+		inline bool allTrue(Lanes mask) { return _mm256_movemask_ps(mask) == 0xFF; }
+		inline Lanes select(Lanes mask, Lanes a, Lanes b) { return _mm256_blendv_ps(b, a, mask); } //mask ? a : b
+		//12 bit estimate refined by one Newton step: y * (1.5 - 0.5 * a * y * y)
+		inline Lanes rsqrt(Lanes a) {
+			const Lanes y = _mm256_rsqrt_ps(a);
+			const Lanes halfAYY = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), a), _mm256_mul_ps(y, y));
+			return _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), halfAYY));
+		}
+		inline Lanes selectPositive(Lanes condition, Lanes a, Lanes b) {
+			return _mm256_blendv_ps(b, a, _mm256_cmp_ps(condition, _mm256_setzero_ps(), _CMP_GT_OQ));
+		}
+#elif defined(EW_SIMD_LANES_SSE)
+		typedef __m128 Lanes;
+		const size_t LANE_COUNT = 4;
+		inline Lanes load(const float* p) { return _mm_loadu_ps(p); }
+		inline void store(float* p, Lanes v) { _mm_storeu_ps(p, v); }
+		inline Lanes broadcast(float s, Lanes) { return _mm_set1_ps(s); }
+		inline Lanes splat(float s) { return _mm_set1_ps(s); }
+		inline Lanes ramp(float start) { return _mm_setr_ps(start, start + 1.0f, start + 2.0f, start + 3.0f); } //start + lane
+		inline Lanes add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+		inline Lanes sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+		inline Lanes mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+		inline Lanes div(Lanes a, Lanes b) { return _mm_div_ps(a, b); }
+		inline Lanes mulAdd(Lanes a, Lanes b, Lanes c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+		inline Lanes minimum(Lanes a, Lanes b) { return _mm_min_ps(a, b); }
+		inline Lanes maximum(Lanes a, Lanes b) { return _mm_max_ps(a, b); }
+		inline Lanes squareRoot(Lanes a) { return _mm_sqrt_ps(a); }
+		//Rounds toward zero. Inputs must fit in an int
+		inline Lanes truncate(Lanes a) { return _mm_cvtepi32_ps(_mm_cvttps_epi32(a)); }
+		inline Lanes bitAnd(Lanes a, Lanes b) { return _mm_and_ps(a, b); }
+		inline Lanes bitOr(Lanes a, Lanes b) { return _mm_or_ps(a, b); }
+		inline Lanes bitAndNot(Lanes a, Lanes b) { return _mm_andnot_ps(a, b); } //~a & b
+		inline Lanes bitXor(Lanes a, Lanes b) { return _mm_xor_ps(a, b); }
+		//All bits set where the comparison holds
+		inline Lanes equal(Lanes a, Lanes b) { return _mm_cmpeq_ps(a, b); }
+		inline Lanes less(Lanes a, Lanes b) { return _mm_cmplt_ps(a, b); }
+		inline Lanes lessEqual(Lanes a, Lanes b) { return _mm_cmple_ps(a, b); } //False for NaN
+		inline Lanes greaterEqual(Lanes a, Lanes b) { return _mm_cmpge_ps(a, b); }
+		inline int laneBits(Lanes mask) { return _mm_movemask_ps(mask); } //Bit i set where lane i of the mask is
+		inline bool allTrue(Lanes mask) { return _mm_movemask_ps(mask) == 0xF; }
+		inline Lanes select(Lanes mask, Lanes a, Lanes b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); } //mask ? a : b
+		//12 bit estimate refined by one Newton step: y * (1.5 - 0.5 * a * y * y)
+		inline Lanes rsqrt(Lanes a) {
+			const Lanes y = _mm_rsqrt_ps(a);
+			const Lanes halfAYY = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), a), _mm_mul_ps(y, y));
+			return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), halfAYY));
+		}
+		inline Lanes selectPositive(Lanes condition, Lanes a, Lanes b) {
+			return select(_mm_cmpgt_ps(condition, _mm_setzero_ps()), a, b);
+		}
+#endif
+	}
+}
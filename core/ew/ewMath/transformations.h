@@ -5,10 +5,11 @@
 #pragma once
 #include "mat4.h"
 #include "vec3.h"
+#include "fastMath.h"
 
 namespace ew {
 	//Identity matrix
-	inline ew::Mat4 Identity() {
+	constexpr ew::Mat4 Identity() {
 		return ew::Mat4(
 			1, 0, 0, 0,
 			0, 1, 0, 0,
@@ -17,7 +18,7 @@ namespace ew {
 		);
 	};
 	//Scale on x,y,z axes
-	inline ew::Mat4 Scale(const ew::Vec3& s) {
+	constexpr ew::Mat4 Scale(const ew::Vec3& s) {
 		return ew::Mat4(
 			s.x, 0, 0, 0,
 			0, s.y, 0, 0,
@@ -26,9 +27,9 @@ namespace ew {
 		);
 	};
 	//Rotation around X axis (pitch) in radians
-	inline ew::Mat4 RotateX(float rad) {
-		const float cosA = cosf(rad);
-		const float sinA = sinf(rad);
+	EW_CONSTEXPR_MATH ew::Mat4 RotateX(float rad) {
+		float sinA = 0.0f, cosA = 0.0f;
+		ew::SinCos(rad, sinA, cosA);
 		return Mat4(
 			1.0f, 0.0f, 0.0f, 0.0f,
 			0.0f, cosA, -sinA, 0.0f,
@@ -37,9 +38,9 @@ namespace ew {
 		);
 	};
 	//Rotation around Y axis (yaw) in radians
-	inline ew::Mat4 RotateY(float rad) {
-		const float cosA = cosf(rad);
-		const float sinA = sinf(rad);
+	EW_CONSTEXPR_MATH ew::Mat4 RotateY(float rad) {
+		float sinA = 0.0f, cosA = 0.0f;
+		ew::SinCos(rad, sinA, cosA);
 		return Mat4(
 			cosA, 0.0f, sinA, 0.0f,
 			0.0f, 1.0f, 0.0f, 0.0f,
@@ -48,9 +49,9 @@ namespace ew {
 		);
 	};
 	//Rotation around Z axis (roll) in radians
-	inline ew::Mat4 RotateZ(float rad) {
-		const float cosA = cosf(rad);
-		const float sinA = sinf(rad);
+	EW_CONSTEXPR_MATH ew::Mat4 RotateZ(float rad) {
+		float sinA = 0.0f, cosA = 0.0f;
+		ew::SinCos(rad, sinA, cosA);
 		return Mat4(
 			cosA, -sinA, 0.0f, 0.0f,
 			sinA, cosA, 0.0f, 0.0f,
@@ -59,7 +60,7 @@ namespace ew {
 		);
 	};
 	//Translate x,y,z
-	inline ew::Mat4 Translate(const ew::Vec3& t) {
+	constexpr ew::Mat4 Translate(const ew::Vec3& t) {
 		return Mat4(
 			1.0f, 0.0f, 0.0f, t.x,
 			0.0f, 1.0f, 0.0f, t.y,
@@ -68,7 +69,7 @@ namespace ew {
 		);
 	};
 
-	inline ew::Mat4 LookAt(const ew::Vec3& eyePos, const ew::Vec3& targetPos, const ew::Vec3& up) {
+	EW_CONSTEXPR_MATH ew::Mat4 LookAt(const ew::Vec3& eyePos, const ew::Vec3& targetPos, const ew::Vec3& up) {
 		ew::Vec3 f = ew::Normalize(eyePos - targetPos);
 		ew::Vec3 r = ew::Normalize(ew::Cross(up, f));
 		ew::Vec3 u = ew::Normalize(ew::Cross(f,r));
@@ -80,32 +81,28 @@ namespace ew {
 		return m;
 	}
 
-	inline ew::Mat4 Perspective(float fov, float a, float n, float f) {
-		float c = tanf(fov / 2.0f);
-		Mat4 m = Mat4(0);
-		m[0][0] = 1.0f / (c * a); //Scale X
-		m[1][1] = 1.0f / c; //Scale Y
-		m[2][2] = (f + n) / (n-f); //Scale Z
-		m[3][2] = (2 * f * n) / (n-f); //Translate Z
-		m[2][3] = -1.0f; //Perspective divide (puts Z in W component of vector)
-		return m;
+	EW_CONSTEXPR_MATH ew::Mat4 Perspective(float fov, float a, float n, float f) {
+		const float c = ew::Tan(fov / 2.0f);
+		return Mat4(
+			1.0f / (c * a), 0.0f, 0.0f, 0.0f, //Scale X
+			0.0f, 1.0f / c, 0.0f, 0.0f, //Scale Y
+			0.0f, 0.0f, (f + n) / (n - f), (2 * f * n) / (n - f), //Scale Z, translate Z
+			0.0f, 0.0f, -1.0f, 0.0f //Perspective divide (puts Z in W component of vector)
+		);
 	}
 
-	inline ew::Mat4 Orthographic(float height, float a, float n, float f) {
+	constexpr ew::Mat4 Orthographic(float height, float a, float n, float f) {
 		//Symmetrical bounds based on aspect ratio
-		float t = height / 2;
-		float b = -t;
-		float r = (height * a) / 2;
-		float l = -r;
+		const float t = height / 2;
+		const float b = -t;
+		const float r = (height * a) / 2;
+		const float l = -r;
 
-		Mat4 m = Mat4(0);
-		m[0][0] = 2 / (r - l);
-		m[1][1] = 2 / (t - b);
-		m[2][2] = -2 / (f - n);
-		m[3][0] = -(r + l) / (r - l);
-		m[3][1] = -(t + b) / (t - b);
-		m[3][2] = -(f + n) / (f - n);
-		m[3][3] = 1.0f;
-		return m;
+		return Mat4(
+			2 / (r - l), 0.0f, 0.0f, -(r + l) / (r - l),
+			0.0f, 2 / (t - b), 0.0f, -(t + b) / (t - b),
+			0.0f, 0.0f, -2 / (f - n), -(f + n) / (f - n),
+			0.0f, 0.0f, 0.0f, 1.0f
+		);
 	}
 }
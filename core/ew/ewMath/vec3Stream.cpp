@@ -0,0 +1,232 @@
+#include "vec3Stream.h"
+
+#include "simdLanes.h"
+
+using namespace ew::simd;
+
+/// <summary>
+/// Runs op on the x arrays, then the y arrays, then the z arrays of the inputs.
+/// op takes three values of the same type (Lanes or float) and returns that type. Unused inputs can be any stream of the same size.
+/// </summary>
+template<typename Op>
+static void perComponent(const ew::Vec3Stream& a, const ew::Vec3Stream& b, const ew::Vec3Stream& c, ew::Vec3Stream& out, Op op)
+{
+	const size_t count = a.size();
+	out.resize(count);
+	const float* as[3] = { a.x.data(), a.y.data(), a.z.data() };
+	const float* bs[3] = { b.x.data(), b.y.data(), b.z.data() };
+	const float* cs[3] = { c.x.data(), c.y.data(), c.z.data() };
+	float* outs[3] = { out.x.data(), out.y.data(), out.z.data() };
+	for (int component = 0; component < 3; component++)
+	{
+		const float* pa = as[component];
+		const float* pb = bs[component];
+		const float* pc = cs[component];
+		float* pOut = outs[component];
+		size_t i = 0;
+#if defined(EW_SIMD_LANES)
+		for (; i + LANE_COUNT <= count; i += LANE_COUNT)
+		{
+			store(pOut + i, op(load(pa + i), load(pb + i), load(pc + i)));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			pOut[i] = op(pa[i], pb[i], pc[i]);
+		}
+	}
+}
+
+namespace ew {
+	Vec3Stream::Vec3Stream(const std::vector<Vec3>& vectors)
+	{
+		Gather(vectors.empty() ? nullptr : &vectors[0].x, vectors.size(), sizeof(Vec3), *this);
+	}
+	void Vec3Stream::resize(size_t count)
+	{
+		x.resize(count);
+		y.resize(count);
+		z.resize(count);
+	}
+	void Vec3Stream::reserve(size_t count)
+	{
+		x.reserve(count);
+		y.reserve(count);
+		z.reserve(count);
+	}
+	void Vec3Stream::clear()
+	{
+		x.clear();
+		y.clear();
+		z.clear();
+	}
+	void Vec3Stream::push_back(const Vec3& v)
+	{
+		x.push_back(v.x);
+		y.push_back(v.y);
+		z.push_back(v.z);
+	}
+	std::vector<Vec3> Vec3Stream::toVector() const
+	{
+		std::vector<Vec3> vectors(size());
+		Scatter(*this, vectors.empty() ? nullptr : &vectors[0].x, sizeof(Vec3));
+		return vectors;
+	}
+
+	void Add(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out)
+	{
+		perComponent(a, b, a, out, [](auto va, auto vb, auto) { return add(va, vb); });
+	}
+	void Sub(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out)
+	{
+		perComponent(a, b, a, out, [](auto va, auto vb, auto) { return sub(va, vb); });
+	}
+	void Mul(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out)
+	{
+		perComponent(a, b, a, out, [](auto va, auto vb, auto) { return mul(va, vb); });
+	}
+	void Mul(const Vec3Stream& a, float s, Vec3Stream& out)
+	{
+		perComponent(a, a, a, out, [s](auto va, auto, auto) { return mul(va, broadcast(s, va)); });
+	}
+	void MulAdd(const Vec3Stream& a, const Vec3Stream& b, const Vec3Stream& c, Vec3Stream& out)
+	{
+		perComponent(a, b, c, out, [](auto va, auto vb, auto vc) { return mulAdd(va, vb, vc); });
+	}
+	void MulAdd(const Vec3Stream& a, float s, const Vec3Stream& b, Vec3Stream& out)
+	{
+		perComponent(a, b, a, out, [s](auto va, auto vb, auto) { return mulAdd(va, broadcast(s, va), vb); });
+	}
+	void Lerp(const Vec3Stream& a, const Vec3Stream& b, float t, Vec3Stream& out)
+	{
+		perComponent(a, b, a, out, [t](auto va, auto vb, auto) { return mulAdd(sub(vb, va), broadcast(t, va), va); });
+	}
+	void Clamp(const Vec3Stream& a, float min, float max, Vec3Stream& out)
+	{
+		perComponent(a, a, a, out, [min, max](auto va, auto, auto) { return maximum(minimum(va, broadcast(max, va)), broadcast(min, va)); });
+	}
+
+	void Dot(const Vec3Stream& a, const Vec3Stream& b, std::vector<float>& out)
+	{
+		const size_t count = a.size();
+		out.resize(count);
+		const float* ax = a.x.data(), * ay = a.y.data(), * az = a.z.data();
+		const float* bx = b.x.data(), * by = b.y.data(), * bz = b.z.data();
+		float* o = out.data();
+		size_t i = 0;
+#if defined(EW_SIMD_LANES)
+		for (; i + LANE_COUNT <= count; i += LANE_COUNT)
+		{
+			store(o + i, mulAdd(load(az + i), load(bz + i), mulAdd(load(ay + i), load(by + i), mul(load(ax + i), load(bx + i)))));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			o[i] = az[i] * bz[i] + (ay[i] * by[i] + ax[i] * bx[i]);
+		}
+	}
+
+	void Cross(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out)
+	{
+		const size_t count = a.size();
+		out.resize(count);
+		const float* ax = a.x.data(), * ay = a.y.data(), * az = a.z.data();
+		const float* bx = b.x.data(), * by = b.y.data(), * bz = b.z.data();
+		float* ox = out.x.data(), * oy = out.y.data(), * oz = out.z.data();
+		size_t i = 0;
+#if defined(EW_SIMD_LANES)
+		for (; i + LANE_COUNT <= count; i += LANE_COUNT)
+		{
+			//All inputs are loaded before storing, so out can be a or b
+			const Lanes vax = load(ax + i), vay = load(ay + i), vaz = load(az + i);
+			const Lanes vbx = load(bx + i), vby = load(by + i), vbz = load(bz + i);
+			store(ox + i, sub(mul(vay, vbz), mul(vaz, vby)));
+			store(oy + i, sub(mul(vaz, vbx), mul(vax, vbz)));
+			store(oz + i, sub(mul(vax, vby), mul(vay, vbx)));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			const float cx = ay[i] * bz[i] - az[i] * by[i];
+			const float cy = az[i] * bx[i] - ax[i] * bz[i];
+			const float cz = ax[i] * by[i] - ay[i] * bx[i];
+			ox[i] = cx;
+			oy[i] = cy;
+			oz[i] = cz;
+		}
+	}
+
+	void Normalize(const Vec3Stream& a, Vec3Stream& out)
+	{
+		const size_t count = a.size();
+		out.resize(count);
+		const float* ax = a.x.data(), * ay = a.y.data(), * az = a.z.data();
+		float* ox = out.x.data(), * oy = out.y.data(), * oz = out.z.data();
+		size_t i = 0;
+#if defined(EW_SIMD_LANES)
+		for (; i + LANE_COUNT <= count; i += LANE_COUNT)
+		{
+			const Lanes x = load(ax + i), y = load(ay + i), z = load(az + i);
+			const Lanes sqrMagnitude = mulAdd(z, z, mulAdd(y, y, mul(x, x)));
+			//rsqrt(0) is infinite, so zero vectors are passed through by the select
+			const Lanes invMagnitude = rsqrt(sqrMagnitude);
+			store(ox + i, selectPositive(sqrMagnitude, mul(x, invMagnitude), x));
+			store(oy + i, selectPositive(sqrMagnitude, mul(y, invMagnitude), y));
+			store(oz + i, selectPositive(sqrMagnitude, mul(z, invMagnitude), z));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			const Vec3 v = ew::Normalize(Vec3(ax[i], ay[i], az[i]));
+			ox[i] = v.x;
+			oy[i] = v.y;
+			oz[i] = v.z;
+		}
+	}
+
+	void Gather(const float* first, size_t count, size_t strideBytes, Vec3Stream& out)
+	{
+		out.resize(count);
+		const char* base = reinterpret_cast<const char*>(first);
+		float* ox = out.x.data(), * oy = out.y.data(), * oz = out.z.data();
+		size_t i = 0;
+#if defined(EW_SIMD_LANES)
+		//Loads 4 floats per element and transposes 4 elements at a time. The fourth float belongs to the
+		//next element at the latest, so the last element is always left to the scalar loop
+		if (strideBytes >= sizeof(Vec3)) {
+			for (; i + 4 < count; i += 4)
+			{
+				__m128 r0 = _mm_loadu_ps(reinterpret_cast<const float*>(base + (i + 0) * strideBytes));
+				__m128 r1 = _mm_loadu_ps(reinterpret_cast<const float*>(base + (i + 1) * strideBytes));
+				__m128 r2 = _mm_loadu_ps(reinterpret_cast<const float*>(base + (i + 2) * strideBytes));
+				__m128 r3 = _mm_loadu_ps(reinterpret_cast<const float*>(base + (i + 3) * strideBytes));
+				_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+				_mm_storeu_ps(ox + i, r0);
+				_mm_storeu_ps(oy + i, r1);
+				_mm_storeu_ps(oz + i, r2);
+			}
+		}
+#endif
+		for (; i < count; i++)
+		{
+			const float* v = reinterpret_cast<const float*>(base + i * strideBytes);
+			ox[i] = v[0];
+			oy[i] = v[1];
+			oz[i] = v[2];
+		}
+	}
+
+	void Scatter(const Vec3Stream& in, float* first, size_t strideBytes)
+	{
+		//Scalar, since wider stores would overwrite whatever follows z
+		char* base = reinterpret_cast<char*>(first);
+		const size_t count = in.size();
+		for (size_t i = 0; i < count; i++)
+		{
+			float* v = reinterpret_cast<float*>(base + i * strideBytes);
+			v[0] = in.x[i];
+			v[1] = in.y[i];
+			v[2] = in.z[i];
+		}
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <vector>
+#include <stddef.h>
+#include "vec3.h"
+
+namespace ew {
+	//Vec3s stored as separate x, y and z arrays (structure of arrays), so the bulk operations below
+	//process 4 (SSE) or 8 (AVX) vectors per instruction. Use for particles, vertices and other large batches
+	struct Vec3Stream {
+		std::vector<float> x, y, z;
+
+		Vec3Stream() {};
+		explicit Vec3Stream(size_t count) :x(count), y(count), z(count) {};
+		explicit Vec3Stream(const std::vector<Vec3>& vectors);
+
+		inline size_t size()const { return x.size(); }
+		inline Vec3 get(size_t i)const { return Vec3(x[i], y[i], z[i]); }
+		inline void set(size_t i, const Vec3& v) { x[i] = v.x; y[i] = v.y; z[i] = v.z; }
+		void resize(size_t count);
+		void reserve(size_t count);
+		void clear();
+		void push_back(const Vec3& v);
+		std::vector<Vec3> toVector()const;
+	};
+
+	//Bulk operations on equal sized streams. Outputs are resized to the input size and may be one of the inputs
+	void Add(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out);
+	void Sub(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out);
+	void Mul(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out); //Per component
+	void Mul(const Vec3Stream& a, float s, Vec3Stream& out);
+	void MulAdd(const Vec3Stream& a, const Vec3Stream& b, const Vec3Stream& c, Vec3Stream& out); //a * b + c per component
+	void MulAdd(const Vec3Stream& a, float s, const Vec3Stream& b, Vec3Stream& out); //a * s + b, e.g. position += velocity * dt
+	void Dot(const Vec3Stream& a, const Vec3Stream& b, std::vector<float>& out);
+	void Cross(const Vec3Stream& a, const Vec3Stream& b, Vec3Stream& out);
+	void Normalize(const Vec3Stream& a, Vec3Stream& out); //Approximate reciprocal square root refined by one Newton step. Zero vectors are unchanged
+	void Lerp(const Vec3Stream& a, const Vec3Stream& b, float t, Vec3Stream& out);
+	void Clamp(const Vec3Stream& a, float min, float max, Vec3Stream& out); //Per component
+
+	//Reads count Vec3s that are strideBytes apart, starting at first (e.g. &vertices[0].pos.x)
+	void Gather(const float* first, size_t count, size_t strideBytes, Vec3Stream& out);
+	//Writes the stream back to Vec3s that are strideBytes apart. Only x, y and z of each element are written
+	void Scatter(const Vec3Stream& in, float* first, size_t strideBytes);
+
+	//Conversions for any vertex struct with Vec3 pos and normal, e.g. ew::Vertex
+	template<typename VertexType>
+	inline void GatherPositions(const std::vector<VertexType>& vertices, Vec3Stream& out) {
+		Gather(vertices.empty() ? nullptr : &vertices[0].pos.x, vertices.size(), sizeof(VertexType), out);
+	}
+	template<typename VertexType>
+	inline void GatherNormals(const std::vector<VertexType>& vertices, Vec3Stream& out) {
+		Gather(vertices.empty() ? nullptr : &vertices[0].normal.x, vertices.size(), sizeof(VertexType), out);
+	}
+	//Grows vertices to the size of the stream if needed
+	template<typename VertexType>
+	inline void ScatterPositions(const Vec3Stream& in, std::vector<VertexType>& vertices) {
+		if (vertices.size() < in.size()) {
+			vertices.resize(in.size());
+		}
+		Scatter(in, vertices.empty() ? nullptr : &vertices[0].pos.x, sizeof(VertexType));
+	}
+	template<typename VertexType>
+	inline void ScatterNormals(const Vec3Stream& in, std::vector<VertexType>& vertices) {
+		if (vertices.size() < in.size()) {
+			vertices.resize(in.size());
+		}
+		Scatter(in, vertices.empty() ? nullptr : &vertices[0].normal.x, sizeof(VertexType));
+	}
+}
@@ -0,0 +1,152 @@
+#include "vec4x8.h"
+
+#include "simdLanes.h"
+
+using namespace ew::simd;
+
+static_assert(sizeof(ew::Vec4x8) == 4 * ew::Vec4x8::SIZE * sizeof(float), "Vec4x8 components must be contiguous");
+
+//Kernels step through each component array in groups, which divide a packet evenly
+#if defined(EW_SIMD_LANES)
+typedef Lanes Group;
+static const int GROUP_SIZE = (int)LANE_COUNT;
+static inline Group loadGroup(const float* p) { return load(p); }
+static inline void storeGroup(float* p, Group v) { store(p, v); }
+#else
+typedef float Group;
+static const int GROUP_SIZE = 1;
+static inline Group loadGroup(const float* p) { return *p; }
+static inline void storeGroup(float* p, Group v) { *p = v; }
+#endif
+
+static inline float* floats(std::vector<ew::Vec4x8>& packets) { return reinterpret_cast<float*>(packets.data()); }
+static inline const float* floats(const std::vector<ew::Vec4x8>& packets) { return reinterpret_cast<const float*>(packets.data()); }
+
+/// <summary>
+/// Runs op on every float of a and b. Components are independent, so the packets are treated as one flat array.
+/// op takes two Groups and returns a Group. Unused inputs can be any array of the same size.
+/// </summary>
+template<typename Op>
+static void perFloat(const std::vector<ew::Vec4x8>& a, const std::vector<ew::Vec4x8>& b, std::vector<ew::Vec4x8>& out, Op op)
+{
+	out.resize(a.size());
+	const size_t count = a.size() * 4 * ew::Vec4x8::SIZE;
+	const float* pa = floats(a);
+	const float* pb = floats(b);
+	float* pOut = floats(out);
+	for (size_t i = 0; i < count; i += GROUP_SIZE)
+	{
+		storeGroup(pOut + i, op(loadGroup(pa + i), loadGroup(pb + i)));
+	}
+}
+
+namespace ew {
+	void Pack(const std::vector<Vec4>& vectors, std::vector<Vec4x8>& out)
+	{
+		out.assign((vectors.size() + Vec4x8::SIZE - 1) / Vec4x8::SIZE, Vec4x8());
+		for (size_t i = 0; i < vectors.size(); i++)
+		{
+			out[i / Vec4x8::SIZE].set((int)(i % Vec4x8::SIZE), vectors[i]);
+		}
+	}
+	void Unpack(const std::vector<Vec4x8>& packets, size_t count, std::vector<Vec4>& out)
+	{
+		out.resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			out[i] = packets[i / Vec4x8::SIZE].get((int)(i % Vec4x8::SIZE));
+		}
+	}
+
+	void Add(const std::vector<Vec4x8>& a, const std::vector<Vec4x8>& b, std::vector<Vec4x8>& out)
+	{
+		perFloat(a, b, out, [](Group va, Group vb) { return add(va, vb); });
+	}
+	void Sub(const std::vector<Vec4x8>& a, const std::vector<Vec4x8>& b, std::vector<Vec4x8>& out)
+	{
+		perFloat(a, b, out, [](Group va, Group vb) { return sub(va, vb); });
+	}
+	void Mul(const std::vector<Vec4x8>& a, const std::vector<Vec4x8>& b, std::vector<Vec4x8>& out)
+	{
+		perFloat(a, b, out, [](Group va, Group vb) { return mul(va, vb); });
+	}
+	void Mul(const std::vector<Vec4x8>& a, float s, std::vector<Vec4x8>& out)
+	{
+		perFloat(a, a, out, [s](Group va, Group) { return mul(va, broadcast(s, va)); });
+	}
+	void MulAdd(const std::vector<Vec4x8>& a, float s, const std::vector<Vec4x8>& b, std::vector<Vec4x8>& out)
+	{
+		perFloat(a, b, out, [s](Group va, Group vb) { return mulAdd(va, broadcast(s, va), vb); });
+	}
+	void Lerp(const std::vector<Vec4x8>& a, const std::vector<Vec4x8>& b, float t, std::vector<Vec4x8>& out)
+	{
+		perFloat(a, b, out, [t](Group va, Group vb) { return mulAdd(sub(vb, va), broadcast(t, va), va); });
+	}
+	void Clamp(const std::vector<Vec4x8>& a, float min, float max, std::vector<Vec4x8>& out)
+	{
+		perFloat(a, a, out, [min, max](Group va, Group) { return maximum(minimum(va, broadcast(max, va)), broadcast(min, va)); });
+	}
+
+	void Dot(const std::vector<Vec4x8>& a, const std::vector<Vec4x8>& b, std::vector<float>& out)
+	{
+		out.resize(a.size() * Vec4x8::SIZE);
+		for (size_t p = 0; p < a.size(); p++)
+		{
+			const Vec4x8& pa = a[p];
+			const Vec4x8& pb = b[p];
+			for (int i = 0; i < Vec4x8::SIZE; i += GROUP_SIZE)
+			{
+				Group dot = mul(loadGroup(pa.x + i), loadGroup(pb.x + i));
+				dot = mulAdd(loadGroup(pa.y + i), loadGroup(pb.y + i), dot);
+				dot = mulAdd(loadGroup(pa.z + i), loadGroup(pb.z + i), dot);
+				dot = mulAdd(loadGroup(pa.w + i), loadGroup(pb.w + i), dot);
+				storeGroup(out.data() + p * Vec4x8::SIZE + i, dot);
+			}
+		}
+	}
+
+	void Normalize(const std::vector<Vec4x8>& a, std::vector<Vec4x8>& out)
+	{
+		out.resize(a.size());
+		for (size_t p = 0; p < a.size(); p++)
+		{
+			const Vec4x8& in = a[p];
+			Vec4x8& result = out[p];
+			for (int i = 0; i < Vec4x8::SIZE; i += GROUP_SIZE)
+			{
+				const Group x = loadGroup(in.x + i), y = loadGroup(in.y + i), z = loadGroup(in.z + i), w = loadGroup(in.w + i);
+				const Group sqrMagnitude = mulAdd(w, w, mulAdd(z, z, mulAdd(y, y, mul(x, x))));
+				//rsqrt(0) is infinite, so zero vectors are passed through by the select
+				const Group invMagnitude = rsqrt(sqrMagnitude);
+				storeGroup(result.x + i, selectPositive(sqrMagnitude, mul(x, invMagnitude), x));
+				storeGroup(result.y + i, selectPositive(sqrMagnitude, mul(y, invMagnitude), y));
+				storeGroup(result.z + i, selectPositive(sqrMagnitude, mul(z, invMagnitude), z));
+				storeGroup(result.w + i, selectPositive(sqrMagnitude, mul(w, invMagnitude), w));
+			}
+		}
+	}
+
+	void Transform(const ew::Mat4& m, const std::vector<Vec4x8>& a, std::vector<Vec4x8>& out)
+	{
+		out.resize(a.size());
+		for (size_t p = 0; p < a.size(); p++)
+		{
+			const Vec4x8& in = a[p];
+			Vec4x8& result = out[p];
+			for (int i = 0; i < Vec4x8::SIZE; i += GROUP_SIZE)
+			{
+				//All inputs are loaded before storing, so out can be a
+				const Group x = loadGroup(in.x + i), y = loadGroup(in.y + i), z = loadGroup(in.z + i), w = loadGroup(in.w + i);
+				float* outs[4] = { result.x + i, result.y + i, result.z + i, result.w + i };
+				for (int row = 0; row < 4; row++)
+				{
+					Group v = mul(broadcast(m[0][row], x), x);
+					v = mulAdd(broadcast(m[1][row], x), y, v);
+					v = mulAdd(broadcast(m[2][row], x), z, v);
+					v = mulAdd(broadcast(m[3][row], x), w, v);
+					storeGroup(outs[row], v);
+				}
+			}
+		}
+	}
+}
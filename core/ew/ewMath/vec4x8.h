@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+#include <stddef.h>
+#include "vec4.h"
+#include "mat4.h"
+
+namespace ew {
+	//8 Vec4s stored as separate x, y, z and w arrays. A std::vector<Vec4x8> keeps each packet's components
+	//together, so a packet is one AVX register or two SSE registers per component with no remainder loop.
+	//Use for homogeneous positions, colors and other Vec4 batches, and Vec3Stream for Vec3 batches
+	struct alignas(32) Vec4x8 {
+		static const int SIZE = 8;
+		float x[SIZE], y[SIZE], z[SIZE], w[SIZE];
+
+		inline Vec4 get(int lane)const { return Vec4(x[lane], y[lane], z[lane], w[lane]); }
+		inline void set(int lane, const Vec4& v) { x[lane] = v.x; y[lane] = v.y; z[lane] = v.z; w[lane] = v.w; }
+	};
+
+	//Packs vectors into (vectors.size() + 7) / 8 packets. Unused lanes of the last packet are zero
+	void Pack(const std::vector<Vec4>& vectors, std::vector<Vec4x8>& out);
+	//Unpacks the first count vectors
+	void Unpack(const std::vector<Vec4x8>& packets, size_t count, std::vector<Vec4>& out);
+
+	//Bulk operations on equal sized packet arrays. Outputs are resized to the input size and may be one of the inputs
+	void Add(const std::vector<Vec4x8>& a, const std::vector<Vec4x8>& b, std::vector<Vec4x8>& out);
+	void Sub(const std::vector<Vec4x8>& a, const std::vector<Vec4x8>& b, std::vector<Vec4x8>& out);
+	void Mul(const std::vector<Vec4x8>& a, const std::vector<Vec4x8>& b, std::vector<Vec4x8>& out); //Per component
+	void Mul(const std::vector<Vec4x8>& a, float s, std::vector<Vec4x8>& out);
+	void MulAdd(const std::vector<Vec4x8>& a, float s, const std::vector<Vec4x8>& b, std::vector<Vec4x8>& out); //a * s + b
+	void Dot(const std::vector<Vec4x8>& a, const std::vector<Vec4x8>& b, std::vector<float>& out); //8 results per packet
+	void Normalize(const std::vector<Vec4x8>& a, std::vector<Vec4x8>& out); //Approximate reciprocal square root refined by one Newton step. Zero vectors are unchanged
+	void Lerp(const std::vector<Vec4x8>& a, const std::vector<Vec4x8>& b, float t, std::vector<Vec4x8>& out);
+	void Clamp(const std::vector<Vec4x8>& a, float min, float max, std::vector<Vec4x8>& out); //Per component
+	//m * v for every vector, e.g. positions with w = 1 by a view projection matrix
+	void Transform(const ew::Mat4& m, const std::vector<Vec4x8>& a, std::vector<Vec4x8>& out);
+}
@@ -0,0 +1,114 @@
+#include "fileWatcher.h"
+#include <filesystem>
+#include <algorithm>
+#include <stdio.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <limits.h>
+#endif
+
+/// <summary>
+/// Last modification time of a file, or 0 if it can't be read
+/// </summary>
+static long long getLastWriteTime(const std::string& filePath) {
+	std::error_code error;
+	auto time = std::filesystem::last_write_time(filePath, error);
+	if (error) {
+		return 0;
+	}
+	return (long long)time.time_since_epoch().count();
+}
+
+namespace ew {
+	FileWatcher::FileWatcher()
+	{
+#ifdef __linux__
+		m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (m_inotify < 0) {
+			printf("Failed to initialize inotify, falling back to polling file times");
+		}
+#endif
+	}
+	FileWatcher::~FileWatcher()
+	{
+#ifdef __linux__
+		if (m_inotify >= 0) {
+			close(m_inotify);
+		}
+#endif
+	}
+	/// <summary>
+	/// Starts watching a file for changes
+	/// </summary>
+	/// <param name="filePath">Path to the file. Relative paths are relative to the working directory</param>
+	void FileWatcher::watch(const std::string& filePath)
+	{
+		for (const WatchedFile& file : m_files) {
+			if (file.path == filePath) {
+				return;
+			}
+		}
+		std::filesystem::path path(filePath);
+		WatchedFile file;
+		file.path = filePath;
+		file.directory = path.has_parent_path() ? path.parent_path().string() : ".";
+		file.fileName = path.filename().string();
+		file.lastWriteTime = getLastWriteTime(filePath);
+#ifdef __linux__
+		//Editors often save by writing a new file and renaming it over the old one, which
+		//would orphan a watch on the file itself, so the containing directory is watched instead.
+		//inotify returns the same descriptor for a directory that is already watched.
+		if (m_inotify >= 0) {
+			file.watchDescriptor = inotify_add_watch(m_inotify, file.directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+			if (file.watchDescriptor < 0) {
+				printf("Failed to watch %s", file.directory.c_str());
+			}
+		}
+#endif
+		m_files.push_back(file);
+	}
+	/// <summary>
+	/// Returns the paths (as passed to watch) of all watched files modified since the last call
+	/// </summary>
+	std::vector<std::string> FileWatcher::poll()
+	{
+		std::vector<std::string> changed;
+		auto markChanged = [&changed](const std::string& path) {
+			if (std::find(changed.begin(), changed.end(), path) == changed.end()) {
+				changed.push_back(path);
+			}
+		};
+#ifdef __linux__
+		if (m_inotify >= 0) {
+			alignas(inotify_event) char buffer[4096];
+			ssize_t length;
+			while ((length = read(m_inotify, buffer, sizeof(buffer))) > 0) {
+				for (char* ptr = buffer; ptr < buffer + length; ptr += sizeof(inotify_event) + ((inotify_event*)ptr)->len) {
+					const inotify_event* event = (const inotify_event*)ptr;
+					if (event->len == 0) {
+						continue;
+					}
+					for (const WatchedFile& file : m_files) {
+						if (file.watchDescriptor == event->wd && file.fileName == event->name) {
+							markChanged(file.path);
+						}
+					}
+				}
+			}
+		}
+#endif
+		//Files without an inotify watch fall back to comparing modification times
+		for (WatchedFile& file : m_files) {
+			if (file.watchDescriptor >= 0) {
+				continue;
+			}
+			long long writeTime = getLastWriteTime(file.path);
+			if (writeTime != file.lastWriteTime) {
+				file.lastWriteTime = writeTime;
+				markChanged(file.path);
+			}
+		}
+		return changed;
+	}
+}
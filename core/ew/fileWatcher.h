@@ -0,0 +1,27 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace ew {
+	//Reports files that have been modified since the last poll.
+	//Uses inotify on Linux, and compares modification times on other platforms.
+	class FileWatcher {
+	public:
+		FileWatcher();
+		~FileWatcher();
+		FileWatcher(const FileWatcher&) = delete;
+		FileWatcher& operator=(const FileWatcher&) = delete;
+		void watch(const std::string& filePath);
+		std::vector<std::string> poll(); //Never blocks
+	private:
+		struct WatchedFile {
+			std::string path;
+			std::string directory;
+			std::string fileName;
+			int watchDescriptor = -1;
+			long long lastWriteTime = 0;
+		};
+		std::vector<WatchedFile> m_files;
+		int m_inotify = -1;
+	};
+}
@@ -0,0 +1,238 @@
+#include "frustum.h"
+#include "jobSystem.h"
+#include "ewMath/simdLanes.h"
+#include <chrono>
+
+//Below this many objects per job, queuing jobs costs more than it saves
+static const int MIN_OBJECTS_PER_THREAD = 4096;
+
+/// <summary>
+/// Scales a plane so its normal has unit length, making distance a true distance
+/// </summary>
+static ew::Plane normalizePlane(const ew::Vec4& p) {
+	ew::Vec3 normal = p.toVec3();
+	float length = ew::Magnitude(normal);
+	if (length == 0.0f) {
+		return ew::Plane{ normal, p.w };
+	}
+	return ew::Plane{ normal / length, p.w / length };
+}
+
+namespace ew {
+	/// <summary>
+	/// Extracts the planes of the clip space volume -w <= x,y,z <= w in world space (Gribb/Hartmann)
+	/// </summary>
+	/// <param name="viewProjection">Projection * View</param>
+	Frustum ExtractFrustum(const ew::Mat4& viewProjection)
+	{
+		const ew::Mat4& m = viewProjection;
+		Frustum frustum;
+		//Plane 2k is row 3 + row k, plane 2k + 1 is row 3 - row k. Mat4 is indexed [column][row]
+		for (int k = 0; k < 3; k++)
+		{
+			for (int side = 0; side < 2; side++)
+			{
+				float sign = side == 0 ? 1.0f : -1.0f;
+				ew::Vec4 plane(
+					m[0][3] + sign * m[0][k],
+					m[1][3] + sign * m[1][k],
+					m[2][3] + sign * m[2][k],
+					m[3][3] + sign * m[3][k]);
+				frustum.planes[k * 2 + side] = normalizePlane(plane);
+			}
+		}
+		return frustum;
+	}
+	/// <summary>
+	/// World space frustum of a camera
+	/// </summary>
+	Frustum CameraFrustum(const ew::Camera& camera)
+	{
+		return ExtractFrustum(camera.ProjectionMatrix() * camera.ViewMatrix());
+	}
+	/// <summary>
+	/// Tests a single world space box. Conservative: boxes near frustum corners may be reported visible.
+	/// </summary>
+	bool IsVisible(const Frustum& frustum, const AABB& bounds)
+	{
+		ew::Vec3 center = bounds.center();
+		ew::Vec3 extents = bounds.extents();
+		for (const Plane& plane : frustum.planes)
+		{
+			float distance = ew::Dot(plane.normal, center) + plane.distance;
+			float reach = fabsf(plane.normal.x) * extents.x + fabsf(plane.normal.y) * extents.y + fabsf(plane.normal.z) * extents.z;
+			if (distance + reach < 0.0f) {
+				return false;
+			}
+		}
+		return true;
+	}
+	/// <summary>
+	/// Tests a single world space sphere
+	/// </summary>
+	bool IsVisible(const Frustum& frustum, const ew::Vec3& center, float radius)
+	{
+		for (const Plane& plane : frustum.planes)
+		{
+			if (ew::Dot(plane.normal, center) + plane.distance + radius < 0.0f) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Adds a world space box
+	/// </summary>
+	/// <returns>Index into the visible array filled by cull</returns>
+	int CullingBounds::add(const AABB& worldBounds)
+	{
+		m_centerX.push_back(0); m_centerY.push_back(0); m_centerZ.push_back(0);
+		m_extentX.push_back(0); m_extentY.push_back(0); m_extentZ.push_back(0);
+		m_radius.push_back(0);
+		set(size() - 1, worldBounds);
+		return size() - 1;
+	}
+	/// <summary>
+	/// Adds a world space sphere
+	/// </summary>
+	/// <returns>Index into the visible array filled by cull</returns>
+	int CullingBounds::add(const ew::Vec3& center, float radius)
+	{
+		m_centerX.push_back(0); m_centerY.push_back(0); m_centerZ.push_back(0);
+		m_extentX.push_back(0); m_extentY.push_back(0); m_extentZ.push_back(0);
+		m_radius.push_back(0);
+		set(size() - 1, center, radius);
+		return size() - 1;
+	}
+	/// <summary>
+	/// Replaces an entry with a world space box, e.g. after its object moved
+	/// </summary>
+	void CullingBounds::set(int index, const AABB& worldBounds)
+	{
+		ew::Vec3 center = worldBounds.center();
+		ew::Vec3 extents = worldBounds.extents();
+		m_centerX[index] = center.x; m_centerY[index] = center.y; m_centerZ[index] = center.z;
+		m_extentX[index] = extents.x; m_extentY[index] = extents.y; m_extentZ[index] = extents.z;
+		m_radius[index] = 0.0f;
+	}
+	/// <summary>
+	/// Replaces an entry with a world space sphere
+	/// </summary>
+	void CullingBounds::set(int index, const ew::Vec3& center, float radius)
+	{
+		m_centerX[index] = center.x; m_centerY[index] = center.y; m_centerZ[index] = center.z;
+		m_extentX[index] = 0.0f; m_extentY[index] = 0.0f; m_extentZ[index] = 0.0f;
+		m_radius[index] = radius;
+	}
+	void CullingBounds::clear()
+	{
+		m_centerX.clear(); m_centerY.clear(); m_centerZ.clear();
+		m_extentX.clear(); m_extentY.clear(); m_extentZ.clear();
+		m_radius.clear();
+	}
+	/// <summary>
+	/// Tests every entry against the frustum
+	/// </summary>
+	/// <param name="visible">Resized to size(). Set to 1 for entries that may be visible, 0 for entries outside the frustum</param>
+	/// <param name="numThreads">Splits the entries into up to this many jobs on DefaultJobSystem, the first run by the calling thread</param>
+	/// <returns>Number of visible entries</returns>
+	int CullingBounds::cull(const Frustum& frustum, std::vector<uint8_t>& visible, int numThreads)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		const int count = size();
+		visible.resize(count);
+		int maxThreads = count / MIN_OBJECTS_PER_THREAD;
+		if (numThreads > maxThreads) {
+			numThreads = maxThreads;
+		}
+		int numVisible = 0;
+		if (numThreads <= 1) {
+			cullRange(frustum, visible.data(), 0, count, &numVisible);
+		}
+		else {
+			//Chunks are multiples of 8 so that only the last one has a partial SIMD group
+			int chunk = ((count + numThreads - 1) / numThreads + 7) & ~7;
+			std::vector<int> threadVisible(numThreads, 0);
+			DefaultJobSystem().parallelFor(0, numThreads, 1, [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; i++)
+				{
+					const int first = (int)i * chunk;
+					const int last = first + chunk < count ? first + chunk : count;
+					if (first < last) {
+						cullRange(frustum, visible.data(), first, last, &threadVisible[i]);
+					}
+				}
+			});
+			for (int n : threadVisible) {
+				numVisible += n;
+			}
+		}
+		m_stats.numTested = count;
+		m_stats.numVisible = numVisible;
+		m_stats.cullMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		return numVisible;
+	}
+	/// <summary>
+	/// Culls entries [begin, end). A box is outside when center distance + projected extents + radius
+	/// is negative for any plane.
+	/// </summary>
+	void CullingBounds::cullRange(const Frustum& frustum, uint8_t* visible, int begin, int end, int* numVisible) const
+	{
+		int i = begin;
+		int count = 0;
+#if defined(EW_SIMD_LANES)
+		const int laneCount = (int)simd::LANE_COUNT;
+		simd::Lanes planeN[6][3], planeAbsN[6][3], planeD[6];
+		for (int p = 0; p < 6; p++)
+		{
+			const Plane& plane = frustum.planes[p];
+			planeN[p][0] = simd::splat(plane.normal.x);
+			planeN[p][1] = simd::splat(plane.normal.y);
+			planeN[p][2] = simd::splat(plane.normal.z);
+			planeAbsN[p][0] = simd::splat(fabsf(plane.normal.x));
+			planeAbsN[p][1] = simd::splat(fabsf(plane.normal.y));
+			planeAbsN[p][2] = simd::splat(fabsf(plane.normal.z));
+			planeD[p] = simd::splat(plane.distance);
+		}
+		const simd::Lanes zero = simd::splat(0.0f);
+		for (; i + laneCount <= end; i += laneCount)
+		{
+			simd::Lanes cx = simd::load(&m_centerX[i]), cy = simd::load(&m_centerY[i]), cz = simd::load(&m_centerZ[i]);
+			simd::Lanes ex = simd::load(&m_extentX[i]), ey = simd::load(&m_extentY[i]), ez = simd::load(&m_extentZ[i]);
+			simd::Lanes r = simd::load(&m_radius[i]);
+			simd::Lanes outside = zero;
+			for (int p = 0; p < 6; p++)
+			{
+				simd::Lanes distance = simd::add(simd::add(simd::mul(planeN[p][0], cx), simd::mul(planeN[p][1], cy)), simd::add(simd::mul(planeN[p][2], cz), planeD[p]));
+				simd::Lanes reach = simd::add(simd::add(simd::mul(planeAbsN[p][0], ex), simd::mul(planeAbsN[p][1], ey)), simd::add(simd::mul(planeAbsN[p][2], ez), r));
+				outside = simd::bitOr(outside, simd::less(simd::add(distance, reach), zero));
+			}
+			int mask = simd::laneBits(outside);
+			for (int k = 0; k < laneCount; k++)
+			{
+				uint8_t v = (uint8_t)(((mask >> k) & 1) ^ 1);
+				visible[i + k] = v;
+				count += v;
+			}
+		}
+#endif
+		//Scalar fallback, and the remainder that does not fill a SIMD group
+		for (; i < end; i++)
+		{
+			bool inside = true;
+			for (const Plane& plane : frustum.planes)
+			{
+				float distance = plane.normal.x * m_centerX[i] + plane.normal.y * m_centerY[i] + plane.normal.z * m_centerZ[i] + plane.distance;
+				float reach = fabsf(plane.normal.x) * m_extentX[i] + fabsf(plane.normal.y) * m_extentY[i] + fabsf(plane.normal.z) * m_extentZ[i] + m_radius[i];
+				if (distance + reach < 0.0f) {
+					inside = false;
+					break;
+				}
+			}
+			visible[i] = inside ? 1 : 0;
+			count += inside ? 1 : 0;
+		}
+		*numVisible = count;
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include "ewMath/ewMath.h"
+#include "bounds.h"
+#include "camera.h"
+
+namespace ew {
+	//Points p with Dot(normal, p) + distance >= 0 are on the inside
+	struct Plane {
+		ew::Vec3 normal;
+		float distance;
+	};
+
+	//Left, right, bottom, top, near, far
+	struct Frustum {
+		Plane planes[6];
+	};
+
+	Frustum ExtractFrustum(const ew::Mat4& viewProjection);
+	Frustum CameraFrustum(const ew::Camera& camera);
+	bool IsVisible(const Frustum& frustum, const AABB& bounds);
+	bool IsVisible(const Frustum& frustum, const ew::Vec3& center, float radius);
+
+	struct CullStats {
+		int numTested = 0;
+		int numVisible = 0;
+		float cullMs = 0.0f;
+	};
+
+	//World space bounds stored as separate arrays (structure of arrays), so that
+	//4 (SSE) or 8 (AVX) objects are tested against each plane per instruction.
+	//Each entry is a box (radius 0) or a sphere (extents 0).
+	class CullingBounds {
+	public:
+		int add(const AABB& worldBounds);
+		int add(const ew::Vec3& center, float radius);
+		void set(int index, const AABB& worldBounds);
+		void set(int index, const ew::Vec3& center, float radius);
+		void clear();
+		int cull(const Frustum& frustum, std::vector<uint8_t>& visible, int numThreads = 1);
+		inline int size()const { return (int)m_centerX.size(); }
+		inline const CullStats& getStats()const { return m_stats; }
+	private:
+		void cullRange(const Frustum& frustum, uint8_t* visible, int begin, int end, int* numVisible)const;
+		std::vector<float> m_centerX, m_centerY, m_centerZ;
+		std::vector<float> m_extentX, m_extentY, m_extentZ;
+		std::vector<float> m_radius;
+		CullStats m_stats;
+	};
+}
@@ -0,0 +1,202 @@
+#include "geometryArena.h"
+#include "glState.h"
+#include "external/glad.h"
+
+/// <summary>
+/// Replaces a buffer with a larger one, keeping its first usedBytes
+/// </summary>
+/// <returns>The new buffer</returns>
+static unsigned int resizeBuffer(unsigned int oldBuffer, size_t usedBytes, size_t newBytes) {
+	unsigned int newBuffer;
+	glGenBuffers(1, &newBuffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, newBytes, NULL, GL_STATIC_DRAW);
+	if (oldBuffer != 0) {
+		if (usedBytes > 0) {
+			glBindBuffer(GL_COPY_READ_BUFFER, oldBuffer);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, usedBytes);
+			glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		}
+		glDeleteBuffers(1, &oldBuffer);
+	}
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	return newBuffer;
+}
+
+namespace ew {
+	GeometryArena::GeometryArena(unsigned int vertexCapacity, unsigned int indexCapacity)
+	{
+		glGenVertexArrays(1, &m_vao);
+		grow(vertexCapacity, indexCapacity);
+		reserveDrawIndices(1024);
+	}
+	/// <summary>
+	/// Reallocates the vertex and index buffers with more space and points the VAO at them
+	/// </summary>
+	void GeometryArena::grow(unsigned int vertexCapacity, unsigned int indexCapacity)
+	{
+		if (vertexCapacity <= m_vertexCapacity && indexCapacity <= m_indexCapacity) {
+			return;
+		}
+		if (vertexCapacity > m_vertexCapacity) {
+			m_vbo = resizeBuffer(m_vbo, sizeof(Vertex) * m_numVertices, sizeof(Vertex) * vertexCapacity);
+			m_vertexCapacity = vertexCapacity;
+		}
+		if (indexCapacity > m_indexCapacity) {
+			m_ebo = resizeBuffer(m_ebo, sizeof(unsigned int) * m_numIndices, sizeof(unsigned int) * indexCapacity);
+			m_indexCapacity = indexCapacity;
+		}
+		ew::state::bindVertexArray(m_vao);
+		glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+		//Position attribute
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const void*)offsetof(Vertex, pos));
+		glEnableVertexAttribArray(0);
+
+		//Normal attribute
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const void*)offsetof(Vertex, normal));
+		glEnableVertexAttribArray(1);
+
+		//UV attribute
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const void*)(offsetof(Vertex, uv)));
+		glEnableVertexAttribArray(2);
+
+		ew::state::bindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+	/// <summary>
+	/// Copies a mesh into the shared buffers, growing them if needed
+	/// </summary>
+	/// <returns>Where the mesh was placed, for use with IndirectBatch::add</returns>
+	MeshAllocation GeometryArena::add(const MeshData& meshData)
+	{
+		unsigned int numVertices = (unsigned int)meshData.vertices.size();
+		unsigned int numIndices = (unsigned int)meshData.indices.size();
+		unsigned int vertexCapacity = m_vertexCapacity;
+		unsigned int indexCapacity = m_indexCapacity;
+		//Doubling starts from 1 so that an arena created with 0 capacity can grow
+		while (m_numVertices + numVertices > vertexCapacity) {
+			vertexCapacity = vertexCapacity > 0 ? vertexCapacity * 2 : 1;
+		}
+		while (m_numIndices + numIndices > indexCapacity) {
+			indexCapacity = indexCapacity > 0 ? indexCapacity * 2 : 1;
+		}
+		grow(vertexCapacity, indexCapacity);
+
+		MeshAllocation allocation;
+		allocation.baseVertex = m_numVertices;
+		allocation.numVertices = numVertices;
+		allocation.firstIndex = m_numIndices;
+		allocation.numIndices = numIndices;
+		allocation.bounds = meshData.bounds;
+
+		if (numVertices > 0) {
+			glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+			glBufferSubData(GL_ARRAY_BUFFER, sizeof(Vertex) * m_numVertices, sizeof(Vertex) * numVertices, meshData.vertices.data());
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+		if (numIndices > 0) {
+			//Indices stay relative to the mesh. baseVertex offsets them at draw time
+			glBindBuffer(GL_COPY_WRITE_BUFFER, m_ebo);
+			glBufferSubData(GL_COPY_WRITE_BUFFER, sizeof(unsigned int) * m_numIndices, sizeof(unsigned int) * numIndices, meshData.indices.data());
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		}
+		m_numVertices += numVertices;
+		m_numIndices += numIndices;
+		return allocation;
+	}
+	/// <summary>
+	/// Makes sure the draw index attribute covers at least numDraws draws.
+	/// Draw i uses baseInstance i, so its instanced attribute reads element i of this 0..N-1 buffer.
+	/// This gives the same result as gl_DrawID without requiring GLSL 4.60 or ARB_shader_draw_parameters.
+	/// </summary>
+	void GeometryArena::reserveDrawIndices(unsigned int numDraws)
+	{
+		if (numDraws <= m_drawIndexCapacity) {
+			return;
+		}
+		unsigned int capacity = m_drawIndexCapacity > 0 ? m_drawIndexCapacity : 1;
+		while (capacity < numDraws) {
+			capacity *= 2;
+		}
+		std::vector<uint32_t> drawIndices(capacity);
+		for (uint32_t i = 0; i < capacity; i++) {
+			drawIndices[i] = i;
+		}
+		if (m_drawIndexBuffer == 0) {
+			glGenBuffers(1, &m_drawIndexBuffer);
+		}
+		ew::state::bindVertexArray(m_vao);
+		glBindBuffer(GL_ARRAY_BUFFER, m_drawIndexBuffer);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(uint32_t) * capacity, drawIndices.data(), GL_STATIC_DRAW);
+		//Draw index attribute
+		glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (const void*)0);
+		glVertexAttribDivisor(3, 1);
+		glEnableVertexAttribArray(3);
+		ew::state::bindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		m_drawIndexCapacity = capacity;
+	}
+
+	IndirectBatch::IndirectBatch()
+	{
+		glGenBuffers(1, &m_commandBuffer);
+		glGenBuffers(1, &m_drawDataBuffer);
+	}
+	/// <summary>
+	/// Records a draw of a mesh from the arena
+	/// </summary>
+	/// <param name="mesh">Allocation returned by GeometryArena::add</param>
+	/// <param name="model">Model matrix, stored in _DrawData[drawIndex].model along with its normal matrix</param>
+	/// <param name="materialIndex">Stored in _DrawData[drawIndex].materialIndex, e.g. to index a MaterialTable</param>
+	void IndirectBatch::add(const MeshAllocation& mesh, const ew::Mat4& model, unsigned int materialIndex)
+	{
+		DrawElementsIndirectCommand command;
+		command.count = mesh.numIndices;
+		command.instanceCount = 1;
+		command.firstIndex = mesh.firstIndex;
+		command.baseVertex = (int32_t)mesh.baseVertex;
+		command.baseInstance = (uint32_t)m_commands.size();
+		m_commands.push_back(command);
+
+		IndirectDrawData drawData;
+		drawData.model = model;
+		drawData.normalMatrix = ew::NormalMatrix(model);
+		drawData.materialIndex = materialIndex;
+		drawData.pad[0] = drawData.pad[1] = drawData.pad[2] = 0;
+		m_drawData.push_back(drawData);
+	}
+	/// <summary>
+	/// Uploads the recorded draws and submits all of them with one glMultiDrawElementsIndirect call.
+	/// The shader must already be in use.
+	/// </summary>
+	/// <param name="arena">Arena the recorded meshes were allocated from</param>
+	/// <param name="drawDataBinding">Shader storage buffer binding of _DrawData</param>
+	void IndirectBatch::draw(GeometryArena& arena, unsigned int drawDataBinding)
+	{
+		if (m_commands.empty()) {
+			return;
+		}
+		arena.reserveDrawIndices((unsigned int)m_commands.size());
+		//Orphan and refill both buffers, since draws are usually re-recorded every frame
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_drawDataBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(IndirectDrawData) * m_drawData.size(), m_drawData.data(), GL_STREAM_DRAW);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, drawDataBinding, m_drawDataBuffer);
+
+		ew::state::bindVertexArray(arena.getVAO());
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+		glBufferData(GL_DRAW_INDIRECT_BUFFER, sizeof(DrawElementsIndirectCommand) * m_commands.size(), m_commands.data(), GL_STREAM_DRAW);
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, NULL, (GLsizei)m_commands.size(), 0);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+	/// <summary>
+	/// Removes all recorded draws
+	/// </summary>
+	void IndirectBatch::clear()
+	{
+		m_commands.clear();
+		m_drawData.clear();
+	}
+}
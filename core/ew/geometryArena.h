@@ -0,0 +1,76 @@
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include "ewMath/ewMath.h"
+#include "mesh.h"
+
+namespace ew {
+	//Location of a mesh inside a GeometryArena
+	struct MeshAllocation {
+		unsigned int baseVertex = 0;
+		unsigned int numVertices = 0;
+		unsigned int firstIndex = 0;
+		unsigned int numIndices = 0;
+		AABB bounds; //Local space bounds of the mesh
+	};
+
+	//Stores the vertices and indices of many meshes in shared buffers behind a single VAO,
+	//so they can all be drawn with one glMultiDrawElementsIndirect call.
+	//Attributes match ew::Mesh (0 = position, 1 = normal, 2 = uv), plus
+	//3 = uint draw index, read per instance so that it equals the draw's baseInstance.
+	class GeometryArena {
+	public:
+		GeometryArena(unsigned int vertexCapacity = 65536, unsigned int indexCapacity = 262144);
+		MeshAllocation add(const MeshData& meshData);
+		void reserveDrawIndices(unsigned int numDraws);
+		inline unsigned int getVAO()const { return m_vao; }
+		inline unsigned int getNumVertices()const { return m_numVertices; }
+		inline unsigned int getNumIndices()const { return m_numIndices; }
+	private:
+		void grow(unsigned int vertexCapacity, unsigned int indexCapacity);
+		unsigned int m_vao = 0;
+		unsigned int m_vbo = 0;
+		unsigned int m_ebo = 0;
+		unsigned int m_drawIndexBuffer = 0;
+		unsigned int m_vertexCapacity = 0;
+		unsigned int m_indexCapacity = 0;
+		unsigned int m_drawIndexCapacity = 0;
+		unsigned int m_numVertices = 0;
+		unsigned int m_numIndices = 0;
+	};
+
+	//Matches the GL DrawElementsIndirectCommand layout
+	struct DrawElementsIndirectCommand {
+		uint32_t count;
+		uint32_t instanceCount;
+		uint32_t firstIndex;
+		int32_t baseVertex;
+		uint32_t baseInstance;
+	};
+
+	//Per draw data as laid out in the std430 shader storage buffer:
+	//struct DrawData { mat4 model; mat4 normalMatrix; uint materialIndex; };
+	//layout(std430, binding = 1) readonly buffer DrawDataBuffer { DrawData _DrawData[]; };
+	struct IndirectDrawData {
+		ew::Mat4 model;
+		ew::Mat4 normalMatrix; //ew::NormalMatrix(model)
+		uint32_t materialIndex;
+		uint32_t pad[3];
+	};
+
+	//Records draws of meshes in a GeometryArena and submits them in a single multi-draw-indirect call.
+	//Vertex shaders index _DrawData with the per draw index attribute (location 3).
+	class IndirectBatch {
+	public:
+		IndirectBatch();
+		void add(const MeshAllocation& mesh, const ew::Mat4& model, unsigned int materialIndex = 0);
+		void draw(GeometryArena& arena, unsigned int drawDataBinding = 1);
+		void clear();
+		inline int size()const { return (int)m_commands.size(); }
+	private:
+		std::vector<DrawElementsIndirectCommand> m_commands;
+		std::vector<IndirectDrawData> m_drawData;
+		unsigned int m_commandBuffer = 0;
+		unsigned int m_drawDataBuffer = 0;
+	};
+}
@@ -0,0 +1,189 @@
+#include "glState.h"
+#include "external/glad.h"
+
+namespace ew {
+	namespace state {
+		//Marks state the cache doesn't know, so the next call always reaches the driver
+		static const unsigned int UNKNOWN = 0xFFFFFFFF;
+		static const int MAX_TEXTURE_UNITS = 32;
+		static const int MAX_CAPABILITIES = 16;
+		static const GLenum TEXTURE_TARGETS[] = { GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_3D };
+		static const int NUM_TEXTURE_TARGETS = sizeof(TEXTURE_TARGETS) / sizeof(TEXTURE_TARGETS[0]);
+
+		struct Capability {
+			GLenum capability;
+			unsigned int enabled; //0, 1 or UNKNOWN
+		};
+
+		struct StateCache {
+			unsigned int program = UNKNOWN;
+			unsigned int vao = UNKNOWN;
+			unsigned int activeTextureUnit = UNKNOWN;
+			unsigned int textures[MAX_TEXTURE_UNITS][NUM_TEXTURE_TARGETS];
+			Capability capabilities[MAX_CAPABILITIES];
+			int numCapabilities = 0;
+			unsigned int blendSource = UNKNOWN;
+			unsigned int blendDest = UNKNOWN;
+			unsigned int depthFunc = UNKNOWN;
+			unsigned int depthMask = UNKNOWN;
+			unsigned int cullFace = UNKNOWN;
+			GLStateCounters counters;
+
+			StateCache() { reset(); }
+			void reset() {
+				program = vao = activeTextureUnit = UNKNOWN;
+				for (int i = 0; i < MAX_TEXTURE_UNITS; i++) {
+					for (int j = 0; j < NUM_TEXTURE_TARGETS; j++) {
+						textures[i][j] = UNKNOWN;
+					}
+				}
+				for (int i = 0; i < numCapabilities; i++) {
+					capabilities[i].enabled = UNKNOWN;
+				}
+				blendSource = blendDest = depthFunc = depthMask = cullFace = UNKNOWN;
+			}
+		};
+		static StateCache s_cache;
+
+		/// <summary>
+		/// Updates a cached value and counts the call
+		/// </summary>
+		/// <returns>True if the value changed and the GL call must be issued</returns>
+		static bool setCached(unsigned int& cached, unsigned int value) {
+			if (cached == value) {
+				s_cache.counters.filtered++;
+				return false;
+			}
+			cached = value;
+			s_cache.counters.issued++;
+			return true;
+		}
+
+		static int getTextureTargetIndex(GLenum target) {
+			for (int i = 0; i < NUM_TEXTURE_TARGETS; i++) {
+				if (TEXTURE_TARGETS[i] == target) {
+					return i;
+				}
+			}
+			return -1;
+		}
+
+		void useProgram(unsigned int program) {
+			if (setCached(s_cache.program, program)) {
+				glUseProgram(program);
+			}
+		}
+		void bindVertexArray(unsigned int vao) {
+			if (setCached(s_cache.vao, vao)) {
+				glBindVertexArray(vao);
+			}
+		}
+		/// <summary>
+		/// Binds a texture to a texture unit. Changes the active texture unit if needed.
+		/// </summary>
+		/// <param name="unit">Texture unit index (0 for GL_TEXTURE0)</param>
+		/// <param name="target">GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY, etc.</param>
+		/// <param name="texture">Texture handle</param>
+		void bindTexture(unsigned int unit, unsigned int target, unsigned int texture) {
+			int targetIndex = getTextureTargetIndex(target);
+			if (unit < MAX_TEXTURE_UNITS && targetIndex >= 0) {
+				if (s_cache.textures[unit][targetIndex] == texture) {
+					s_cache.counters.filtered++;
+					return;
+				}
+				s_cache.textures[unit][targetIndex] = texture;
+			}
+			if (setCached(s_cache.activeTextureUnit, unit)) {
+				glActiveTexture(GL_TEXTURE0 + unit);
+			}
+			s_cache.counters.issued++;
+			glBindTexture(target, texture);
+		}
+		void setEnabled(unsigned int capability, bool enabled) {
+			Capability* cached = nullptr;
+			for (int i = 0; i < s_cache.numCapabilities; i++) {
+				if (s_cache.capabilities[i].capability == capability) {
+					cached = &s_cache.capabilities[i];
+					break;
+				}
+			}
+			if (cached == nullptr && s_cache.numCapabilities < MAX_CAPABILITIES) {
+				cached = &s_cache.capabilities[s_cache.numCapabilities++];
+				cached->capability = capability;
+				cached->enabled = UNKNOWN;
+			}
+			if (cached != nullptr && !setCached(cached->enabled, enabled)) {
+				return;
+			}
+			if (cached == nullptr) {
+				s_cache.counters.issued++;
+			}
+			if (enabled) {
+				glEnable(capability);
+			}
+			else {
+				glDisable(capability);
+			}
+		}
+		void blendFunc(unsigned int sourceFactor, unsigned int destFactor) {
+			if (s_cache.blendSource == sourceFactor && s_cache.blendDest == destFactor) {
+				s_cache.counters.filtered++;
+				return;
+			}
+			s_cache.blendSource = sourceFactor;
+			s_cache.blendDest = destFactor;
+			s_cache.counters.issued++;
+			glBlendFunc(sourceFactor, destFactor);
+		}
+		void depthFunc(unsigned int func) {
+			if (setCached(s_cache.depthFunc, func)) {
+				glDepthFunc(func);
+			}
+		}
+		void depthMask(bool write) {
+			if (setCached(s_cache.depthMask, write)) {
+				glDepthMask(write ? GL_TRUE : GL_FALSE);
+			}
+		}
+		void cullFace(unsigned int mode) {
+			if (setCached(s_cache.cullFace, mode)) {
+				glCullFace(mode);
+			}
+		}
+		/// <summary>
+		/// Call when deleting a program. GL may hand the same name to a new object,
+		/// which must not be mistaken for the one that was bound.
+		/// </summary>
+		void onProgramDeleted(unsigned int program) {
+			if (s_cache.program == program) {
+				s_cache.program = UNKNOWN;
+			}
+		}
+		void onVertexArrayDeleted(unsigned int vao) {
+			if (s_cache.vao == vao) {
+				s_cache.vao = UNKNOWN;
+			}
+		}
+		void onTextureDeleted(unsigned int texture) {
+			for (int i = 0; i < MAX_TEXTURE_UNITS; i++) {
+				for (int j = 0; j < NUM_TEXTURE_TARGETS; j++) {
+					if (s_cache.textures[i][j] == texture) {
+						s_cache.textures[i][j] = UNKNOWN;
+					}
+				}
+			}
+		}
+		/// <summary>
+		/// Forgets all cached state. Call after code that changes state with raw GL calls.
+		/// </summary>
+		void invalidate() {
+			s_cache.reset();
+		}
+		const GLStateCounters& getCounters() {
+			return s_cache.counters;
+		}
+		void resetCounters() {
+			s_cache.counters = GLStateCounters();
+		}
+	}
+}
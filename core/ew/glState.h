@@ -0,0 +1,28 @@
+#pragma once
+
+namespace ew {
+	//Number of GL calls passed to the driver vs. skipped because the state was already set
+	struct GLStateCounters {
+		unsigned int issued = 0;
+		unsigned int filtered = 0;
+	};
+
+	//Shadows the GL state set through these functions and skips calls that wouldn't change it.
+	//Code that changes this state with raw GL calls must call invalidate() afterwards.
+	namespace state {
+		void useProgram(unsigned int program);
+		void bindVertexArray(unsigned int vao);
+		void bindTexture(unsigned int unit, unsigned int target, unsigned int texture);
+		void setEnabled(unsigned int capability, bool enabled); //GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, etc.
+		void blendFunc(unsigned int sourceFactor, unsigned int destFactor);
+		void depthFunc(unsigned int func);
+		void depthMask(bool write);
+		void cullFace(unsigned int mode);
+		void onProgramDeleted(unsigned int program);
+		void onVertexArrayDeleted(unsigned int vao);
+		void onTextureDeleted(unsigned int texture);
+		void invalidate();
+		const GLStateCounters& getCounters();
+		void resetCounters();
+	}
+}
@@ -0,0 +1,356 @@
+#include "headless.h"
+//EGL first: glad's copy of khrplatform.h lacks the KHRONOS_APIENTRY macro the EGL headers need
+#if defined(EW_HEADLESS_EGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+#include "external/glad.h"
+#include "glState.h"
+#include "imageWrite.h"
+#include "json.h"
+#include "shader.h"
+#include <GLFW/glfw3.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <filesystem>
+#include <algorithm>
+
+/// <summary>
+/// Mean, min, max and percentiles of values, as a JSON object
+/// </summary>
+static void writeSummaryJSON(FILE* file, const char* name, std::vector<float> values) {
+	if (values.empty()) {
+		fprintf(file, "  \"%s\": null,\n", name);
+		return;
+	}
+	std::sort(values.begin(), values.end());
+	double sum = 0.0;
+	for (float v : values) {
+		sum += v;
+	}
+	auto percentile = [&](float p) { return values[(size_t)(p * (values.size() - 1) + 0.5f)]; };
+	fprintf(file, "  \"%s\": { \"mean\": %.4f, \"min\": %.4f, \"median\": %.4f, \"p95\": %.4f, \"max\": %.4f },\n",
+		name, sum / values.size(), values.front(), percentile(0.5f), percentile(0.95f), values.back());
+}
+
+namespace ew {
+	HeadlessContext::~HeadlessContext()
+	{
+		destroy();
+	}
+	/// <summary>
+	/// Creates a core profile context, makes it current and loads GL functions
+	/// </summary>
+	/// <returns>False if neither EGL nor GLFW could create a context of this version</returns>
+	bool HeadlessContext::create(int majorVersion, int minorVersion)
+	{
+		destroy();
+		m_valid = createEGL(majorVersion, minorVersion) || createGLFW(majorVersion, minorVersion);
+		if (m_valid) {
+			ew::state::invalidate();
+		}
+		return m_valid;
+	}
+	bool HeadlessContext::createEGL(int majorVersion, int minorVersion)
+	{
+#if defined(EW_HEADLESS_EGL)
+		//Mesa's surfaceless platform needs no display server or GPU device. Fall back to the default display
+		EGLDisplay display = EGL_NO_DISPLAY;
+		const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+		PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+		if (getPlatformDisplay && clientExtensions && strstr(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+			display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+		}
+		if (display == EGL_NO_DISPLAY) {
+			display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+		}
+		EGLint eglMajor, eglMinor;
+		if (display == EGL_NO_DISPLAY || !eglInitialize(display, &eglMajor, &eglMinor)) {
+			printf("EGL failed to initialize\n");
+			return false;
+		}
+		const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+		if (!extensions || !strstr(extensions, "EGL_KHR_surfaceless_context")) {
+			printf("EGL does not support surfaceless contexts\n");
+			eglTerminate(display);
+			return false;
+		}
+		const EGLint configAttributes[] = {
+			EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+			EGL_NONE
+		};
+		EGLConfig config;
+		EGLint numConfigs = 0;
+		if (!eglBindAPI(EGL_OPENGL_API) || !eglChooseConfig(display, configAttributes, &config, 1, &numConfigs) || numConfigs == 0) {
+			printf("EGL has no desktop OpenGL config\n");
+			eglTerminate(display);
+			return false;
+		}
+		const EGLint contextAttributes[] = {
+			EGL_CONTEXT_MAJOR_VERSION, majorVersion,
+			EGL_CONTEXT_MINOR_VERSION, minorVersion,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+			EGL_NONE
+		};
+		EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+		if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+			printf("EGL failed to create an OpenGL %i.%i context\n", majorVersion, minorVersion);
+			if (context != EGL_NO_CONTEXT) {
+				eglDestroyContext(display, context);
+			}
+			eglTerminate(display);
+			return false;
+		}
+		if (!gladLoadGL((GLADloadfunc)eglGetProcAddress)) {
+			printf("GLAD Failed to load GL headers");
+			eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+			eglDestroyContext(display, context);
+			eglTerminate(display);
+			return false;
+		}
+		m_display = display;
+		m_context = context;
+		return true;
+#else
+		return false;
+#endif
+	}
+	bool HeadlessContext::createGLFW(int majorVersion, int minorVersion)
+	{
+		if (!glfwInit()) {
+			printf("GLFW failed to init!");
+			return false;
+		}
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, majorVersion);
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, minorVersion);
+		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+		m_window = glfwCreateWindow(1, 1, "Headless", NULL, NULL);
+		glfwDefaultWindowHints();
+		if (m_window == NULL) {
+			printf("GLFW failed to create window");
+			glfwTerminate();
+			return false;
+		}
+		glfwMakeContextCurrent(m_window);
+		if (!gladLoadGL(glfwGetProcAddress)) {
+			printf("GLAD Failed to load GL headers");
+			destroy();
+			return false;
+		}
+		return true;
+	}
+	void HeadlessContext::destroy()
+	{
+#if defined(EW_HEADLESS_EGL)
+		if (m_display) {
+			eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+			eglDestroyContext(m_display, m_context);
+			eglTerminate(m_display);
+		}
+#endif
+		m_display = nullptr;
+		m_context = nullptr;
+		if (m_window) {
+			glfwDestroyWindow(m_window);
+			glfwTerminate();
+			m_window = nullptr;
+		}
+		m_valid = false;
+	}
+
+	RenderTarget::~RenderTarget()
+	{
+		destroy();
+	}
+	/// <returns>False if the framebuffer is incomplete</returns>
+	bool RenderTarget::create(int width, int height)
+	{
+		destroy();
+		m_width = width;
+		m_height = height;
+		glGenTextures(1, &m_colorTexture);
+		ew::state::bindTexture(0, GL_TEXTURE_2D, m_colorTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glGenRenderbuffers(1, &m_depthBuffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+		glGenFramebuffers(1, &m_framebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_colorTexture, 0);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+		bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		if (!complete) {
+			printf("Render target %ix%i is incomplete\n", width, height);
+			destroy();
+		}
+		return complete;
+	}
+	void RenderTarget::destroy()
+	{
+		if (m_framebuffer) {
+			glDeleteFramebuffers(1, &m_framebuffer);
+			glDeleteRenderbuffers(1, &m_depthBuffer);
+			ew::state::onTextureDeleted(m_colorTexture);
+			glDeleteTextures(1, &m_colorTexture);
+		}
+		m_framebuffer = m_colorTexture = m_depthBuffer = 0;
+	}
+	/// <summary>
+	/// Binds the framebuffer and sets the viewport to cover it
+	/// </summary>
+	void RenderTarget::bind() const
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+		glViewport(0, 0, m_width, m_height);
+	}
+	/// <summary>
+	/// Reads the color attachment. Waits for rendering to finish.
+	/// </summary>
+	/// <param name="rgba">Resized to width * height * 4, bottom row first</param>
+	void RenderTarget::readPixels(std::vector<unsigned char>& rgba) const
+	{
+		rgba.resize((size_t)m_width * m_height * 4);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+	}
+
+	/// <summary>
+	/// Renders numFrames frames into an offscreen target with a fixed time step, capturing PNGs and timing
+	/// each frame. A context must be current, e.g. from HeadlessContext.
+	/// GPU timestamps are read back after the last frame, so the queries never stall rendering.
+	/// </summary>
+	/// <returns>Timing of each frame. Empty if the render target could not be created</returns>
+	std::vector<FrameTiming> runHeadless(const HeadlessOptions& options, const HeadlessFrameCallback& renderFrame)
+	{
+		std::vector<FrameTiming> timings;
+		RenderTarget target;
+		if (!target.create(options.width, options.height)) {
+			return timings;
+		}
+		timings.resize(options.numFrames);
+		std::vector<unsigned int> queries(options.numFrames * 2);
+		glGenQueries(options.numFrames * 2, queries.data());
+		std::vector<unsigned char> pixels;
+		for (int frame = 0; frame < options.numFrames; frame++)
+		{
+			target.bind();
+			glQueryCounter(queries[frame * 2], GL_TIMESTAMP);
+			auto start = std::chrono::high_resolution_clock::now();
+			renderFrame(frame, frame * options.deltaTime, options.deltaTime);
+			timings[frame].cpuMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			glQueryCounter(queries[frame * 2 + 1], GL_TIMESTAMP);
+
+			bool lastFrame = frame == options.numFrames - 1;
+			bool capture = options.captureInterval > 0 ? (frame + 1) % options.captureInterval == 0 || lastFrame : options.captureInterval == 0 && lastFrame;
+			if (capture) {
+				target.readPixels(pixels);
+				char path[1024];
+				snprintf(path, sizeof(path), "%s_%04i.png", options.capturePrefix.c_str(), frame);
+				ew::writePNG(path, options.width, options.height, 4, pixels.data(), true);
+			}
+		}
+		//Errors left by the frame callbacks would otherwise be taken for failed queries
+		for (int i = 0; i < 32 && glGetError() != GL_NO_ERROR; i++) {}
+		for (int frame = 0; frame < options.numFrames; frame++)
+		{
+			GLuint64 begin = 0, end = 0;
+			glGetQueryObjectui64v(queries[frame * 2], GL_QUERY_RESULT, &begin);
+			glGetQueryObjectui64v(queries[frame * 2 + 1], GL_QUERY_RESULT, &end);
+			timings[frame].gpuMs = glGetError() == GL_NO_ERROR ? (end - begin) / 1e6f : -1.0f;
+		}
+		glDeleteQueries(options.numFrames * 2, queries.data());
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		if (!options.timingsPath.empty()) {
+			writeFrameTimingsJSON(options.timingsPath, options, timings);
+		}
+		return timings;
+	}
+	/// <summary>
+	/// Times startup through the end of the first frame, first with an empty shader program cache and then
+	/// with the programs that run cached. A context must be current. Uses a scratch cache directory, so the
+	/// real cache is left alone. Driver level shader caches (e.g. Mesa's) may still make the cold start faster.
+	/// </summary>
+	/// <param name="startup">Creates shaders and meshes and draws into the bound render target. Called twice</param>
+	StartupTiming measureTimeToFirstFrame(const HeadlessOptions& options, const HeadlessStartupCallback& startup)
+	{
+		StartupTiming timing;
+		RenderTarget target;
+		if (!target.create(options.width, options.height)) {
+			return timing;
+		}
+		const std::string cacheDirectory = getShaderCacheDirectory();
+		std::string scratchDirectory;
+		if (!cacheDirectory.empty()) {
+			scratchDirectory = cacheDirectory + "/timeToFirstFrame";
+			std::error_code error;
+			std::filesystem::remove_all(scratchDirectory, error);
+			setShaderCacheDirectory(scratchDirectory);
+		}
+		float* results[2] = { &timing.coldMs, &timing.warmMs };
+		for (int run = 0; run < (scratchDirectory.empty() ? 1 : 2); run++)
+		{
+			target.bind();
+			auto start = std::chrono::high_resolution_clock::now();
+			startup();
+			glFinish();
+			*results[run] = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		}
+		if (!scratchDirectory.empty()) {
+			std::error_code error;
+			std::filesystem::remove_all(scratchDirectory, error);
+			setShaderCacheDirectory(cacheDirectory);
+		}
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		return timing;
+	}
+
+	/// <summary>
+	/// Writes the renderer, settings, summary statistics and every frame's timing as JSON
+	/// </summary>
+	bool writeFrameTimingsJSON(const std::string& filePath, const HeadlessOptions& options, const std::vector<FrameTiming>& timings)
+	{
+		FILE* file = fopen(filePath.c_str(), "w");
+		if (file == nullptr) {
+			printf("Failed to open %s for writing\n", filePath.c_str());
+			return false;
+		}
+		std::vector<float> cpuMs, gpuMs;
+		for (const FrameTiming& timing : timings) {
+			cpuMs.push_back(timing.cpuMs);
+			if (timing.gpuMs >= 0.0f) {
+				gpuMs.push_back(timing.gpuMs);
+			}
+		}
+		fprintf(file, "{\n");
+		fprintf(file, "  \"renderer\": \"%s\",\n", escapeJSON((const char*)glGetString(GL_RENDERER)).c_str());
+		fprintf(file, "  \"version\": \"%s\",\n", escapeJSON((const char*)glGetString(GL_VERSION)).c_str());
+		fprintf(file, "  \"width\": %i,\n  \"height\": %i,\n  \"numFrames\": %i,\n", options.width, options.height, (int)timings.size());
+		writeSummaryJSON(file, "cpuMs", cpuMs);
+		writeSummaryJSON(file, "gpuMs", gpuMs);
+		if (options.startup.coldMs >= 0.0f) {
+			fprintf(file, "  \"timeToFirstFrameMs\": { \"cold\": %.4f, ", options.startup.coldMs);
+			if (options.startup.warmMs >= 0.0f) {
+				fprintf(file, "\"warm\": %.4f },\n", options.startup.warmMs);
+			}
+			else {
+				fprintf(file, "\"warm\": null },\n");
+			}
+		}
+		fprintf(file, "  \"frames\": [\n");
+		for (size_t i = 0; i < timings.size(); i++)
+		{
+			fprintf(file, "    { \"frame\": %i, \"cpuMs\": %.4f, \"gpuMs\": %.4f }%s\n", (int)i, timings[i].cpuMs, timings[i].gpuMs, i + 1 < timings.size() ? "," : "");
+		}
+		fprintf(file, "  ]\n}\n");
+		fclose(file);
+		return true;
+	}
+}
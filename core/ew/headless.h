@@ -0,0 +1,80 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+
+struct GLFWwindow;
+
+namespace ew {
+	//OpenGL context without a window or display, for rendering on CI machines.
+	//Uses an EGL surfaceless context (e.g. Mesa llvmpipe) when core is built with EGL,
+	//otherwise a hidden GLFW window. GL functions are loaded by create.
+	class HeadlessContext {
+	public:
+		HeadlessContext() {};
+		~HeadlessContext();
+		bool create(int majorVersion = 4, int minorVersion = 5);
+		void destroy();
+		inline bool isValid()const { return m_valid; }
+		inline bool isEGL()const { return m_display != nullptr; }
+	private:
+		bool createEGL(int majorVersion, int minorVersion);
+		bool createGLFW(int majorVersion, int minorVersion);
+		void* m_display = nullptr; //EGLDisplay
+		void* m_context = nullptr; //EGLContext
+		GLFWwindow* m_window = nullptr;
+		bool m_valid = false;
+	};
+
+	//Framebuffer with an RGBA8 color texture and a 24 bit depth buffer
+	class RenderTarget {
+	public:
+		RenderTarget() {};
+		~RenderTarget();
+		bool create(int width, int height);
+		void destroy();
+		void bind()const;
+		void readPixels(std::vector<unsigned char>& rgba)const;
+		inline int getWidth()const { return m_width; }
+		inline int getHeight()const { return m_height; }
+		inline unsigned int getFramebuffer()const { return m_framebuffer; }
+		inline unsigned int getColorTexture()const { return m_colorTexture; }
+	private:
+		int m_width = 0;
+		int m_height = 0;
+		unsigned int m_framebuffer = 0;
+		unsigned int m_colorTexture = 0;
+		unsigned int m_depthBuffer = 0;
+	};
+
+	struct FrameTiming {
+		float cpuMs = 0.0f; //Time spent in the frame callback
+		float gpuMs = -1.0f; //GPU time between timestamps queried before and after the callback. -1 if unavailable
+	};
+
+	struct StartupTiming {
+		float coldMs = -1.0f; //Time to first frame with an empty shader program cache. -1 if not measured
+		float warmMs = -1.0f; //The same with the programs the cold start cached. -1 if not measured or caching is disabled
+	};
+
+	struct HeadlessOptions {
+		int width = 1280;
+		int height = 720;
+		int numFrames = 60;
+		float deltaTime = 1.0f / 60.0f; //Fixed step, so that runs render the same images
+		int captureInterval = 0; //Writes a PNG every this many frames. 0 captures only the last frame, -1 none
+		std::string capturePrefix = "frame"; //Captures are named <prefix>_<frame>.png
+		std::string timingsPath; //JSON output. Empty to skip
+		StartupTiming startup; //Reported in the JSON output, e.g. from measureTimeToFirstFrame
+	};
+
+	//Draws one frame into the bound render target
+	typedef std::function<void(int frame, float time, float deltaTime)> HeadlessFrameCallback;
+
+	//Creates everything a frame needs, draws the first frame, then releases it all
+	typedef std::function<void()> HeadlessStartupCallback;
+
+	std::vector<FrameTiming> runHeadless(const HeadlessOptions& options, const HeadlessFrameCallback& renderFrame);
+	StartupTiming measureTimeToFirstFrame(const HeadlessOptions& options, const HeadlessStartupCallback& startup);
+	bool writeFrameTimingsJSON(const std::string& filePath, const HeadlessOptions& options, const std::vector<FrameTiming>& timings);
+}
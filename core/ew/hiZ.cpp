@@ -0,0 +1,275 @@
+#include "hiZ.h"
+#include "glState.h"
+#include "external/glad.h"
+#include <chrono>
+#include <algorithm>
+#include <stdio.h>
+
+//Shader storage bindings used while testing. Chosen to stay clear of MaterialTable (0) and IndirectBatch (1)
+static const int BOUNDS_BINDING = 2;
+static const int VISIBILITY_BINDING = 3;
+
+static const char* DEPTH_VERTEX_SOURCE = R"(#version 430
+layout(location = 0) in vec3 vPos;
+uniform mat4 _Model;
+uniform mat4 _ViewProjection;
+void main(){
+	gl_Position = _ViewProjection * _Model * vec4(vPos, 1.0);
+}
+)";
+
+static const char* DEPTH_FRAGMENT_SOURCE = R"(#version 430
+void main(){
+}
+)";
+
+//Copies the depth buffer into level 0 of the pyramid
+static const char* COPY_SOURCE = R"(#version 430
+layout(local_size_x = 8, local_size_y = 8) in;
+layout(binding = 0) uniform sampler2D _Depth;
+layout(r32f, binding = 0) writeonly uniform image2D _Destination;
+void main(){
+	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+	if (any(greaterThanEqual(texel, imageSize(_Destination)))) return;
+	imageStore(_Destination, texel, vec4(texelFetch(_Depth, texel, 0).r));
+}
+)";
+
+//Each texel takes the farthest depth of the texels it covers in the level above.
+//When the source size is odd, the last row/column also covers the leftover texels.
+static const char* DOWNSAMPLE_SOURCE = R"(#version 430
+layout(local_size_x = 8, local_size_y = 8) in;
+layout(r32f, binding = 0) readonly uniform image2D _Source;
+layout(r32f, binding = 1) writeonly uniform image2D _Destination;
+void main(){
+	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+	ivec2 destinationSize = imageSize(_Destination);
+	if (any(greaterThanEqual(texel, destinationSize))) return;
+	ivec2 sourceSize = imageSize(_Source);
+	ivec2 footprint = ivec2(2);
+	if (texel.x == destinationSize.x - 1 && (sourceSize.x & 1) != 0) footprint.x = 3;
+	if (texel.y == destinationSize.y - 1 && (sourceSize.y & 1) != 0) footprint.y = 3;
+	float depth = 0.0;
+	for (int y = 0; y < footprint.y; y++){
+		for (int x = 0; x < footprint.x; x++){
+			ivec2 source = min(texel * 2 + ivec2(x, y), sourceSize - 1);
+			depth = max(depth, imageLoad(_Source, source).r);
+		}
+	}
+	imageStore(_Destination, texel, vec4(depth));
+}
+)";
+
+//Projects each box to a screen rectangle and its nearest depth, then compares against the
+//farthest occluder depth over that rectangle. Boxes crossing the near plane are always visible.
+static const char* TEST_SOURCE = R"(#version 430
+layout(local_size_x = 64) in;
+struct Bounds{
+	vec4 min;
+	vec4 max;
+};
+layout(std430, binding = 2) readonly buffer BoundsBuffer{
+	Bounds _Bounds[];
+};
+layout(std430, binding = 3) writeonly buffer VisibilityBuffer{
+	uint _Visible[];
+};
+layout(binding = 0) uniform sampler2D _HiZ;
+uniform mat4 _ViewProjection;
+uniform uint _Count;
+uniform int _NumLevels;
+void main(){
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= _Count) return;
+	vec3 boundsMin = _Bounds[index].min.xyz;
+	vec3 boundsMax = _Bounds[index].max.xyz;
+	vec3 ndcMin = vec3(1e30);
+	vec3 ndcMax = vec3(-1e30);
+	for (int i = 0; i < 8; i++){
+		vec3 corner = vec3((i & 1) != 0 ? boundsMax.x : boundsMin.x,
+			(i & 2) != 0 ? boundsMax.y : boundsMin.y,
+			(i & 4) != 0 ? boundsMax.z : boundsMin.z);
+		vec4 clip = _ViewProjection * vec4(corner, 1.0);
+		if (clip.w <= 0.0){
+			_Visible[index] = 1u;
+			return;
+		}
+		vec3 ndc = clip.xyz / clip.w;
+		ndcMin = min(ndcMin, ndc);
+		ndcMax = max(ndcMax, ndc);
+	}
+	vec2 uvMin = clamp(ndcMin.xy * 0.5 + 0.5, 0.0, 1.0);
+	vec2 uvMax = clamp(ndcMax.xy * 0.5 + 0.5, 0.0, 1.0);
+	float nearestDepth = ndcMin.z * 0.5 + 0.5;
+	vec2 sizeInTexels = (uvMax - uvMin) * vec2(textureSize(_HiZ, 0));
+	int level = clamp(int(ceil(log2(max(max(sizeInTexels.x, sizeInTexels.y), 1.0)))), 0, _NumLevels - 1);
+	//Not textureSize(_HiZ, level): llvmpipe returns a single level's size for every invocation in a batch
+	ivec2 levelSize = max(textureSize(_HiZ, 0) >> level, ivec2(1));
+	ivec2 texelMin = min(ivec2(uvMin * vec2(levelSize)), levelSize - 1);
+	ivec2 texelMax = min(ivec2(uvMax * vec2(levelSize)), levelSize - 1);
+	float farthestDepth = max(
+		max(texelFetch(_HiZ, texelMin, level).r, texelFetch(_HiZ, ivec2(texelMax.x, texelMin.y), level).r),
+		max(texelFetch(_HiZ, ivec2(texelMin.x, texelMax.y), level).r, texelFetch(_HiZ, texelMax, level).r));
+	_Visible[index] = nearestDepth <= farthestDepth ? 1u : 0u;
+}
+)";
+
+namespace ew {
+	/// <summary>
+	/// Creates the occluder depth buffer, Hi-Z pyramid and compute programs
+	/// </summary>
+	/// <param name="width">Depth buffer width. Low resolutions are cheaper and only slightly less precise</param>
+	/// <param name="height">Depth buffer height</param>
+	HiZCuller::HiZCuller(int width, int height)
+		:m_width(width), m_height(height)
+	{
+		m_numLevels = 1;
+		while ((width >> m_numLevels) > 0 || (height >> m_numLevels) > 0) {
+			m_numLevels++;
+		}
+
+		glGenTextures(1, &m_depthTexture);
+		ew::state::bindTexture(0, GL_TEXTURE_2D, m_depthTexture);
+		glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT32F, width, height);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glGenFramebuffers(1, &m_framebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depthTexture, 0);
+		glDrawBuffer(GL_NONE);
+		glReadBuffer(GL_NONE);
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+			printf("Hi-Z occluder framebuffer is incomplete\n");
+		}
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		glGenTextures(1, &m_hiZTexture);
+		ew::state::bindTexture(0, GL_TEXTURE_2D, m_hiZTexture);
+		glTexStorage2D(GL_TEXTURE_2D, m_numLevels, GL_R32F, width, height);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		ew::state::bindTexture(0, GL_TEXTURE_2D, 0);
+
+		m_depthShader.setProgram(ew::createShaderProgram(DEPTH_VERTEX_SOURCE, DEPTH_FRAGMENT_SOURCE));
+		m_copyProgram = ew::createComputeProgram(COPY_SOURCE);
+		m_downsampleProgram = ew::createComputeProgram(DOWNSAMPLE_SOURCE);
+		m_testProgram = ew::createComputeProgram(TEST_SOURCE);
+		glGenBuffers(1, &m_boundsBuffer);
+		glGenBuffers(1, &m_visibilityBuffer);
+	}
+	/// <summary>
+	/// Starts drawing occluders into the depth buffer. Changes the framebuffers and viewport until endOccluders.
+	/// </summary>
+	/// <param name="viewProjection">Camera used for both occluders and the boxes tested by cull</param>
+	void HiZCuller::beginOccluders(const ew::Mat4& viewProjection)
+	{
+		m_viewProjection = viewProjection;
+		glGetIntegerv(GL_VIEWPORT, m_previousViewport);
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_previousDrawFramebuffer);
+		glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &m_previousReadFramebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+		glViewport(0, 0, m_width, m_height);
+		ew::state::depthMask(true);
+		ew::state::setEnabled(GL_DEPTH_TEST, true);
+		ew::state::depthFunc(GL_LESS);
+		glClear(GL_DEPTH_BUFFER_BIT);
+		m_depthShader.use();
+		m_depthShader.setMat4("_ViewProjection", viewProjection);
+	}
+	/// <summary>
+	/// Draws a mesh into the occluder depth buffer. Large, simple, opaque meshes make the best occluders.
+	/// </summary>
+	void HiZCuller::drawOccluder(const Mesh& mesh, const ew::Mat4& model)
+	{
+		m_depthShader.setMat4("_Model", model);
+		mesh.draw();
+	}
+	/// <summary>
+	/// Restores the framebuffers and viewport bound before beginOccluders, then builds the Hi-Z pyramid from the occluder depth
+	/// </summary>
+	void HiZCuller::endOccluders()
+	{
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_previousDrawFramebuffer);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, m_previousReadFramebuffer);
+		glViewport(m_previousViewport[0], m_previousViewport[1], m_previousViewport[2], m_previousViewport[3]);
+
+		ew::state::useProgram(m_copyProgram);
+		ew::state::bindTexture(0, GL_TEXTURE_2D, m_depthTexture);
+		glBindImageTexture(0, m_hiZTexture, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+		glDispatchCompute((m_width + 7) / 8, (m_height + 7) / 8, 1);
+
+		ew::state::useProgram(m_downsampleProgram);
+		for (int level = 1; level < m_numLevels; level++)
+		{
+			int levelWidth = std::max(m_width >> level, 1);
+			int levelHeight = std::max(m_height >> level, 1);
+			glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+			glBindImageTexture(0, m_hiZTexture, level - 1, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+			glBindImageTexture(1, m_hiZTexture, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+			glDispatchCompute((levelWidth + 7) / 8, (levelHeight + 7) / 8, 1);
+		}
+		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+	}
+	/// <summary>
+	/// Tests boxes against the pyramid built by endOccluders. Waits for the GPU to return the results,
+	/// so it is best called once per frame with every box at once.
+	/// </summary>
+	/// <param name="worldBounds">World space bounds</param>
+	/// <param name="visible">Entries that are 1 on input are tested and set to 0 if occluded, e.g. after frustum culling.
+	/// Resized to worldBounds.size() with 1s if the sizes differ</param>
+	/// <returns>Number of entries found to be occluded</returns>
+	int HiZCuller::cull(const std::vector<AABB>& worldBounds, std::vector<uint8_t>& visible)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		if (visible.size() != worldBounds.size()) {
+			visible.assign(worldBounds.size(), 1);
+		}
+		//Only upload boxes that are still visible
+		m_tested.clear();
+		m_uploadBounds.clear();
+		for (size_t i = 0; i < worldBounds.size(); i++)
+		{
+			if (!visible[i]) {
+				continue;
+			}
+			const AABB& b = worldBounds[i];
+			float data[8] = { b.min.x, b.min.y, b.min.z, 0.0f, b.max.x, b.max.y, b.max.z, 0.0f };
+			m_uploadBounds.insert(m_uploadBounds.end(), data, data + 8);
+			m_tested.push_back((int)i);
+		}
+		int numOccluded = 0;
+		const uint32_t count = (uint32_t)m_tested.size();
+		if (count > 0) {
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_boundsBuffer);
+			glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(float) * m_uploadBounds.size(), m_uploadBounds.data(), GL_STREAM_DRAW);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_visibilityBuffer);
+			glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(uint32_t) * count, NULL, GL_STREAM_READ);
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BOUNDS_BINDING, m_boundsBuffer);
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, VISIBILITY_BINDING, m_visibilityBuffer);
+
+			ew::state::useProgram(m_testProgram);
+			ew::state::bindTexture(0, GL_TEXTURE_2D, m_hiZTexture);
+			glUniformMatrix4fv(glGetUniformLocation(m_testProgram, "_ViewProjection"), 1, GL_FALSE, &m_viewProjection[0][0]);
+			glUniform1ui(glGetUniformLocation(m_testProgram, "_Count"), count);
+			glUniform1i(glGetUniformLocation(m_testProgram, "_NumLevels"), m_numLevels);
+			glDispatchCompute((count + 63) / 64, 1, 1);
+			glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+
+			m_results.resize(count);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_visibilityBuffer);
+			glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(uint32_t) * count, m_results.data());
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				if (m_results[i] == 0) {
+					visible[m_tested[i]] = 0;
+					numOccluded++;
+				}
+			}
+		}
+		m_stats.numTested = (int)count;
+		m_stats.numOccluded = numOccluded;
+		m_stats.cullMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		return numOccluded;
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include "ewMath/ewMath.h"
+#include "bounds.h"
+#include "mesh.h"
+#include "shader.h"
+
+namespace ew {
+	struct OcclusionStats {
+		int numTested = 0;
+		int numOccluded = 0;
+		float cullMs = 0.0f; //Includes waiting for the GPU to return results
+	};
+
+	//GPU hierarchical-Z occlusion culling.
+	//Occluders are drawn into a low resolution depth buffer, which is reduced into a mip pyramid
+	//holding the farthest depth of each texel's footprint. Bounding boxes are then tested by a compute
+	//shader against the one pyramid level where they cover at most 2x2 texels.
+	//Requires GL 4.3 compute shaders.
+	class HiZCuller {
+	public:
+		HiZCuller(int width = 512, int height = 256);
+		void beginOccluders(const ew::Mat4& viewProjection);
+		void drawOccluder(const Mesh& mesh, const ew::Mat4& model);
+		void endOccluders();
+		int cull(const std::vector<AABB>& worldBounds, std::vector<uint8_t>& visible);
+		inline int getWidth()const { return m_width; }
+		inline int getHeight()const { return m_height; }
+		inline int getNumLevels()const { return m_numLevels; }
+		inline unsigned int getHiZTexture()const { return m_hiZTexture; }
+		inline const OcclusionStats& getStats()const { return m_stats; }
+	private:
+		int m_width, m_height, m_numLevels;
+		unsigned int m_depthTexture = 0;
+		unsigned int m_framebuffer = 0;
+		unsigned int m_hiZTexture = 0;
+		unsigned int m_copyProgram = 0;
+		unsigned int m_downsampleProgram = 0;
+		unsigned int m_testProgram = 0;
+		unsigned int m_boundsBuffer = 0;
+		unsigned int m_visibilityBuffer = 0;
+		Shader m_depthShader = Shader(0u);
+		ew::Mat4 m_viewProjection;
+		int m_previousViewport[4] = {};
+		int m_previousDrawFramebuffer = 0;
+		int m_previousReadFramebuffer = 0;
+		std::vector<int> m_tested; //Indices of the entries uploaded by cull
+		std::vector<float> m_uploadBounds;
+		std::vector<uint32_t> m_results;
+		OcclusionStats m_stats;
+	};
+}
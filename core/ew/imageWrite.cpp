@@ -0,0 +1,30 @@
+#include "imageWrite.h"
+#include <stdio.h>
+#include "external/stb_image_write.h"
+
+namespace ew {
+	/// <summary>
+	/// Writes a PNG file with stb_image_write
+	/// </summary>
+	/// <returns>False if the arguments are invalid or the file could not be written</returns>
+	bool writePNG(const std::string& filePath, int width, int height, int numComponents, const unsigned char* pixels, bool flipVertically)
+	{
+		if (width <= 0 || height <= 0 || numComponents < 1 || numComponents > 4 || pixels == nullptr) {
+			printf("Invalid image for %s\n", filePath.c_str());
+			return false;
+		}
+		//Flipped by starting at the last row with a negative stride, rather than with
+		//stbi_flip_vertically_on_write, which is global and so not safe to toggle across threads
+		int stride = width * numComponents;
+		const unsigned char* firstRow = pixels;
+		if (flipVertically) {
+			firstRow += (size_t)(height - 1) * stride;
+			stride = -stride;
+		}
+		if (!stbi_write_png(filePath.c_str(), width, height, numComponents, firstRow, stride)) {
+			printf("Failed to write %s\n", filePath.c_str());
+			return false;
+		}
+		return true;
+	}
+}
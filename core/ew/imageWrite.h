@@ -0,0 +1,8 @@
+#pragma once
+#include <string>
+
+namespace ew {
+	//Writes 8 bit per channel pixels (1 = gray, 2 = gray alpha, 3 = RGB, 4 = RGBA) as a PNG.
+	//flipVertically writes the last row first, for pixels read back with glReadPixels.
+	bool writePNG(const std::string& filePath, int width, int height, int numComponents, const unsigned char* pixels, bool flipVertically = false);
+}
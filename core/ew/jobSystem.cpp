@@ -0,0 +1,269 @@
+#include "jobSystem.h"
+
+//Set on worker threads, so jobs queued from a worker go to its own deque
+static thread_local const ew::JobSystem* t_jobSystem = nullptr;
+static thread_local int t_jobThread = -1;
+
+namespace ew {
+	/// <summary>
+	/// Starts the worker threads. The calling thread becomes thread 0
+	/// </summary>
+	/// <param name="numWorkers">Threads started in addition to the calling thread. -1 for one per remaining hardware thread</param>
+	JobSystem::JobSystem(int numWorkers)
+	{
+		if (numWorkers < 0) {
+			numWorkers = (int)std::thread::hardware_concurrency() - 1;
+			if (numWorkers < 0) {
+				numWorkers = 0;
+			}
+		}
+		m_mainThread = std::this_thread::get_id();
+		for (int i = 0; i <= numWorkers; i++)
+		{
+			m_deques.push_back(new Deque());
+		}
+		for (int i = 1; i <= numWorkers; i++)
+		{
+			m_workers.emplace_back(&JobSystem::workerLoop, this, i);
+		}
+	}
+	/// <summary>
+	/// Stops the workers. Jobs still queued are dropped, so wait for them first
+	/// </summary>
+	JobSystem::~JobSystem()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_stopping = true;
+		}
+		m_wake.notify_all();
+		for (std::thread& worker : m_workers) {
+			worker.join();
+		}
+		for (Deque* deque : m_deques) {
+			delete deque;
+		}
+	}
+	/// <summary>
+	/// Queues a job on the calling thread's deque
+	/// </summary>
+	/// <param name="job">job.counter, if set, is incremented now and decremented when the job finishes</param>
+	/// <param name="after">If set, the job is only queued once this counter reaches 0</param>
+	void JobSystem::run(const Job& job, JobCounter* after)
+	{
+		if (job.counter) {
+			job.counter->value++;
+		}
+		if (after) {
+			//finish() takes the continuations and zeroes the counter under the same lock
+			std::lock_guard<std::mutex> lock(after->mutex);
+			if (after->value > 0) {
+				after->continuations.push_back(job);
+				return;
+			}
+		}
+		queue(job);
+	}
+	/// <summary>
+	/// Runs queued jobs, stealing from other threads when the calling thread has none, until counter reaches 0
+	/// </summary>
+	void JobSystem::wait(JobCounter& counter)
+	{
+		const int thread = currentThread();
+		uint32_t victimSeed = 0x9E3779B9u;
+		while (counter.value.load() > 0) {
+			if (!tryRunJob(thread, victimSeed)) {
+				std::this_thread::yield();
+			}
+		}
+		//The last job may still be releasing the counter's lock, and the caller may free the counter once this returns
+		std::lock_guard<std::mutex> lock(counter.mutex);
+	}
+
+	/// <summary>
+	/// Pushes a job onto the bottom. Only called by the owning thread
+	/// </summary>
+	/// <returns>False if the deque is full</returns>
+	bool JobSystem::Deque::push(const Job& job)
+	{
+		const int64_t b = bottom.load(std::memory_order_relaxed);
+		const int64_t t = top.load(std::memory_order_acquire);
+		if (b - t >= CAPACITY) {
+			return false;
+		}
+		jobs[b & (CAPACITY - 1)] = job;
+		bottom.store(b + 1, std::memory_order_release);
+		return true;
+	}
+	/// <summary>
+	/// Takes the most recently pushed job. Only called by the owning thread
+	/// </summary>
+	bool JobSystem::Deque::pop(Job& job)
+	{
+		const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+		if (t > b) {
+			//Empty
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+		job = jobs[b & (CAPACITY - 1)];
+		if (t == b) {
+			//Last job, race thieves for it
+			const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+	/// <summary>
+	/// Takes the oldest job. Called by any thread
+	/// </summary>
+	bool JobSystem::Deque::steal(Job& job)
+	{
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t b = bottom.load(std::memory_order_acquire);
+		if (t >= b) {
+			return false;
+		}
+		//The owner can't overwrite this slot before top moves past it, since push refuses to wrap onto unstolen jobs.
+		//If another thread takes the job first, the copy is discarded
+		job = jobs[t & (CAPACITY - 1)];
+		return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Runs jobs until the JobSystem is destroyed, sleeping while nothing is queued
+	/// </summary>
+	void JobSystem::workerLoop(int thread)
+	{
+		t_jobSystem = this;
+		t_jobThread = thread;
+		uint32_t victimSeed = 0x9E3779B9u * (uint32_t)thread;
+		//Spinning a little before sleeping keeps workers responsive to bursts of small jobs
+		const int SPINS_BEFORE_SLEEP = 64;
+		int spins = 0;
+		while (!m_stopping.load()) {
+			if (tryRunJob(thread, victimSeed)) {
+				spins = 0;
+				continue;
+			}
+			if (++spins < SPINS_BEFORE_SLEEP) {
+				std::this_thread::yield();
+				continue;
+			}
+			spins = 0;
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			//queue() increments m_queuedJobs before checking for sleepers, so a job queued after this can't be missed
+			m_sleepingWorkers++;
+			m_wake.wait(lock, [this]() { return m_queuedJobs.load() > 0 || m_stopping.load(); });
+			m_sleepingWorkers--;
+		}
+	}
+	/// <summary>
+	/// Runs one job from the thread's own deque, or stolen from a random other thread
+	/// </summary>
+	/// <param name="thread">Index of the calling thread, or -1 for threads outside the JobSystem, which can only steal</param>
+	/// <returns>False if no job was found</returns>
+	bool JobSystem::tryRunJob(int thread, uint32_t& victimSeed)
+	{
+		Job job;
+		bool found = thread >= 0 && m_deques[thread]->pop(job);
+		if (!found) {
+			//xorshift32
+			victimSeed ^= victimSeed << 13;
+			victimSeed ^= victimSeed >> 17;
+			victimSeed ^= victimSeed << 5;
+			const int numDeques = (int)m_deques.size();
+			const int first = (int)(victimSeed % (uint32_t)numDeques);
+			for (int i = 0; i < numDeques && !found; i++)
+			{
+				const int victim = (first + i) % numDeques;
+				found = victim != thread && m_deques[victim]->steal(job);
+			}
+		}
+		if (!found) {
+			return false;
+		}
+		m_queuedJobs--;
+		execute(job);
+		return true;
+	}
+	void JobSystem::execute(const Job& job)
+	{
+		job.function(job);
+		finish(job);
+	}
+	/// <summary>
+	/// Decrements the job's counter, queuing the counter's continuations if it reaches 0
+	/// </summary>
+	void JobSystem::finish(const Job& job)
+	{
+		JobCounter* counter = job.counter;
+		if (!counter) {
+			return;
+		}
+		//Only the job that may be last takes the lock
+		int value = counter->value.load();
+		while (value > 1) {
+			if (counter->value.compare_exchange_weak(value, value - 1)) {
+				return;
+			}
+		}
+		std::vector<Job> continuations;
+		{
+			std::lock_guard<std::mutex> lock(counter->mutex);
+			if (counter->value.fetch_sub(1) == 1) {
+				continuations.swap(counter->continuations);
+			}
+		}
+		//The counter may be freed by now
+		for (const Job& continuation : continuations) {
+			queue(continuation);
+		}
+	}
+	/// <summary>
+	/// Pushes a job onto the calling thread's deque and wakes a sleeping worker.
+	/// Runs it immediately if the deque is full or the caller isn't one of this JobSystem's threads
+	/// </summary>
+	void JobSystem::queue(const Job& job)
+	{
+		const int thread = currentThread();
+		if (thread < 0) {
+			execute(job);
+			return;
+		}
+		m_queuedJobs++;
+		if (!m_deques[thread]->push(job)) {
+			m_queuedJobs--;
+			execute(job);
+			return;
+		}
+		if (m_sleepingWorkers.load() > 0) {
+			//Taking the lock orders this with a worker between checking m_queuedJobs and sleeping
+			{
+				std::lock_guard<std::mutex> lock(m_sleepMutex);
+			}
+			m_wake.notify_one();
+		}
+	}
+	/// <summary>
+	/// Index of the calling thread in this JobSystem, or -1 if it is neither a worker nor the creating thread
+	/// </summary>
+	int JobSystem::currentThread() const
+	{
+		if (t_jobSystem == this) {
+			return t_jobThread;
+		}
+		return std::this_thread::get_id() == m_mainThread ? 0 : -1;
+	}
+
+	JobSystem& DefaultJobSystem()
+	{
+		static JobSystem jobSystem;
+		return jobSystem;
+	}
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <stdint.h>
+#include <stddef.h>
+
+namespace ew {
+	struct JobCounter;
+
+	//Unit of work. function is called with the job itself, so plain functions can use data, begin and end as arguments
+	struct Job {
+		void (*function)(const Job& job) = nullptr;
+		void* data = nullptr;
+		size_t begin = 0;
+		size_t end = 0;
+		JobCounter* counter = nullptr; //Decremented when the job finishes. Optional
+	};
+
+	//Number of unfinished jobs in a group, plus jobs waiting for the group to finish.
+	//Reuse a counter only after waiting on it
+	struct JobCounter {
+		std::atomic<int> value{ 0 };
+		std::mutex mutex;
+		std::vector<Job> continuations; //Queued when value reaches 0
+	};
+
+	//Work-stealing scheduler. Each thread owns a fixed size Chase-Lev deque: it pushes and pops jobs at the bottom,
+	//while idle threads steal from the top of a random victim. The thread that creates the JobSystem is thread 0 and
+	//runs jobs while it waits. Only that thread and the workers may queue jobs; other threads run them immediately
+	class JobSystem {
+	public:
+		//numWorkers threads are started in addition to the calling thread. -1 for one per remaining hardware thread
+		explicit JobSystem(int numWorkers = -1);
+		~JobSystem();
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		//Queues job, incrementing job.counter. If after is set, the job is only queued once after reaches 0.
+		//Jobs run immediately when the calling thread's deque is full
+		void run(const Job& job, JobCounter* after = nullptr);
+		//Queues f(), a callable taking no arguments
+		template<typename F>
+		void run(F f, JobCounter* counter = nullptr, JobCounter* after = nullptr);
+		//Runs other jobs until counter reaches 0
+		void wait(JobCounter& counter);
+		//Calls f(rangeBegin, rangeEnd) on ranges of at most grainSize indices covering [begin, end), in parallel, and waits for them.
+		//Ranges are split in half recursively, so idle threads steal large ranges first
+		template<typename F>
+		void parallelFor(size_t begin, size_t end, size_t grainSize, const F& f);
+		//Workers plus the creating thread
+		inline int getNumThreads()const { return (int)m_deques.size(); }
+	private:
+		//Fixed capacity Chase-Lev deque (Le et al. 2013, "Correct and Efficient Work-Stealing for Weak Memory Models")
+		struct Deque {
+			static const int64_t CAPACITY = 4096;
+			//On separate cache lines, since thieves write top while the owner writes bottom
+			alignas(64) std::atomic<int64_t> top{ 0 };
+			alignas(64) std::atomic<int64_t> bottom{ 0 };
+			Job jobs[CAPACITY];
+			bool push(const Job& job);
+			bool pop(Job& job);
+			bool steal(Job& job);
+		};
+		void workerLoop(int thread);
+		bool tryRunJob(int thread, uint32_t& victimSeed);
+		void execute(const Job& job);
+		void finish(const Job& job);
+		void queue(const Job& job);
+		int currentThread()const;
+		std::thread::id m_mainThread;
+		std::vector<Deque*> m_deques;
+		std::vector<std::thread> m_workers;
+		std::atomic<int> m_queuedJobs{ 0 };
+		std::atomic<int> m_sleepingWorkers{ 0 };
+		std::atomic<bool> m_stopping{ false };
+		std::mutex m_sleepMutex;
+		std::condition_variable m_wake;
+	};
+
+	//Shared JobSystem, created on first use with one worker per remaining hardware thread.
+	//The thread that first calls this becomes its thread 0, so call it from the main thread at startup
+	JobSystem& DefaultJobSystem();
+
+	template<typename F>
+	inline void JobSystem::run(F f, JobCounter* counter, JobCounter* after) {
+		Job job;
+		job.function = [](const Job& self) {
+			F* callable = static_cast<F*>(self.data);
+			(*callable)();
+			delete callable;
+		};
+		job.data = new F(std::move(f));
+		job.counter = counter;
+		run(job, after);
+	}
+
+	template<typename F>
+	inline void JobSystem::parallelFor(size_t begin, size_t end, size_t grainSize, const F& f) {
+		if (begin >= end) {
+			return;
+		}
+		struct Context {
+			JobSystem* jobSystem;
+			const F* f;
+			size_t grainSize;
+			JobCounter counter;
+		};
+		Context context{ this, &f, grainSize < 1 ? 1 : grainSize, {} };
+		Job job;
+		job.function = [](const Job& range) {
+			Context& shared = *static_cast<Context*>(range.data);
+			size_t rangeEnd = range.end;
+			//Give away the upper half until the rest fits in one grain
+			while (rangeEnd - range.begin > shared.grainSize) {
+				Job upperHalf = range;
+				upperHalf.begin = range.begin + (rangeEnd - range.begin) / 2;
+				upperHalf.end = rangeEnd;
+				upperHalf.counter = &shared.counter;
+				shared.jobSystem->run(upperHalf);
+				rangeEnd = upperHalf.begin;
+			}
+			(*shared.f)(range.begin, rangeEnd);
+		};
+		job.data = &context;
+		job.begin = begin;
+		job.end = end;
+		//The calling thread takes the first range itself
+		job.function(job);
+		wait(context.counter);
+	}
+}
@@ -0,0 +1,28 @@
+#include "json.h"
+#include <stdio.h>
+
+namespace ew {
+	/// <summary>
+	/// Escapes quotes, backslashes and control characters for a JSON string
+	/// </summary>
+	std::string escapeJSON(const char* text)
+	{
+		std::string escaped;
+		for (const char* c = text; c && *c; c++)
+		{
+			if (*c == '"' || *c == '\\') {
+				escaped += '\\';
+				escaped += *c;
+			}
+			else if ((unsigned char)*c < 0x20) {
+				char code[8];
+				snprintf(code, sizeof(code), "\\u%04x", (unsigned char)*c);
+				escaped += code;
+			}
+			else {
+				escaped += *c;
+			}
+		}
+		return escaped;
+	}
+}
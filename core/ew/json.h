@@ -0,0 +1,7 @@
+#pragma once
+#include <string>
+
+namespace ew {
+	//Escapes text for use inside a JSON string literal. nullptr gives an empty string
+	std::string escapeJSON(const char* text);
+}
@@ -0,0 +1,219 @@
+#include "materialTable.h"
+#include "texture.h"
+#include "glState.h"
+#include "external/glad.h"
+#include "external/stb_image.h"
+#include <stdio.h>
+
+namespace ew {
+	const uint32_t NO_TEXTURE_LAYER = 0xFFFFFFFF;
+
+	MaterialTable::MaterialTable(int wrapMode, int filterMode, bool allowBindless)
+		:m_wrapMode(wrapMode), m_filterMode(filterMode)
+	{
+		//glad checks for the extension when it is loaded for the current context
+		m_bindless = allowBindless && GLAD_GL_ARB_bindless_texture;
+		glGenBuffers(1, &m_ssbo);
+	}
+	/// <summary>
+	/// Registers a texture to be shared by materials. Textures are loaded when upload() is called.
+	/// </summary>
+	/// <param name="filePath">Image file path</param>
+	/// <returns>Texture index to use in Material::texture</returns>
+	int MaterialTable::addTexture(const char* filePath)
+	{
+		m_texturePaths.push_back(filePath);
+		m_texturesDirty = true;
+		m_materialsDirty = true;
+		return (int)m_texturePaths.size() - 1;
+	}
+	/// <summary>
+	/// Adds a material to the table
+	/// </summary>
+	/// <returns>Material index as seen by shaders</returns>
+	int MaterialTable::addMaterial(const Material& material)
+	{
+		m_materials.push_back(material);
+		m_materialsDirty = true;
+		return (int)m_materials.size() - 1;
+	}
+	/// <summary>
+	/// Replaces a material, e.g. when editing it in a UI. Takes effect on the next upload()
+	/// </summary>
+	/// <param name="index">Index returned by addMaterial</param>
+	void MaterialTable::setMaterial(int index, const Material& material)
+	{
+		if (index < 0 || index >= (int)m_materials.size()) {
+			printf("Material index %i out of range\n", index);
+			return;
+		}
+		m_materials[index] = material;
+		m_materialsDirty = true;
+	}
+	/// <summary>
+	/// Loads any new textures and uploads all materials to the shader storage buffer.
+	/// Does nothing if nothing changed since the last upload.
+	/// </summary>
+	void MaterialTable::upload()
+	{
+		if (!m_materialsDirty && !m_texturesDirty) {
+			return;
+		}
+		if (m_texturesDirty && m_bindless) {
+			//Handles are immutable once resident, so only textures added since the last upload are loaded
+			for (size_t i = m_textures.size(); i < m_texturePaths.size(); i++)
+			{
+				unsigned int texture = ew::loadTexture(m_texturePaths[i].c_str(), m_wrapMode, m_filterMode);
+				uint64_t handle = 0;
+				if (texture != 0) {
+					handle = glGetTextureHandleARB(texture);
+					glMakeTextureHandleResidentARB(handle);
+				}
+				m_textures.push_back(texture);
+				m_handles.push_back(handle);
+			}
+		}
+		else if (m_texturesDirty) {
+			buildTextureArray();
+		}
+		m_texturesDirty = false;
+
+		std::vector<MaterialGPU> data(m_materials.size());
+		for (size_t i = 0; i < m_materials.size(); i++)
+		{
+			const Material& material = m_materials[i];
+			MaterialGPU& gpu = data[i];
+			bool hasTexture = material.texture >= 0 && material.texture < (int)m_texturePaths.size();
+			uint64_t handle = (hasTexture && m_bindless) ? m_handles[material.texture] : 0;
+			gpu.handle[0] = (uint32_t)(handle & 0xFFFFFFFF);
+			gpu.handle[1] = (uint32_t)(handle >> 32);
+			gpu.layer = (hasTexture && !m_bindless) ? (uint32_t)material.texture : NO_TEXTURE_LAYER;
+			gpu.ambient = material.ambient;
+			gpu.diffuse = material.diffuse;
+			gpu.specular = material.specular;
+			gpu.shine = material.shine;
+			gpu.pad = 0.0f;
+		}
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_ssbo);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(MaterialGPU) * data.size(), data.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		m_materialsDirty = false;
+	}
+	/// <summary>
+	/// Packs every texture into layers of a single texture array. Layers take the size of the first image that loads;
+	/// images of a different size are resampled (nearest neighbor) to fit, and images that fail to load are white.
+	/// </summary>
+	void MaterialTable::buildTextureArray()
+	{
+		if (m_texturePaths.empty()) {
+			return;
+		}
+		std::vector<unsigned char*> images(m_texturePaths.size());
+		std::vector<int> widths(m_texturePaths.size()), heights(m_texturePaths.size());
+		int layerWidth = 0, layerHeight = 0;
+		for (size_t i = 0; i < m_texturePaths.size(); i++)
+		{
+			int numComponents;
+			images[i] = stbi_load(m_texturePaths[i].c_str(), &widths[i], &heights[i], &numComponents, 4);
+			if (images[i] == NULL) {
+				printf("Failed to load image %s\n", m_texturePaths[i].c_str());
+			}
+			else if (layerWidth == 0) {
+				layerWidth = widths[i];
+				layerHeight = heights[i];
+			}
+		}
+		if (layerWidth == 0) {
+			layerWidth = layerHeight = 1;
+		}
+
+		std::vector<unsigned char> layers((size_t)layerWidth * layerHeight * 4 * m_texturePaths.size(), 255);
+		for (size_t i = 0; i < m_texturePaths.size(); i++)
+		{
+			const unsigned char* data = images[i];
+			if (data == NULL) {
+				continue;
+			}
+			unsigned char* layer = &layers[(size_t)layerWidth * layerHeight * 4 * i];
+			for (int y = 0; y < layerHeight; y++)
+			{
+				int srcY = (int)((int64_t)y * heights[i] / layerHeight);
+				for (int x = 0; x < layerWidth; x++)
+				{
+					int srcX = (int)((int64_t)x * widths[i] / layerWidth);
+					const unsigned char* src = &data[((size_t)srcY * widths[i] + srcX) * 4];
+					unsigned char* dst = &layer[((size_t)y * layerWidth + x) * 4];
+					dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = src[3];
+				}
+			}
+			stbi_image_free(images[i]);
+		}
+
+		if (m_textureArray == 0) {
+			glGenTextures(1, &m_textureArray);
+		}
+		ew::state::bindTexture(0, GL_TEXTURE_2D_ARRAY, m_textureArray);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, layerWidth, layerHeight, (GLsizei)m_texturePaths.size(), 0, GL_RGBA, GL_UNSIGNED_BYTE, layers.data());
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, m_wrapMode);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, m_wrapMode);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, ew::mipmapMinFilter(m_filterMode));
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, m_filterMode);
+		glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+		ew::state::bindTexture(0, GL_TEXTURE_2D_ARRAY, 0);
+	}
+	/// <summary>
+	/// Binds the material buffer, and the texture array when not using bindless textures
+	/// </summary>
+	/// <param name="bufferBinding">Shader storage buffer binding point. Must match getShaderHeader</param>
+	/// <param name="textureUnit">Texture unit for the texture array. Set _MaterialTextures to this unit</param>
+	void MaterialTable::bind(unsigned int bufferBinding, unsigned int textureUnit) const
+	{
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bufferBinding, m_ssbo);
+		if (!m_bindless) {
+			ew::state::bindTexture(textureUnit, GL_TEXTURE_2D_ARRAY, m_textureArray);
+		}
+	}
+	/// <summary>
+	/// GLSL declarations for the material buffer, to be inserted after #version (see ew::Shader).
+	/// Provides _Materials[] and sampleMaterial(uint materialIndex, vec2 uv).
+	/// The material index must be dynamically uniform (per draw or per instance).
+	/// </summary>
+	std::string MaterialTable::getShaderHeader(unsigned int bufferBinding) const
+	{
+		std::string header;
+		if (m_bindless) {
+			header += "#extension GL_ARB_bindless_texture : require\n";
+		}
+		header +=
+			"struct Material{\n"
+			"	uvec2 handle;\n"
+			"	uint layer;\n"
+			"	float ambient;\n"
+			"	float diffuse;\n"
+			"	float specular;\n"
+			"	float shine;\n"
+			"	float pad;\n"
+			"};\n"
+			"layout(std430, binding = " + std::to_string(bufferBinding) + ") readonly buffer MaterialBuffer{\n"
+			"	Material _Materials[];\n"
+			"};\n";
+		if (m_bindless) {
+			header +=
+				"vec4 sampleMaterial(uint materialIndex, vec2 uv){\n"
+				"	uvec2 handle = _Materials[materialIndex].handle;\n"
+				"	if (handle == uvec2(0)) return vec4(1.0);\n"
+				"	return texture(sampler2D(handle), uv);\n"
+				"}\n";
+		}
+		else {
+			header +=
+				"uniform sampler2DArray _MaterialTextures;\n"
+				"vec4 sampleMaterial(uint materialIndex, vec2 uv){\n"
+				"	uint layer = _Materials[materialIndex].layer;\n"
+				"	if (layer == 0xFFFFFFFFu) return vec4(1.0);\n"
+				"	return texture(_MaterialTextures, vec3(uv, float(layer)));\n"
+				"}\n";
+		}
+		return header;
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace ew {
+	//Lighting parameters for a single material
+	struct Material {
+		int texture = -1; //Index returned by MaterialTable::addTexture, -1 for none
+		float ambient = 0.1f;
+		float diffuse = 0.25f;
+		float specular = 1.0f;
+		float shine = 128.0f;
+	};
+
+	//Material as laid out in the std430 shader storage buffer (32 bytes)
+	struct MaterialGPU {
+		uint32_t handle[2]; //Bindless texture handle (uvec2). Unused in texture array mode
+		uint32_t layer; //Texture array layer. Unused in bindless mode
+		float ambient;
+		float diffuse;
+		float specular;
+		float shine;
+		float pad;
+	};
+
+	//Stores every material of a scene in a single shader storage buffer so draws can index them
+	//instead of binding a texture per material. Uses ARB_bindless_texture when available,
+	//otherwise packs all textures into one GL_TEXTURE_2D_ARRAY (e.g. Mesa llvmpipe).
+	class MaterialTable {
+	public:
+		MaterialTable(int wrapMode, int filterMode, bool allowBindless = true);
+		int addTexture(const char* filePath);
+		int addMaterial(const Material& material);
+		//Changing only materials re-uploads the material buffer without reloading textures
+		void setMaterial(int index, const Material& material);
+		inline const Material& getMaterial(int index)const { return m_materials[index]; }
+		void upload();
+		void bind(unsigned int bufferBinding = 0, unsigned int textureUnit = 0) const;
+		std::string getShaderHeader(unsigned int bufferBinding = 0) const;
+		inline bool isBindless()const { return m_bindless; }
+		inline int getNumMaterials()const { return (int)m_materials.size(); }
+	private:
+		void buildTextureArray();
+		bool m_bindless = false;
+		bool m_texturesDirty = true;
+		bool m_materialsDirty = true;
+		int m_wrapMode;
+		int m_filterMode;
+		unsigned int m_ssbo = 0;
+		unsigned int m_textureArray = 0;
+		std::vector<std::string> m_texturePaths;
+		std::vector<unsigned int> m_textures; //Bindless mode only
+		std::vector<uint64_t> m_handles; //Bindless mode only
+		std::vector<Material> m_materials;
+	};
+}
@@ -5,6 +5,7 @@
 #include "mesh.h"
 #include "ewMath/ewMath.h"
 #include "external/glad.h"
+#include "glState.h"
 
 namespace ew {
 	Mesh::Mesh(const MeshData& meshData)
@@ -15,7 +16,7 @@ namespace ew {
 	{
 		if (!m_initialized) {
 			glGenVertexArrays(1, &m_vao);
-			glBindVertexArray(m_vao);
+			ew::state::bindVertexArray(m_vao);
 
 			glGenBuffers(1, &m_vbo);
 			glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
@@ -37,7 +38,7 @@ namespace ew {
 			m_initialized = true;
 		}
 
-		glBindVertexArray(m_vao);
+		ew::state::bindVertexArray(m_vao);
 		glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
 
@@ -49,14 +50,15 @@ namespace ew {
 		}
 		m_numVertices = meshData.vertices.size();
 		m_numIndices = meshData.indices.size();
+		m_bounds = meshData.bounds;
 
-		glBindVertexArray(0);
+		ew::state::bindVertexArray(0);
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 	void Mesh::draw(ew::DrawMode drawMode) const
 	{
-		glBindVertexArray(m_vao);
+		ew::state::bindVertexArray(m_vao);
 		if (drawMode == DrawMode::TRIANGLES) {
 			glDrawElements(GL_TRIANGLES, m_numIndices, GL_UNSIGNED_INT, NULL);
 		}
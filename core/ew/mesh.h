@@ -4,6 +4,7 @@
 
 #pragma once
 #include "ewMath/ewMath.h"
+#include "bounds.h"
 
 namespace ew {
 	struct Vertex {
@@ -15,6 +16,7 @@ namespace ew {
 	struct MeshData {
 		std::vector<Vertex> vertices;
 		std::vector<unsigned int> indices;
+		AABB bounds; //Local space bounds of vertices
 	};
 
 	enum class DrawMode {
@@ -30,6 +32,8 @@ namespace ew {
 		void draw(DrawMode drawMode = DrawMode::TRIANGLES)const;
 		inline int getNumVertices()const { return m_numVertices; }
 		inline int getNumIndices()const { return m_numIndices; }
+		inline unsigned int getVAO()const { return m_vao; }
+		inline const AABB& getBounds()const { return m_bounds; }
 	private:
 		bool m_initialized = false;
 		unsigned int m_vao = 0;
@@ -37,5 +41,6 @@ namespace ew {
 		unsigned int m_ebo = 0;
 		int m_numVertices = 0;
 		int m_numIndices = 0;
+		AABB m_bounds;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,495 @@
+#include "occlusionRasterizer.h"
+#include "profiler.h"
+#include "jobSystem.h"
+#include "ewMath/simdLanes.h"
+#include <algorithm>
+#include <chrono>
+
+//Pixels are rasterized and tested SIMD_WIDTH at a time
+#if defined(EW_SIMD_LANES)
+static const int SIMD_WIDTH = (int)ew::simd::LANE_COUNT;
+#else
+static const int SIMD_WIDTH = 4;
+#endif
+
+//Tiles are whole SIMD groups wide, and small enough that a 256x128 buffer has 64 of them to share between threads
+static const int TILE_WIDTH = 32;
+static const int TILE_HEIGHT = 16;
+//Below this much work per thread, starting threads costs more than it saves
+static const int MIN_VERTICES_PER_THREAD = 4096;
+static const int MIN_TRIANGLES_PER_THREAD = 2048;
+static const int MIN_BOUNDS_PER_THREAD = 1024;
+
+/// <summary>
+/// Number of threads worth starting for count items
+/// </summary>
+static int threadsFor(int count, int numThreads, int minPerThread) {
+	int maxThreads = count / minPerThread;
+	if (numThreads > maxThreads) {
+		numThreads = maxThreads;
+	}
+	return numThreads < 1 ? 1 : numThreads;
+}
+
+/// <summary>
+/// Splits [0, count) into numThreads contiguous chunks and calls function(thread, begin, end) for each
+/// as jobs on DefaultJobSystem, running the first chunk on the calling thread
+/// </summary>
+template<typename Function>
+static void runChunks(int count, int numThreads, const Function& function) {
+	int chunk = (count + numThreads - 1) / numThreads;
+	ew::DefaultJobSystem().parallelFor(0, numThreads, 1, [&](size_t first, size_t last) {
+		for (size_t i = first; i < last; i++)
+		{
+			int begin = (int)i * chunk;
+			int end = begin + chunk < count ? begin + chunk : count;
+			if (begin < end || i == 0) {
+				function((int)i, begin, end);
+			}
+		}
+	});
+}
+
+//Triangles are clipped to the near plane, and to a guard band twice the size of the screen so that edge
+//functions stay small enough for float precision. Each plane keeps clip space points with Dot(plane, p) >= 0
+static const float GUARD_BAND = 2.0f;
+static const int NUM_CLIP_PLANES = 5;
+static const float CLIP_PLANES[NUM_CLIP_PLANES][4] = {
+	{ 0, 0, 1, 1 }, //Near, -w <= z
+	{ 1, 0, 0, GUARD_BAND }, { -1, 0, 0, GUARD_BAND },
+	{ 0, 1, 0, GUARD_BAND }, { 0, -1, 0, GUARD_BAND }
+};
+
+static inline float clipDistance(const ew::Vec4& p, const float* plane) {
+	return plane[0] * p.x + plane[1] * p.y + plane[2] * p.z + plane[3] * p.w;
+}
+
+/// <summary>
+/// Bit n is set when p is outside clip plane n
+/// </summary>
+static int clipOutcode(const ew::Vec4& p) {
+	float guardW = GUARD_BAND * p.w;
+	return (p.z < -p.w) | ((p.x < -guardW) << 1) | ((p.x > guardW) << 2) | ((p.y < -guardW) << 3) | ((p.y > guardW) << 4);
+}
+
+/// <summary>
+/// Clips a convex polygon in place against one plane (Sutherland-Hodgman)
+/// </summary>
+/// <param name="polygon">Needs room for one more vertex than numVertices</param>
+/// <returns>New number of vertices</returns>
+static int clipPolygon(ew::Vec4* polygon, int numVertices, const float* plane) {
+	ew::Vec4 input[3 + NUM_CLIP_PLANES];
+	std::copy(polygon, polygon + numVertices, input);
+	int numOutput = 0;
+	for (int k = 0; k < numVertices; k++)
+	{
+		const ew::Vec4& a = input[k];
+		const ew::Vec4& b = input[(k + 1) % numVertices];
+		float da = clipDistance(a, plane), db = clipDistance(b, plane);
+		if (da >= 0.0f) {
+			polygon[numOutput++] = a;
+		}
+		if ((da >= 0.0f) != (db >= 0.0f)) {
+			float t = da / (da - db);
+			polygon[numOutput++] = ew::Vec4(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t);
+		}
+	}
+	return numOutput;
+}
+
+namespace ew {
+	/// <param name="width">Rounded up to a whole number of 32 pixel tiles</param>
+	/// <param name="height">Rounded up to a whole number of 16 pixel tiles</param>
+	OcclusionRasterizer::OcclusionRasterizer(int width, int height)
+	{
+		m_tilesX = (std::max(width, 1) + TILE_WIDTH - 1) / TILE_WIDTH;
+		m_tilesY = (std::max(height, 1) + TILE_HEIGHT - 1) / TILE_HEIGHT;
+		m_width = m_tilesX * TILE_WIDTH;
+		m_height = m_tilesY * TILE_HEIGHT;
+		m_depth.assign(m_width * m_height, 1.0f);
+		m_tileMaxDepth.assign(m_tilesX * m_tilesY, 1.0f);
+	}
+	/// <summary>
+	/// Clears the occluder list for a new view
+	/// </summary>
+	/// <param name="viewProjection">Projection * View</param>
+	void OcclusionRasterizer::beginOccluders(const ew::Mat4& viewProjection)
+	{
+		m_viewProjection = viewProjection;
+		m_occluders.clear();
+		m_stats.numOccluders = 0;
+		m_stats.numTriangles = 0;
+	}
+	void OcclusionRasterizer::addOccluder(const MeshData& meshData, const ew::Mat4& model)
+	{
+		int firstVertex = m_occluders.empty() ? 0 : m_occluders.back().firstVertex + (int)m_occluders.back().meshData->vertices.size();
+		m_occluders.push_back({ &meshData, model, firstVertex, m_stats.numTriangles });
+		m_stats.numOccluders++;
+		m_stats.numTriangles += (int)meshData.indices.size() / 3;
+	}
+	/// <summary>
+	/// Rasterizes every occluder added since beginOccluders into the depth buffer.
+	/// Vertices are transformed and triangles set up and binned in parallel chunks, then threads take tiles
+	/// from a shared counter until all are rasterized.
+	/// </summary>
+	/// <param name="numThreads">Uses up to this many threads, including the calling thread</param>
+	void OcclusionRasterizer::endOccluders(int numThreads)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		const int numTiles = m_tilesX * m_tilesY;
+		int numVertices = m_occluders.empty() ? 0 : m_occluders.back().firstVertex + (int)m_occluders.back().meshData->vertices.size();
+		m_clipVertices.resize(numVertices);
+		runChunks(numVertices, threadsFor(numVertices, numThreads, MIN_VERTICES_PER_THREAD), [this](int, int begin, int end) {
+			EW_PROFILE_SCOPE("Transform occluders");
+			transformVertices(begin, end);
+		});
+
+		//Each setup thread bins into its own lists, so binning needs no locks
+		m_numSetupThreads = threadsFor(m_stats.numTriangles, numThreads, MIN_TRIANGLES_PER_THREAD);
+		if ((int)m_triangles.size() < m_numSetupThreads) {
+			m_triangles.resize(m_numSetupThreads);
+		}
+		m_bins.resize(std::max((int)m_bins.size(), m_numSetupThreads * numTiles));
+		for (int i = 0; i < m_numSetupThreads; i++)
+		{
+			m_triangles[i].clear();
+			for (int tile = 0; tile < numTiles; tile++)
+			{
+				m_bins[i * numTiles + tile].clear();
+			}
+		}
+		runChunks(m_stats.numTriangles, m_numSetupThreads, [this](int thread, int begin, int end) {
+			EW_PROFILE_SCOPE("Setup triangles");
+			setupTriangles(thread, begin, end);
+		});
+		m_stats.numTrianglesRasterized = 0;
+		for (int i = 0; i < m_numSetupThreads; i++)
+		{
+			m_stats.numTrianglesRasterized += (int)m_triangles[i].size();
+		}
+
+		m_nextTile = 0;
+		int rasterThreads = std::max(1, std::min(numThreads, numTiles));
+		ew::DefaultJobSystem().parallelFor(0, rasterThreads, 1, [this](size_t first, size_t last) {
+			for (size_t i = first; i < last; i++)
+			{
+				rasterizeTiles();
+			}
+		});
+		m_stats.rasterizeMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+	/// <summary>
+	/// Transforms the vertices [begin, end) of all occluders, in order, to clip space
+	/// </summary>
+	void OcclusionRasterizer::transformVertices(int begin, int end)
+	{
+		if (begin >= end) {
+			return;
+		}
+		//Last occluder starting at or before begin
+		auto it = std::upper_bound(m_occluders.begin(), m_occluders.end(), begin,
+			[](int vertex, const Occluder& occluder) { return vertex < occluder.firstVertex; }) - 1;
+		for (int i = begin; i < end; it++)
+		{
+			const std::vector<Vertex>& vertices = it->meshData->vertices;
+			ew::Mat4 modelViewProjection = m_viewProjection * it->model;
+			int occluderEnd = std::min(end, it->firstVertex + (int)vertices.size());
+			for (; i < occluderEnd; i++)
+			{
+				m_clipVertices[i] = modelViewProjection * ew::Vec4(vertices[i - it->firstVertex].pos, 1.0f);
+			}
+		}
+	}
+	/// <summary>
+	/// Clips the triangles [begin, end) of all occluders and bins them
+	/// </summary>
+	void OcclusionRasterizer::setupTriangles(int thread, int begin, int end)
+	{
+		if (begin >= end) {
+			return;
+		}
+		auto it = std::upper_bound(m_occluders.begin(), m_occluders.end(), begin,
+			[](int triangle, const Occluder& occluder) { return triangle < occluder.firstTriangle; }) - 1;
+		for (int i = begin; i < end; it++)
+		{
+			const std::vector<unsigned int>& indices = it->meshData->indices;
+			const ew::Vec4* vertices = &m_clipVertices[it->firstVertex];
+			int occluderEnd = std::min(end, it->firstTriangle + (int)indices.size() / 3);
+			for (; i < occluderEnd; i++)
+			{
+				const unsigned int* triangle = &indices[(i - it->firstTriangle) * 3];
+				ew::Vec4 v[3] = { vertices[triangle[0]], vertices[triangle[1]], vertices[triangle[2]] };
+				int outside[3] = { clipOutcode(v[0]), clipOutcode(v[1]), clipOutcode(v[2]) };
+				if ((outside[0] | outside[1] | outside[2]) == 0) {
+					addScreenTriangle(thread, v[0], v[1], v[2]);
+				}
+				else if ((outside[0] & outside[1] & outside[2]) == 0) {
+					//Sutherland-Hodgman against each plane a vertex is outside of, then fanned into triangles
+					ew::Vec4 polygon[3 + NUM_CLIP_PLANES] = { v[0], v[1], v[2] };
+					int numPolygon = 3;
+					for (int plane = 0; plane < NUM_CLIP_PLANES; plane++)
+					{
+						if ((outside[0] | outside[1] | outside[2]) & (1 << plane)) {
+							numPolygon = clipPolygon(polygon, numPolygon, CLIP_PLANES[plane]);
+						}
+					}
+					for (int k = 2; k < numPolygon; k++)
+					{
+						addScreenTriangle(thread, polygon[0], polygon[k - 1], polygon[k]);
+					}
+				}
+			}
+		}
+	}
+	/// <summary>
+	/// Projects a clipped triangle and adds it to the bins of the tiles its bounding box overlaps. Back facing, degenerate and off screen triangles are dropped.
+	/// </summary>
+	void OcclusionRasterizer::addScreenTriangle(int thread, const ew::Vec4& a, const ew::Vec4& b, const ew::Vec4& c)
+	{
+		//With every w > 0, the sign of this determinant is the sign of the projected area. Most back faces
+		//are dropped here, before the divides
+		float orientation = a.x * (b.y * c.w - c.y * b.w) - b.x * (a.y * c.w - c.y * a.w) + c.x * (a.y * b.w - b.y * a.w);
+		if (!(orientation > 0.0f)) {
+			return;
+		}
+		const ew::Vec4* clip[3] = { &a, &b, &c };
+		float x[3], y[3], z[3];
+		for (int k = 0; k < 3; k++)
+		{
+			float inverseW = 1.0f / clip[k]->w;
+			x[k] = (clip[k]->x * inverseW * 0.5f + 0.5f) * m_width;
+			y[k] = (clip[k]->y * inverseW * 0.5f + 0.5f) * m_height;
+			z[k] = clip[k]->z * inverseW * 0.5f + 0.5f;
+		}
+		float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+		if (!(area > 0.0f)) {
+			return;
+		}
+		//Pixels whose centers are within the bounding box
+		ScreenTriangle triangle;
+		triangle.minX = std::max(0, (int)ceilf(std::min({ x[0], x[1], x[2] }) - 0.5f));
+		triangle.minY = std::max(0, (int)ceilf(std::min({ y[0], y[1], y[2] }) - 0.5f));
+		triangle.maxX = std::min(m_width - 1, (int)floorf(std::max({ x[0], x[1], x[2] }) - 0.5f));
+		triangle.maxY = std::min(m_height - 1, (int)floorf(std::max({ y[0], y[1], y[2] }) - 0.5f));
+		if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) {
+			return;
+		}
+		for (int k = 0; k < 3; k++)
+		{
+			int next = (k + 1) % 3;
+			triangle.edgeA[k] = y[k] - y[next];
+			triangle.edgeB[k] = x[next] - x[k];
+			triangle.edgeC[k] = x[k] * y[next] - x[next] * y[k];
+		}
+		float inverseArea = 1.0f / area;
+		triangle.zA = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) * inverseArea;
+		triangle.zB = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) * inverseArea;
+		triangle.zC = z[0] - triangle.zA * x[0] - triangle.zB * y[0];
+
+		std::vector<ScreenTriangle>& triangles = m_triangles[thread];
+		int index = (int)triangles.size();
+		triangles.push_back(triangle);
+		const int numTiles = m_tilesX * m_tilesY;
+		for (int tileY = triangle.minY / TILE_HEIGHT; tileY <= triangle.maxY / TILE_HEIGHT; tileY++)
+		{
+			for (int tileX = triangle.minX / TILE_WIDTH; tileX <= triangle.maxX / TILE_WIDTH; tileX++)
+			{
+				m_bins[thread * numTiles + tileY * m_tilesX + tileX].push_back(index);
+			}
+		}
+	}
+	/// <summary>
+	/// Rasterizes tiles taken from m_nextTile until none are left
+	/// </summary>
+	void OcclusionRasterizer::rasterizeTiles()
+	{
+		EW_PROFILE_SCOPE("Rasterize tiles");
+		const int numTiles = m_tilesX * m_tilesY;
+		for (int tile = m_nextTile++; tile < numTiles; tile = m_nextTile++)
+		{
+			rasterizeTile(tile);
+		}
+	}
+	/// <summary>
+	/// Clears a tile and keeps the nearest depth of its binned triangles at each pixel center
+	/// </summary>
+	void OcclusionRasterizer::rasterizeTile(int tile)
+	{
+		const int numTiles = m_tilesX * m_tilesY;
+		const int tileX0 = (tile % m_tilesX) * TILE_WIDTH;
+		const int tileY0 = (tile / m_tilesX) * TILE_HEIGHT;
+		for (int row = tileY0; row < tileY0 + TILE_HEIGHT; row++)
+		{
+			std::fill_n(&m_depth[row * m_width + tileX0], TILE_WIDTH, 1.0f);
+		}
+		for (int thread = 0; thread < m_numSetupThreads; thread++)
+		{
+			for (int index : m_bins[thread * numTiles + tile])
+			{
+				const ScreenTriangle& t = m_triangles[thread][index];
+				int minX = std::max(t.minX, tileX0), maxX = std::min(t.maxX, tileX0 + TILE_WIDTH - 1);
+				int minY = std::max(t.minY, tileY0), maxY = std::min(t.maxY, tileY0 + TILE_HEIGHT - 1);
+#if defined(EW_SIMD_LANES)
+				//Groups are aligned to the tile. Lanes outside the bounding box fail the edge tests
+				minX &= ~(SIMD_WIDTH - 1);
+				const simd::Lanes zero = simd::splat(0.0f);
+				const simd::Lanes laneCenters = simd::ramp(0.5f);
+				for (int y = minY; y <= maxY; y++)
+				{
+					float centerY = y + 0.5f;
+					simd::Lanes e0Row = simd::splat(t.edgeB[0] * centerY + t.edgeC[0]);
+					simd::Lanes e1Row = simd::splat(t.edgeB[1] * centerY + t.edgeC[1]);
+					simd::Lanes e2Row = simd::splat(t.edgeB[2] * centerY + t.edgeC[2]);
+					simd::Lanes zRow = simd::splat(t.zB * centerY + t.zC);
+					float* depthRow = &m_depth[y * m_width];
+					for (int x = minX; x <= maxX; x += SIMD_WIDTH)
+					{
+						simd::Lanes centerX = simd::add(simd::splat((float)x), laneCenters);
+						simd::Lanes e0 = simd::add(simd::mul(simd::splat(t.edgeA[0]), centerX), e0Row);
+						simd::Lanes e1 = simd::add(simd::mul(simd::splat(t.edgeA[1]), centerX), e1Row);
+						simd::Lanes e2 = simd::add(simd::mul(simd::splat(t.edgeA[2]), centerX), e2Row);
+						simd::Lanes inside = simd::bitAnd(simd::bitAnd(simd::greaterEqual(e0, zero), simd::greaterEqual(e1, zero)), simd::greaterEqual(e2, zero));
+						if (simd::laneBits(inside) == 0) {
+							continue;
+						}
+						simd::Lanes depth = simd::load(depthRow + x);
+						simd::Lanes z = simd::add(simd::mul(simd::splat(t.zA), centerX), zRow);
+						simd::store(depthRow + x, simd::select(inside, simd::minimum(depth, z), depth));
+					}
+				}
+#else
+				for (int y = minY; y <= maxY; y++)
+				{
+					float centerY = y + 0.5f;
+					float* depthRow = &m_depth[y * m_width];
+					for (int x = minX; x <= maxX; x++)
+					{
+						float centerX = x + 0.5f;
+						if (t.edgeA[0] * centerX + t.edgeB[0] * centerY + t.edgeC[0] >= 0.0f &&
+							t.edgeA[1] * centerX + t.edgeB[1] * centerY + t.edgeC[1] >= 0.0f &&
+							t.edgeA[2] * centerX + t.edgeB[2] * centerY + t.edgeC[2] >= 0.0f) {
+							float z = t.zA * centerX + t.zB * centerY + t.zC;
+							depthRow[x] = z < depthRow[x] ? z : depthRow[x];
+						}
+					}
+				}
+#endif
+			}
+		}
+		float maxDepth = 0.0f;
+		for (int row = tileY0; row < tileY0 + TILE_HEIGHT; row++)
+		{
+			const float* depthRow = &m_depth[row * m_width];
+			for (int x = tileX0; x < tileX0 + TILE_WIDTH; x++)
+			{
+				maxDepth = depthRow[x] > maxDepth ? depthRow[x] : maxDepth;
+			}
+		}
+		m_tileMaxDepth[tile] = maxDepth;
+	}
+	/// <summary>
+	/// Tests a world space box against the depth buffer from the last endOccluders.
+	/// The box's screen rectangle at its nearest depth is compared with every pixel it overlaps, so the test
+	/// is conservative: boxes crossing the near plane are never occluded.
+	/// </summary>
+	bool OcclusionRasterizer::isOccluded(const AABB& bounds) const
+	{
+		float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+		float minZ = FLT_MAX;
+		for (int corner = 0; corner < 8; corner++)
+		{
+			ew::Vec4 p((corner & 1) ? bounds.max.x : bounds.min.x, (corner & 2) ? bounds.max.y : bounds.min.y, (corner & 4) ? bounds.max.z : bounds.min.z, 1.0f);
+			ew::Vec4 clip = m_viewProjection * p;
+			if (clip.z + clip.w < 0.0f || clip.w <= 0.0f) {
+				return false;
+			}
+			float inverseW = 1.0f / clip.w;
+			float x = (clip.x * inverseW * 0.5f + 0.5f) * m_width;
+			float y = (clip.y * inverseW * 0.5f + 0.5f) * m_height;
+			float z = clip.z * inverseW * 0.5f + 0.5f;
+			minX = std::min(minX, x); maxX = std::max(maxX, x);
+			minY = std::min(minY, y); maxY = std::max(maxY, y);
+			minZ = std::min(minZ, z);
+		}
+		//Off screen boxes are left to frustum culling
+		if (maxX < 0.0f || maxY < 0.0f || minX >= m_width || minY >= m_height) {
+			return false;
+		}
+		//Every on screen pixel the rectangle touches
+		int x0 = std::max((int)minX, 0), y0 = std::max((int)minY, 0);
+		int x1 = std::min((int)maxX, m_width - 1), y1 = std::min((int)maxY, m_height - 1);
+		for (int tileY = y0 / TILE_HEIGHT; tileY <= y1 / TILE_HEIGHT; tileY++)
+		{
+			for (int tileX = x0 / TILE_WIDTH; tileX <= x1 / TILE_WIDTH; tileX++)
+			{
+				//The whole tile is nearer than the box
+				if (m_tileMaxDepth[tileY * m_tilesX + tileX] < minZ) {
+					continue;
+				}
+				int tileMinX = std::max(x0, tileX * TILE_WIDTH), tileMaxX = std::min(x1, tileX * TILE_WIDTH + TILE_WIDTH - 1);
+				int tileMinY = std::max(y0, tileY * TILE_HEIGHT), tileMaxY = std::min(y1, tileY * TILE_HEIGHT + TILE_HEIGHT - 1);
+				for (int y = tileMinY; y <= tileMaxY; y++)
+				{
+					const float* depthRow = &m_depth[y * m_width];
+					int x = tileMinX;
+#if defined(EW_SIMD_LANES)
+					const simd::Lanes boxDepth = simd::splat(minZ);
+					for (; x + SIMD_WIDTH - 1 <= tileMaxX; x += SIMD_WIDTH)
+					{
+						if (simd::laneBits(simd::greaterEqual(simd::load(depthRow + x), boxDepth)) != 0) {
+							return false;
+						}
+					}
+#endif
+					for (; x <= tileMaxX; x++)
+					{
+						if (depthRow[x] >= minZ) {
+							return false;
+						}
+					}
+				}
+			}
+		}
+		return true;
+	}
+	/// <summary>
+	/// Tests the entries that are still visible, e.g. after frustum culling
+	/// </summary>
+	/// <param name="worldBounds">World space bounds of every object</param>
+	/// <param name="visible">Entries with 1 are tested and set to 0 if occluded. Resized to worldBounds with 1 if the sizes differ</param>
+	/// <param name="numThreads">Splits the entries across up to this many threads, including the calling thread</param>
+	/// <returns>Number of visible entries</returns>
+	int OcclusionRasterizer::cull(const std::vector<AABB>& worldBounds, std::vector<uint8_t>& visible, int numThreads)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		const int count = (int)worldBounds.size();
+		if ((int)visible.size() != count) {
+			visible.assign(count, 1);
+		}
+		numThreads = threadsFor(count, numThreads, MIN_BOUNDS_PER_THREAD);
+		std::vector<int> threadTested(numThreads, 0), threadOccluded(numThreads, 0);
+		runChunks(count, numThreads, [&](int thread, int begin, int end) {
+			EW_PROFILE_SCOPE("Test bounds");
+			for (int i = begin; i < end; i++)
+			{
+				if (!visible[i]) {
+					continue;
+				}
+				threadTested[thread]++;
+				if (isOccluded(worldBounds[i])) {
+					visible[i] = 0;
+					threadOccluded[thread]++;
+				}
+			}
+		});
+		m_stats.numTested = 0;
+		m_stats.numOccluded = 0;
+		for (int i = 0; i < numThreads; i++)
+		{
+			m_stats.numTested += threadTested[i];
+			m_stats.numOccluded += threadOccluded[i];
+		}
+		m_stats.cullMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		return m_stats.numTested - m_stats.numOccluded;
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <stdint.h>
+#include "ewMath/ewMath.h"
+#include "bounds.h"
+#include "mesh.h"
+
+namespace ew {
+	struct RasterizerStats {
+		int numOccluders = 0;
+		int numTriangles = 0; //Occluder triangles submitted
+		int numTrianglesRasterized = 0; //After near plane clipping, back face and off screen rejection
+		float rasterizeMs = 0.0f;
+		int numTested = 0;
+		int numOccluded = 0;
+		float cullMs = 0.0f;
+	};
+
+	//CPU occlusion culling against a low resolution depth buffer.
+	//Occluder triangles are binned into screen tiles, then each tile is rasterized 4 (SSE) or 8 (AVX) pixels
+	//at a time, with tiles shared between threads. Bounding boxes are occluded when their nearest depth is
+	//behind the buffer at every pixel they cover. Does not use the GPU.
+	//Occluders must be closed meshes with counter-clockwise front faces.
+	class OcclusionRasterizer {
+	public:
+		OcclusionRasterizer(int width = 256, int height = 128);
+		void beginOccluders(const ew::Mat4& viewProjection);
+		void addOccluder(const MeshData& meshData, const ew::Mat4& model); //meshData must stay alive until endOccluders
+		void endOccluders(int numThreads = 1);
+		bool isOccluded(const AABB& worldBounds)const;
+		int cull(const std::vector<AABB>& worldBounds, std::vector<uint8_t>& visible, int numThreads = 1);
+		inline int getWidth()const { return m_width; }
+		inline int getHeight()const { return m_height; }
+		inline const std::vector<float>& getDepthBuffer()const { return m_depth; } //Rows from the bottom, 0 = near, 1 = far
+		inline const RasterizerStats& getStats()const { return m_stats; }
+	private:
+		struct Occluder {
+			const MeshData* meshData;
+			ew::Mat4 model;
+			int firstVertex;
+			int firstTriangle;
+		};
+		//Edge functions a * x + b * y + c are >= 0 inside. Depth is zA * x + zB * y + zC
+		struct ScreenTriangle {
+			float edgeA[3], edgeB[3], edgeC[3];
+			float zA, zB, zC;
+			int minX, minY, maxX, maxY;
+		};
+		void transformVertices(int begin, int end);
+		void setupTriangles(int thread, int begin, int end);
+		void addScreenTriangle(int thread, const ew::Vec4& a, const ew::Vec4& b, const ew::Vec4& c);
+		void rasterizeTiles();
+		void rasterizeTile(int tile);
+		int m_width, m_height;
+		int m_tilesX, m_tilesY;
+		ew::Mat4 m_viewProjection;
+		std::vector<Occluder> m_occluders;
+		std::vector<ew::Vec4> m_clipVertices;
+		int m_numSetupThreads = 1;
+		std::vector<std::vector<ScreenTriangle>> m_triangles; //Per setup thread
+		std::vector<std::vector<int>> m_bins; //[thread * numTiles + tile], indices into m_triangles[thread]
+		std::atomic<int> m_nextTile{ 0 };
+		std::vector<float> m_depth;
+		std::vector<float> m_tileMaxDepth; //Farthest depth in each tile, for rejecting whole tiles in isOccluded
+		RasterizerStats m_stats;
+	};
+}
@@ -0,0 +1,187 @@
+#include "picking.h"
+#include "ewMath/simdLanes.h"
+
+//Triangles are stored in groups of SIMD_WIDTH for the intersection kernel
+#if defined(EW_SIMD_LANES)
+static const int SIMD_WIDTH = (int)ew::simd::LANE_COUNT;
+#else
+static const int SIMD_WIDTH = 4;
+#endif
+
+//Determinants smaller than this mean the ray is parallel to the triangle
+static const float PARALLEL_EPSILON = 1e-12f;
+
+namespace ew {
+	/// <summary>
+	/// World space ray from the camera through a point on the screen
+	/// </summary>
+	/// <param name="x">Pixels from the left edge, e.g. from glfwGetCursorPos</param>
+	/// <param name="y">Pixels from the top edge</param>
+	/// <param name="screenWidth">Width in the same units as x</param>
+	/// <param name="screenHeight">Height in the same units as y</param>
+	Ray ScreenPointToRay(const ew::Camera& camera, float x, float y, int screenWidth, int screenHeight)
+	{
+		//Unproject the point on the near and far planes, so the ray always matches what was rendered
+		ew::Mat4 inverseViewProjection = ew::Inverse(camera.ProjectionMatrix() * camera.ViewMatrix());
+		float ndcX = 2.0f * x / screenWidth - 1.0f;
+		float ndcY = 1.0f - 2.0f * y / screenHeight;
+		ew::Vec4 nearPoint = inverseViewProjection * ew::Vec4(ndcX, ndcY, -1.0f, 1.0f);
+		ew::Vec4 farPoint = inverseViewProjection * ew::Vec4(ndcX, ndcY, 1.0f, 1.0f);
+		ew::Vec3 nearPosition = nearPoint.toVec3() / nearPoint.w;
+		ew::Vec3 farPosition = farPoint.toVec3() / farPoint.w;
+
+		Ray ray;
+		//Perspective rays start at the eye, so hit distances are measured from the camera
+		ray.origin = camera.orthographic ? nearPosition : camera.position;
+		ray.direction = ew::Normalize(farPosition - nearPosition);
+		return ray;
+	}
+	/// <summary>
+	/// Transforms a ray, e.g. into a mesh's local space with Transform::getInverseModelMatrix.
+	/// The direction is not renormalized, so distances along the new ray match the original.
+	/// </summary>
+	Ray TransformRay(const Ray& ray, const ew::Mat4& m)
+	{
+		Ray result;
+		result.origin = (m * ew::Vec4(ray.origin, 1.0f)).toVec3();
+		result.direction = (m * ew::Vec4(ray.direction, 0.0f)).toVec3();
+		return result;
+	}
+
+	MeshPicker::MeshPicker(const MeshData& meshData, int numThreads)
+	{
+		build(meshData, numThreads);
+	}
+	/// <summary>
+	/// Builds the triangle BVH and stores triangles in leaf order so each leaf is one contiguous SIMD group
+	/// </summary>
+	void MeshPicker::build(const MeshData& meshData, int numThreads)
+	{
+		const int numTriangles = (int)meshData.indices.size() / 3;
+		std::vector<AABB> bounds(numTriangles);
+		for (int i = 0; i < numTriangles; i++)
+		{
+			bounds[i].encapsulate(meshData.vertices[meshData.indices[i * 3 + 0]].pos);
+			bounds[i].encapsulate(meshData.vertices[meshData.indices[i * 3 + 1]].pos);
+			bounds[i].encapsulate(meshData.vertices[meshData.indices[i * 3 + 2]].pos);
+		}
+		m_bvh.build(bounds, numThreads, SIMD_WIDTH);
+
+		//Padding lets the last group load a full SIMD width. Zeroed triangles never pass the determinant test
+		const size_t paddedSize = numTriangles + SIMD_WIDTH;
+		m_v0x.assign(paddedSize, 0.0f); m_v0y.assign(paddedSize, 0.0f); m_v0z.assign(paddedSize, 0.0f);
+		m_e1x.assign(paddedSize, 0.0f); m_e1y.assign(paddedSize, 0.0f); m_e1z.assign(paddedSize, 0.0f);
+		m_e2x.assign(paddedSize, 0.0f); m_e2y.assign(paddedSize, 0.0f); m_e2z.assign(paddedSize, 0.0f);
+		m_triangles = m_bvh.getIndices();
+		for (int slot = 0; slot < numTriangles; slot++)
+		{
+			int triangle = m_triangles[slot];
+			const ew::Vec3& v0 = meshData.vertices[meshData.indices[triangle * 3 + 0]].pos;
+			const ew::Vec3& v1 = meshData.vertices[meshData.indices[triangle * 3 + 1]].pos;
+			const ew::Vec3& v2 = meshData.vertices[meshData.indices[triangle * 3 + 2]].pos;
+			ew::Vec3 e1 = v1 - v0;
+			ew::Vec3 e2 = v2 - v0;
+			m_v0x[slot] = v0.x; m_v0y[slot] = v0.y; m_v0z[slot] = v0.z;
+			m_e1x[slot] = e1.x; m_e1y[slot] = e1.y; m_e1z[slot] = e1.z;
+			m_e2x[slot] = e2.x; m_e2y[slot] = e2.y; m_e2z[slot] = e2.z;
+		}
+	}
+	/// <summary>
+	/// Finds the closest triangle hit by a ray in the mesh's local space. Both sides of triangles are hit.
+	/// </summary>
+	/// <param name="maxDistance">Hits at or beyond this distance are ignored</param>
+	/// <returns>True if a triangle was hit. hit->object is left unchanged</returns>
+	bool MeshPicker::raycast(const Ray& ray, float maxDistance, PickHit* hit) const
+	{
+		hit->triangle = -1;
+		hit->distance = m_bvh.traverse(ray, maxDistance, [&](int first, int count, float* closest) {
+			intersectLeaf(ray, first, count, closest, hit);
+		});
+		if (hit->triangle < 0) {
+			return false;
+		}
+		hit->point = ray.origin + ray.direction * hit->distance;
+		return true;
+	}
+	/// <summary>
+	/// Möller–Trumbore intersection against the triangles in slots [first, first + count)
+	/// </summary>
+	void MeshPicker::intersectLeaf(const Ray& ray, int first, int count, float* closest, PickHit* hit) const
+	{
+		const int end = first + count;
+#if defined(EW_SIMD_LANES)
+		const simd::Lanes ox = simd::splat(ray.origin.x), oy = simd::splat(ray.origin.y), oz = simd::splat(ray.origin.z);
+		const simd::Lanes dx = simd::splat(ray.direction.x), dy = simd::splat(ray.direction.y), dz = simd::splat(ray.direction.z);
+		const simd::Lanes zero = simd::splat(0.0f), one = simd::splat(1.0f);
+		const simd::Lanes epsilon = simd::splat(PARALLEL_EPSILON), signBit = simd::splat(-0.0f);
+		for (int group = first; group < end; group += SIMD_WIDTH)
+		{
+			simd::Lanes e1x = simd::load(&m_e1x[group]), e1y = simd::load(&m_e1y[group]), e1z = simd::load(&m_e1z[group]);
+			simd::Lanes e2x = simd::load(&m_e2x[group]), e2y = simd::load(&m_e2y[group]), e2z = simd::load(&m_e2z[group]);
+			//p = Cross(direction, e2)
+			simd::Lanes px = simd::sub(simd::mul(dy, e2z), simd::mul(dz, e2y));
+			simd::Lanes py = simd::sub(simd::mul(dz, e2x), simd::mul(dx, e2z));
+			simd::Lanes pz = simd::sub(simd::mul(dx, e2y), simd::mul(dy, e2x));
+			simd::Lanes det = simd::add(simd::add(simd::mul(e1x, px), simd::mul(e1y, py)), simd::mul(e1z, pz));
+			simd::Lanes inverseDet = simd::div(one, det);
+			//s = origin - v0
+			simd::Lanes sx = simd::sub(ox, simd::load(&m_v0x[group]));
+			simd::Lanes sy = simd::sub(oy, simd::load(&m_v0y[group]));
+			simd::Lanes sz = simd::sub(oz, simd::load(&m_v0z[group]));
+			simd::Lanes u = simd::mul(simd::add(simd::add(simd::mul(sx, px), simd::mul(sy, py)), simd::mul(sz, pz)), inverseDet);
+			//q = Cross(s, e1)
+			simd::Lanes qx = simd::sub(simd::mul(sy, e1z), simd::mul(sz, e1y));
+			simd::Lanes qy = simd::sub(simd::mul(sz, e1x), simd::mul(sx, e1z));
+			simd::Lanes qz = simd::sub(simd::mul(sx, e1y), simd::mul(sy, e1x));
+			simd::Lanes v = simd::mul(simd::add(simd::add(simd::mul(dx, qx), simd::mul(dy, qy)), simd::mul(dz, qz)), inverseDet);
+			simd::Lanes t = simd::mul(simd::add(simd::add(simd::mul(e2x, qx), simd::mul(e2y, qy)), simd::mul(e2z, qz)), inverseDet);
+
+			simd::Lanes mask = simd::less(epsilon, simd::bitAndNot(signBit, det));
+			mask = simd::bitAnd(mask, simd::greaterEqual(u, zero));
+			mask = simd::bitAnd(mask, simd::greaterEqual(v, zero));
+			mask = simd::bitAnd(mask, simd::greaterEqual(one, simd::add(u, v)));
+			mask = simd::bitAnd(mask, simd::less(zero, t));
+			mask = simd::bitAnd(mask, simd::less(t, simd::splat(*closest)));
+			int lanes = end - group < SIMD_WIDTH ? end - group : SIMD_WIDTH;
+			int bits = simd::laneBits(mask) & ((1 << lanes) - 1);
+			if (bits == 0) {
+				continue;
+			}
+			float ts[SIMD_WIDTH], us[SIMD_WIDTH], vs[SIMD_WIDTH];
+			simd::store(ts, t);
+			simd::store(us, u);
+			simd::store(vs, v);
+			for (int lane = 0; lane < lanes; lane++)
+			{
+				if ((bits & (1 << lane)) && ts[lane] < *closest) {
+					*closest = ts[lane];
+					hit->triangle = m_triangles[group + lane];
+					hit->barycentric = ew::Vec3(1.0f - us[lane] - vs[lane], us[lane], vs[lane]);
+				}
+			}
+		}
+#else
+		for (int slot = first; slot < end; slot++)
+		{
+			ew::Vec3 e1(m_e1x[slot], m_e1y[slot], m_e1z[slot]);
+			ew::Vec3 e2(m_e2x[slot], m_e2y[slot], m_e2z[slot]);
+			ew::Vec3 p = ew::Cross(ray.direction, e2);
+			float det = ew::Dot(e1, p);
+			if (fabsf(det) <= PARALLEL_EPSILON) {
+				continue;
+			}
+			float inverseDet = 1.0f / det;
+			ew::Vec3 s = ray.origin - ew::Vec3(m_v0x[slot], m_v0y[slot], m_v0z[slot]);
+			float u = ew::Dot(s, p) * inverseDet;
+			ew::Vec3 q = ew::Cross(s, e1);
+			float v = ew::Dot(ray.direction, q) * inverseDet;
+			float t = ew::Dot(e2, q) * inverseDet;
+			if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t > 0.0f && t < *closest) {
+				*closest = t;
+				hit->triangle = m_triangles[slot];
+				hit->barycentric = ew::Vec3(1.0f - u - v, u, v);
+			}
+		}
+#endif
+	}
+}
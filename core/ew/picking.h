@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+#include "ewMath/ewMath.h"
+#include "camera.h"
+#include "mesh.h"
+#include "bvh.h"
+
+namespace ew {
+	struct PickHit {
+		int object = -1; //Set by the caller when picking among several objects
+		int triangle = -1; //Index of the triangle's first index / 3 in MeshData::indices. -1 for no hit
+		float distance = 0.0f;
+		ew::Vec3 barycentric; //Weights of the triangle's 3 vertices at the hit point
+		ew::Vec3 point; //Hit position, in the same space as the ray
+	};
+
+	Ray ScreenPointToRay(const ew::Camera& camera, float x, float y, int screenWidth, int screenHeight);
+	Ray TransformRay(const Ray& ray, const ew::Mat4& m);
+
+	//Triangle BVH over a mesh for ray picking in the mesh's local space.
+	//Leaves hold up to one SIMD group of triangles, tested together with Möller–Trumbore.
+	class MeshPicker {
+	public:
+		MeshPicker() {};
+		MeshPicker(const MeshData& meshData, int numThreads = 1);
+		void build(const MeshData& meshData, int numThreads = 1);
+		bool raycast(const Ray& ray, float maxDistance, PickHit* hit)const;
+		inline int getNumTriangles()const { return (int)m_triangles.size(); }
+		inline const BVH& getBVH()const { return m_bvh; }
+	private:
+		void intersectLeaf(const Ray& ray, int first, int count, float* closest, PickHit* hit)const;
+		BVH m_bvh;
+		//Triangles in leaf order as vertex 0 and two edges, padded to a whole SIMD group
+		std::vector<float> m_v0x, m_v0y, m_v0z;
+		std::vector<float> m_e1x, m_e1y, m_e1z;
+		std::vector<float> m_e2x, m_e2y, m_e2z;
+		std::vector<int> m_triangles; //Original triangle index of each slot
+	};
+}
@@ -5,41 +5,27 @@
 
 #include "procGen.h"
 #include <stdlib.h>
+#include <vector>
 
 namespace ew {
 	/// <summary>
-	/// Helper function for createCube. Note that this is not meant to be used standalone
+	/// Sines and cosines of the subdivisions + 1 angles around a ring, from 0 to TAU inclusive
 	/// </summary>
-	/// <param name="normal">Normal direction of the face</param>
-	/// <param name="size">Width/height of the face</param>
-	/// <param name="mesh">MeshData struct to fill</param>
-	static void createCubeFace(ew::Vec3 normal, float size, MeshData* mesh) {
-		unsigned int startVertex = mesh->vertices.size();
-		ew::Vec3 a = ew::Vec3(normal.z, normal.x, normal.y); //U axis
-		ew::Vec3 b = ew::Cross(normal, a); //V axis
-		for (int i = 0; i < 4; i++)
+	static void ringSinCos(int subdivisions, std::vector<float>& sines, std::vector<float>& cosines) {
+		const float thetaStep = ew::TAU / subdivisions;
+		std::vector<float> thetas(subdivisions + 1);
+		for (size_t i = 0; i < thetas.size(); i++)
 		{
-			int col = i % 2;
-			int row = i / 2;
-
-			ew::Vec3 pos = normal * size * 0.5f;
-			pos -= (a + b) * size * 0.5f;
-			pos += (a * col + b * row) * size;
-			Vertex vertex;// = &mesh->vertices[mesh->vertices.size()];
-			vertex.pos = pos;
-			vertex.normal = normal;
-			vertex.uv = ew::Vec2(col, row);
-			mesh->vertices.push_back(vertex);
+			thetas[i] = i * thetaStep;
 		}
-
-		//Indices
-		mesh->indices.push_back(startVertex);
-		mesh->indices.push_back(startVertex + 1);
-		mesh->indices.push_back(startVertex + 3);
-		mesh->indices.push_back(startVertex + 3);
-		mesh->indices.push_back(startVertex + 2);
-		mesh->indices.push_back(startVertex);
+		sines.resize(thetas.size());
+		cosines.resize(thetas.size());
+		ew::SinCos(thetas.data(), sines.data(), cosines.data(), thetas.size());
 	}
+
+	static_assert(UNIT_CUBE.vertices[0].pos.x == -0.5f && UNIT_CUBE.vertices[0].pos.z == 0.5f, "Unit cube front face starts at its bottom left corner");
+	static_assert(UNIT_CUBE.indices[35] == 20, "Unit cube indices end on the back face");
+
 	/// <summary>
 	/// Creates a cube of uniform size
 	/// </summary>
@@ -47,14 +33,12 @@ namespace ew {
 	/// <param name="mesh">MeshData struct to fill. Will be cleared.</param>
 	MeshData createCube(float size) {
 		MeshData mesh;
-		mesh.vertices.reserve(24); //6 x 4 vertices
-		mesh.indices.reserve(36); //6 x 6 indices
-		createCubeFace(ew::Vec3{ +0.0f,+0.0f,+1.0f }, size, &mesh); //Front
-		createCubeFace(ew::Vec3{ +1.0f,+0.0f,+0.0f }, size, &mesh); //Right
-		createCubeFace(ew::Vec3{ +0.0f,+1.0f,+0.0f }, size, &mesh); //Top
-		createCubeFace(ew::Vec3{ -1.0f,+0.0f,+0.0f }, size, &mesh); //Left
-		createCubeFace(ew::Vec3{ +0.0f,-1.0f,+0.0f }, size, &mesh); //Bottom
-		createCubeFace(ew::Vec3{ +0.0f,+0.0f,-1.0f }, size, &mesh); //Back
+		mesh.vertices.assign(UNIT_CUBE.vertices.begin(), UNIT_CUBE.vertices.end());
+		mesh.indices.assign(UNIT_CUBE.indices.begin(), UNIT_CUBE.indices.end());
+		for (Vertex& vertex : mesh.vertices) {
+			vertex.pos *= size;
+		}
+		mesh.bounds = ew::ComputeBounds(mesh.vertices);
 		return mesh;
 	}
 	MeshData createPlane(float width, float height, int subdivisions)
@@ -90,24 +74,28 @@ namespace ew {
 				mesh.indices.push_back(start);
 			}
 		}
+		mesh.bounds = ew::ComputeBounds(mesh.vertices);
 		return mesh;
 	}
 	MeshData createSphere(float radius, int subdivisions)
 	{
 		MeshData mesh;
 		//VERTICES
-		float thetaStep = ew::TAU / subdivisions;
+		//Every row uses the same column angles, so their sines and cosines are computed once
+		std::vector<float> sinTheta, cosTheta;
+		ringSinCos(subdivisions, sinTheta, cosTheta);
 		float phiStep = ew::PI / subdivisions;
+		mesh.vertices.reserve((subdivisions + 1) * (subdivisions + 1));
 		for (size_t row = 0; row <= subdivisions; row++)
 		{
-			float phi = row * phiStep;
+			float sinPhi, cosPhi;
+			ew::SinCos(row * phiStep, sinPhi, cosPhi);
 			for (size_t col = 0; col <= subdivisions; col++)
 			{
-				float theta = thetaStep * col;
 				Vertex v;
-				v.normal.x = cosf(theta) * sinf(phi);
-				v.normal.y = cosf(phi);
-				v.normal.z = sinf(theta) * sinf(phi);
+				v.normal.x = cosTheta[col] * sinPhi;
+				v.normal.y = cosPhi;
+				v.normal.z = sinTheta[col] * sinPhi;
 				v.pos = v.normal * radius;
 				v.uv.x = (float)col / subdivisions;
 				v.uv.y = 1.0 - ((float)row / subdivisions);
@@ -149,15 +137,16 @@ namespace ew {
 			mesh.indices.push_back(sideStart + i + 1);
 			mesh.indices.push_back(poleStart + i);
 		}
+		mesh.bounds = ew::ComputeBounds(mesh.vertices);
 		return mesh;
 	}
 	void createCylinderRing(MeshData* meshData, float radius, int subdivisions, float y, bool sideFacing) {
-		float thetaStep = ew::TAU / subdivisions;
+		std::vector<float> sines, cosines;
+		ringSinCos(subdivisions, sines, cosines);
 		for (size_t i = 0; i <= subdivisions; i++)
 		{
-			float theta = i * thetaStep;
-			float cosA = cosf(theta);
-			float sinA = sinf(theta);
+			float cosA = cosines[i];
+			float sinA = sines[i];
 			ew::Vertex v;
 			v.pos = ew::Vec3(cosA * radius, y, sinA * radius);
 			if (sideFacing) {
@@ -232,6 +221,7 @@ namespace ew {
 				mesh.indices.push_back(sideStart + i + 1);
 			}
 		}
+		mesh.bounds = ew::ComputeBounds(mesh.vertices);
 		return mesh;
 	}
 }
\ No newline at end of file
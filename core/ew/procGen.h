@@ -4,9 +4,54 @@
 
 
 #pragma once
+#include <array>
 #include "mesh.h"
 
 namespace ew {
+	//Mesh data in fixed size arrays, so it can be generated at compile time
+	template<size_t NumVertices, size_t NumIndices>
+	struct ConstMeshData {
+		std::array<Vertex, NumVertices> vertices;
+		std::array<unsigned int, NumIndices> indices;
+	};
+
+	//Cube with width, height and depth of 1. Each face has its own 4 vertices, so normals and UVs stay flat
+	constexpr ConstMeshData<24, 36> createUnitCube() {
+		const ew::Vec3 normals[6] = {
+			ew::Vec3(+0.0f, +0.0f, +1.0f), //Front
+			ew::Vec3(+1.0f, +0.0f, +0.0f), //Right
+			ew::Vec3(+0.0f, +1.0f, +0.0f), //Top
+			ew::Vec3(-1.0f, +0.0f, +0.0f), //Left
+			ew::Vec3(+0.0f, -1.0f, +0.0f), //Bottom
+			ew::Vec3(+0.0f, +0.0f, -1.0f) //Back
+		};
+		ConstMeshData<24, 36> cube{};
+		for (unsigned int face = 0; face < 6; face++)
+		{
+			const ew::Vec3 normal = normals[face];
+			const ew::Vec3 a = ew::Vec3(normal.z, normal.x, normal.y); //U axis
+			const ew::Vec3 b = ew::Cross(normal, a); //V axis
+			const unsigned int startVertex = face * 4;
+			for (unsigned int i = 0; i < 4; i++)
+			{
+				const float col = (float)(i % 2);
+				const float row = (float)(i / 2);
+				Vertex& vertex = cube.vertices[startVertex + i];
+				vertex.pos = normal * 0.5f - (a + b) * 0.5f + (a * col + b * row);
+				vertex.normal = normal;
+				vertex.uv = ew::Vec2(col, row);
+			}
+			const unsigned int faceIndices[6] = { 0, 1, 3, 3, 2, 0 };
+			for (unsigned int i = 0; i < 6; i++)
+			{
+				cube.indices[face * 6 + i] = startVertex + faceIndices[i];
+			}
+		}
+		return cube;
+	}
+	//Built by the compiler. createCube copies and scales it
+	inline constexpr ConstMeshData<24, 36> UNIT_CUBE = createUnitCube();
+
 	MeshData createCube(float size);
 	MeshData createPlane(float width, float height, int subdivisions);
 	MeshData createSphere(float radius, int subdivisions);
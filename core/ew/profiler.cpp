@@ -0,0 +1,314 @@
+#include "profiler.h"
+#include "profilerInternal.h"
+#include "json.h"
+#include <stdio.h>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+
+static const uint32_t RING_CAPACITY = 4096; //Events per thread between two endFrame calls
+static const int MAX_THREADS = 64;
+static const int MAX_DEPTH = 64;
+
+//Events recorded by one thread. Only the owning thread writes events and the frame thread reads them,
+//so the write and read indices are enough to hand them over without a lock
+struct ThreadBuffer {
+	ew::ProfileEvent events[RING_CAPACITY];
+	std::atomic<uint32_t> writeIndex{ 0 };
+	std::atomic<uint32_t> readIndex{ 0 };
+	std::atomic<int> numDropped{ 0 };
+	std::atomic<bool> free{ false }; //Owner thread exited, so a new thread may claim the buffer
+	//Open scopes, only used by the owner
+	const char* openNames[MAX_DEPTH];
+	int64_t openStarts[MAX_DEPTH];
+	int depth = 0;
+	uint16_t index = 0;
+	bool named = false;
+	char name[32] = {}; //Guarded by s_namesMutex, as the frame thread reads it while the owner may rename it
+};
+
+//Releases the calling thread's buffer when it exits, so short lived worker threads don't use up the registry
+struct ThreadBufferHandle {
+	ThreadBuffer* buffer = nullptr;
+	~ThreadBufferHandle() {
+		if (buffer) {
+			buffer->free.store(true, std::memory_order_release);
+		}
+	}
+};
+
+static std::atomic<ThreadBuffer*> s_threads[MAX_THREADS];
+static std::atomic<int> s_numThreads{ 0 };
+static thread_local ThreadBufferHandle t_buffer;
+static std::atomic<bool> s_enabled{ true };
+static std::mutex s_namesMutex;
+
+//Only touched by the frame thread
+static std::vector<ew::ProfileFrame> s_history(ew::profiler::HISTORY_SIZE);
+static int s_historyHead = 0;
+static int s_numFrames = 0;
+static uint64_t s_frameIndex = 0;
+static int64_t s_frameStartNs = 0;
+static bool s_inFrame = false;
+static ew::profiler::internal::FrameHooks s_frameHooks; //Installed by profilerGPU.cpp
+
+/// <summary>
+/// Returns the calling thread's buffer, claiming a released one or registering a new one on first use
+/// </summary>
+/// <returns>nullptr if MAX_THREADS threads are already registered</returns>
+static ThreadBuffer* getThreadBuffer() {
+	if (t_buffer.buffer) {
+		return t_buffer.buffer;
+	}
+	int numThreads = std::min(s_numThreads.load(std::memory_order_acquire), MAX_THREADS);
+	for (int i = 0; i < numThreads; i++)
+	{
+		ThreadBuffer* buffer = s_threads[i].load(std::memory_order_acquire);
+		bool expected = true;
+		if (buffer && buffer->free.compare_exchange_strong(expected, false, std::memory_order_acquire)) {
+			buffer->depth = 0;
+			buffer->named = false;
+			{
+				std::lock_guard<std::mutex> lock(s_namesMutex);
+				snprintf(buffer->name, sizeof(buffer->name), "Thread %i", i);
+			}
+			t_buffer.buffer = buffer;
+			return buffer;
+		}
+	}
+	int index = s_numThreads.fetch_add(1);
+	if (index >= MAX_THREADS) {
+		return nullptr;
+	}
+	ThreadBuffer* buffer = new ThreadBuffer(); //Kept until exit, as the frame thread may still be reading it
+	buffer->index = (uint16_t)index;
+	snprintf(buffer->name, sizeof(buffer->name), "Thread %i", index);
+	s_threads[index].store(buffer, std::memory_order_release);
+	t_buffer.buffer = buffer;
+	return buffer;
+}
+
+namespace ew {
+	namespace profiler {
+		namespace internal {
+			void setFrameHooks(const FrameHooks& hooks)
+			{
+				s_frameHooks = hooks;
+			}
+			int64_t nowNs()
+			{
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+			}
+			bool isInFrame()
+			{
+				return s_inFrame;
+			}
+			uint64_t getFrameIndex()
+			{
+				return s_frameIndex;
+			}
+			ProfileFrame* findFrame(uint64_t frameIndex)
+			{
+				for (int i = 0; i < s_numFrames; i++)
+				{
+					ProfileFrame* frame = &s_history[(s_historyHead - 1 - i + HISTORY_SIZE) % HISTORY_SIZE];
+					if (frame->index == frameIndex) {
+						return frame;
+					}
+				}
+				return nullptr;
+			}
+			std::string getThreadName(uint16_t thread)
+			{
+				if (thread == GPU_THREAD) {
+					return "GPU";
+				}
+				ThreadBuffer* buffer = thread < MAX_THREADS ? s_threads[thread].load(std::memory_order_acquire) : nullptr;
+				if (!buffer) {
+					return "Unknown";
+				}
+				std::lock_guard<std::mutex> lock(s_namesMutex);
+				return buffer->name;
+			}
+		}
+		void setEnabled(bool enabled)
+		{
+			s_enabled.store(enabled, std::memory_order_relaxed);
+		}
+		bool isEnabled()
+		{
+			return s_enabled.load(std::memory_order_relaxed);
+		}
+		void setThreadName(const char* name)
+		{
+			ThreadBuffer* buffer = getThreadBuffer();
+			if (buffer) {
+				std::lock_guard<std::mutex> lock(s_namesMutex);
+				snprintf(buffer->name, sizeof(buffer->name), "%s", name);
+				buffer->named = true;
+			}
+		}
+		/// <summary>
+		/// Starts a frame on the calling thread and reads back GPU scopes from earlier frames that have finished
+		/// </summary>
+		void beginFrame()
+		{
+			if (!isEnabled() || s_inFrame) {
+				return;
+			}
+			ThreadBuffer* buffer = getThreadBuffer();
+			if (buffer && !buffer->named) {
+				setThreadName("Main");
+			}
+			if (s_frameHooks.beginFrame) {
+				s_frameHooks.beginFrame(s_frameIndex);
+			}
+			s_frameStartNs = internal::nowNs();
+			s_inFrame = true;
+		}
+		/// <summary>
+		/// Ends the frame and moves the scopes every thread has finished since the last frame into the history
+		/// </summary>
+		void endFrame()
+		{
+			if (!s_inFrame) {
+				return;
+			}
+			if (s_frameHooks.endFrame) {
+				s_frameHooks.endFrame(s_frameIndex);
+			}
+
+			ProfileFrame& frame = s_history[s_historyHead];
+			s_historyHead = (s_historyHead + 1) % HISTORY_SIZE;
+			s_numFrames = std::min(s_numFrames + 1, HISTORY_SIZE);
+			frame.index = s_frameIndex;
+			frame.startNs = s_frameStartNs;
+			frame.endNs = internal::nowNs();
+			frame.thread = t_buffer.buffer ? t_buffer.buffer->index : 0;
+			frame.events.clear();
+			frame.gpuEvents.clear();
+			frame.gpuReady = false;
+			frame.numDropped = 0;
+			int numThreads = std::min(s_numThreads.load(std::memory_order_acquire), MAX_THREADS);
+			for (int i = 0; i < numThreads; i++)
+			{
+				ThreadBuffer* buffer = s_threads[i].load(std::memory_order_acquire);
+				if (!buffer) {
+					continue;
+				}
+				uint32_t read = buffer->readIndex.load(std::memory_order_relaxed);
+				uint32_t write = buffer->writeIndex.load(std::memory_order_acquire);
+				for (; read != write; read++) {
+					frame.events.push_back(buffer->events[read % RING_CAPACITY]);
+				}
+				buffer->readIndex.store(read, std::memory_order_release);
+				frame.numDropped += buffer->numDropped.exchange(0, std::memory_order_relaxed);
+			}
+			s_frameIndex++;
+			s_inFrame = false;
+		}
+		/// <summary>
+		/// Opens a scope on the calling thread. Unlike ProfileScope, records even while the profiler is disabled
+		/// </summary>
+		/// <param name="name">Not copied, so it must outlive the profiler</param>
+		void beginScope(const char* name)
+		{
+			ThreadBuffer* buffer = getThreadBuffer();
+			if (!buffer) {
+				return;
+			}
+			if (buffer->depth < MAX_DEPTH) {
+				buffer->openNames[buffer->depth] = name;
+				buffer->openStarts[buffer->depth] = internal::nowNs();
+			}
+			buffer->depth++;
+		}
+		/// <summary>
+		/// Closes the innermost scope opened on the calling thread and pushes it to the thread's ring buffer
+		/// </summary>
+		void endScope()
+		{
+			ThreadBuffer* buffer = t_buffer.buffer;
+			if (!buffer || buffer->depth == 0) {
+				return;
+			}
+			buffer->depth--;
+			if (buffer->depth >= MAX_DEPTH) {
+				return;
+			}
+			ProfileEvent event = { buffer->openNames[buffer->depth], buffer->openStarts[buffer->depth], internal::nowNs(), (uint16_t)buffer->depth, buffer->index };
+			uint32_t write = buffer->writeIndex.load(std::memory_order_relaxed);
+			if (write - buffer->readIndex.load(std::memory_order_acquire) >= RING_CAPACITY) {
+				buffer->numDropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			buffer->events[write % RING_CAPACITY] = event;
+			buffer->writeIndex.store(write + 1, std::memory_order_release);
+		}
+		int getNumFrames()
+		{
+			return s_numFrames;
+		}
+		const ProfileFrame* getFrame(int framesAgo)
+		{
+			if (framesAgo < 0 || framesAgo >= s_numFrames) {
+				return nullptr;
+			}
+			return &s_history[(s_historyHead - 1 - framesAgo + HISTORY_SIZE) % HISTORY_SIZE];
+		}
+		/// <summary>
+		/// Writes the frame history in the Trace Event Format, with a track per thread and one for the GPU
+		/// </summary>
+		/// <returns>False if there are no frames or the file could not be written</returns>
+		bool writeChromeTrace(const std::string& filePath)
+		{
+			if (s_numFrames == 0) {
+				return false;
+			}
+			FILE* file = fopen(filePath.c_str(), "w");
+			if (file == nullptr) {
+				printf("Failed to open %s for writing\n", filePath.c_str());
+				return false;
+			}
+			const int64_t originNs = getFrame(s_numFrames - 1)->startNs;
+			bool first = true;
+			auto writeEvent = [&](const char* name, const char* category, int64_t startNs, int64_t endNs, int thread) {
+				fprintf(file, "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%i}",
+					first ? "" : ",", escapeJSON(name).c_str(), category, (startNs - originNs) / 1e3, (endNs - startNs) / 1e3, thread);
+				first = false;
+			};
+			fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+			std::vector<int> threads;
+			char frameName[32];
+			for (int i = s_numFrames - 1; i >= 0; i--)
+			{
+				const ProfileFrame* frame = getFrame(i);
+				snprintf(frameName, sizeof(frameName), "Frame %llu", (unsigned long long)frame->index);
+				writeEvent(frameName, "frame", frame->startNs, frame->endNs, frame->thread);
+				threads.push_back(frame->thread);
+				for (const ProfileEvent& event : frame->events) {
+					writeEvent(event.name, "cpu", event.startNs, event.endNs, event.thread);
+					threads.push_back(event.thread);
+				}
+				for (const ProfileEvent& event : frame->gpuEvents) {
+					writeEvent(event.name, "gpu", event.startNs, event.endNs, GPU_THREAD);
+					threads.push_back(GPU_THREAD);
+				}
+			}
+			std::sort(threads.begin(), threads.end());
+			threads.erase(std::unique(threads.begin(), threads.end()), threads.end());
+			for (int thread : threads) {
+				fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%i,\"args\":{\"name\":\"%s\"}}",
+					thread, escapeJSON(internal::getThreadName((uint16_t)thread).c_str()).c_str());
+			}
+			fprintf(file, "\n]}\n");
+			bool ok = ferror(file) == 0;
+			fclose(file);
+			if (!ok) {
+				printf("Failed to write %s\n", filePath.c_str());
+			}
+			return ok;
+		}
+	}
+}
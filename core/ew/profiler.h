@@ -0,0 +1,91 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace ew {
+	//A timed scope. Times are steady clock nanoseconds; GPU times are converted to the same clock.
+	struct ProfileEvent {
+		const char* name; //Not copied, so it must outlive the profiler (e.g. a string literal)
+		int64_t startNs;
+		int64_t endNs;
+		uint16_t depth; //Number of enclosing scopes on the same thread
+		uint16_t thread; //Index of the recording thread, or GPU_THREAD
+	};
+
+	struct ProfileFrame {
+		uint64_t index = 0;
+		int64_t startNs = 0; //beginFrame
+		int64_t endNs = 0; //endFrame
+		int thread = 0; //Thread that called beginFrame and endFrame
+		std::vector<ProfileEvent> events; //CPU scopes from every thread that ended during the frame
+		std::vector<ProfileEvent> gpuEvents; //Filled in a few frames later, once the queries are available
+		bool gpuReady = false;
+		int numDropped = 0; //Scopes lost to full ring buffers or unavailable GPU queries
+	};
+
+	//Frame profiler with nestable CPU scopes on any thread and GPU scopes on the GL thread.
+	//Each thread records into its own lock-free ring buffer, which endFrame drains into the frame history.
+	//GPU scopes are timestamp query pairs read back GPU_LATENCY frames later, so they never stall the pipeline.
+	//CPU scopes, frames and trace export don't depend on GL or ImGui: the GPU scopes and shutdown are in profilerGPU.cpp,
+	//and drawWindow in profilerWindow.cpp, so code that only uses CPU scopes links without them.
+	namespace profiler {
+		const uint16_t GPU_THREAD = 0xFFFF;
+		const int GPU_LATENCY = 4;
+		const int HISTORY_SIZE = 240; //Frames kept for the flame graph and trace export
+
+		void setEnabled(bool enabled); //Frames and RAII scopes are skipped while disabled
+		bool isEnabled();
+		void setThreadName(const char* name); //Shown in the flame graph and trace. Call at thread start
+		void beginFrame();
+		void endFrame();
+		void beginScope(const char* name);
+		void endScope();
+		void beginGPUScope(const char* name); //GL thread only, between beginFrame and endFrame
+		void endGPUScope();
+		int getNumFrames();
+		const ProfileFrame* getFrame(int framesAgo); //0 is the last completed frame. nullptr if out of range
+		void drawWindow(bool* open = nullptr); //Call between ImGui::NewFrame and ImGui::Render
+		bool writeChromeTrace(const std::string& filePath); //chrome://tracing or Perfetto JSON of the frame history
+		void shutdown(); //Deletes GL queries. Call before destroying the context
+	}
+
+	//Times the enclosing block on the calling thread
+	class ProfileScope {
+	public:
+		inline ProfileScope(const char* name) : m_active(profiler::isEnabled()) {
+			if (m_active) {
+				profiler::beginScope(name);
+			}
+		}
+		inline ~ProfileScope() {
+			if (m_active) {
+				profiler::endScope();
+			}
+		}
+	private:
+		bool m_active;
+	};
+
+	//Times the GL commands issued in the enclosing block
+	class GPUProfileScope {
+	public:
+		inline GPUProfileScope(const char* name) : m_active(profiler::isEnabled()) {
+			if (m_active) {
+				profiler::beginGPUScope(name);
+			}
+		}
+		inline ~GPUProfileScope() {
+			if (m_active) {
+				profiler::endGPUScope();
+			}
+		}
+	private:
+		bool m_active;
+	};
+}
+
+#define EW_PROFILE_CONCAT_IMPL(a, b) a##b
+#define EW_PROFILE_CONCAT(a, b) EW_PROFILE_CONCAT_IMPL(a, b)
+#define EW_PROFILE_SCOPE(name) ew::ProfileScope EW_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define EW_PROFILE_GPU_SCOPE(name) ew::GPUProfileScope EW_PROFILE_CONCAT(gpuProfileScope, __LINE__)(name)
@@ -0,0 +1,150 @@
+#include "profiler.h"
+#include "profilerInternal.h"
+#include "external/glad.h"
+
+//GPU scopes. Only linked by programs that call beginGPUScope, so CPU only code can use the profiler without GL
+
+static const int QUERY_BATCH = 32;
+
+//Query pairs issued during one frame, waiting for the GPU
+struct GPUFrame {
+	uint64_t frameIndex = 0;
+	int64_t gpuToCpuNs = 0; //Added to GPU timestamps to convert them to the CPU clock
+	std::vector<unsigned int> queries; //Start and end query per event
+	std::vector<ew::ProfileEvent> events;
+	int lastQuery = -1; //Most recently issued query. Timestamps complete in order, so once it is available all are
+	bool pending = false;
+};
+
+static GPUFrame s_gpuFrames[ew::profiler::GPU_LATENCY];
+static std::vector<int> s_gpuStack; //Open GPU events of the current frame, -1 for skipped ones
+static bool s_gpuCalibrated = false;
+
+/// <summary>
+/// Reads back a frame's queries into its history entry if the GPU has finished them
+/// </summary>
+/// <param name="drop">Drops the results instead if they are not available yet</param>
+static void resolveGPUFrame(GPUFrame& gpuFrame, bool drop) {
+	if (!gpuFrame.pending) {
+		return;
+	}
+	ew::ProfileFrame* frame = ew::profiler::internal::findFrame(gpuFrame.frameIndex);
+	int available = 1;
+	if (gpuFrame.lastQuery >= 0) {
+		glGetQueryObjectiv(gpuFrame.queries[gpuFrame.lastQuery], GL_QUERY_RESULT_AVAILABLE, &available);
+	}
+	if (!available) {
+		if (drop) {
+			if (frame) {
+				frame->numDropped += (int)gpuFrame.events.size();
+			}
+			gpuFrame.pending = false;
+		}
+		return;
+	}
+	gpuFrame.pending = false;
+	if (!frame) {
+		return;
+	}
+	frame->gpuEvents.clear();
+	for (size_t i = 0; i < gpuFrame.events.size(); i++)
+	{
+		GLuint64 start = 0, end = 0;
+		glGetQueryObjectui64v(gpuFrame.queries[i * 2], GL_QUERY_RESULT, &start);
+		glGetQueryObjectui64v(gpuFrame.queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+		ew::ProfileEvent event = gpuFrame.events[i];
+		event.startNs = (int64_t)start + gpuFrame.gpuToCpuNs;
+		event.endNs = (int64_t)end + gpuFrame.gpuToCpuNs;
+		frame->gpuEvents.push_back(event);
+	}
+	frame->gpuReady = true;
+}
+
+/// <summary>
+/// Reads back GPU scopes from earlier frames that have finished and starts recording frameIndex
+/// </summary>
+static void beginGPUFrame(uint64_t frameIndex) {
+	if (glGetQueryObjectiv != nullptr) {
+		//Oldest first. The slot this frame reuses is dropped if the GPU is more than GPU_LATENCY frames behind
+		for (int i = 0; i < ew::profiler::GPU_LATENCY; i++)
+		{
+			resolveGPUFrame(s_gpuFrames[(frameIndex + i) % ew::profiler::GPU_LATENCY], i == 0);
+		}
+	}
+	GPUFrame& gpuFrame = s_gpuFrames[frameIndex % ew::profiler::GPU_LATENCY];
+	gpuFrame.frameIndex = frameIndex;
+	gpuFrame.events.clear();
+	gpuFrame.lastQuery = -1;
+	s_gpuStack.clear();
+	s_gpuCalibrated = false;
+}
+
+/// <summary>
+/// Closes the GPU scopes left open and queues the frame's queries for readback
+/// </summary>
+static void endGPUFrame(uint64_t frameIndex) {
+	while (!s_gpuStack.empty()) {
+		ew::profiler::endGPUScope();
+	}
+	GPUFrame& gpuFrame = s_gpuFrames[frameIndex % ew::profiler::GPU_LATENCY];
+	gpuFrame.frameIndex = frameIndex;
+	gpuFrame.pending = true;
+}
+
+namespace ew {
+	namespace profiler {
+		/// <summary>
+		/// Issues a timestamp query before the GL commands of the scope
+		/// </summary>
+		void beginGPUScope(const char* name)
+		{
+			internal::setFrameHooks({ beginGPUFrame, endGPUFrame });
+			if (!internal::isInFrame() || glQueryCounter == nullptr) {
+				s_gpuStack.push_back(-1);
+				return;
+			}
+			GPUFrame& gpuFrame = s_gpuFrames[internal::getFrameIndex() % GPU_LATENCY];
+			if (!s_gpuCalibrated) {
+				//Time at which the GPU reaches the commands issued so far. Not exact while the GPU is behind,
+				//but close enough to line the GPU track up with the CPU scopes that issued it
+				GLint64 gpuNow = 0;
+				glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+				gpuFrame.gpuToCpuNs = internal::nowNs() - gpuNow;
+				s_gpuCalibrated = true;
+			}
+			int index = (int)gpuFrame.events.size();
+			if ((int)gpuFrame.queries.size() < (index + 1) * 2) {
+				size_t numQueries = gpuFrame.queries.size();
+				gpuFrame.queries.resize(numQueries + QUERY_BATCH * 2);
+				glGenQueries(QUERY_BATCH * 2, gpuFrame.queries.data() + numQueries);
+			}
+			glQueryCounter(gpuFrame.queries[index * 2], GL_TIMESTAMP);
+			gpuFrame.lastQuery = index * 2;
+			gpuFrame.events.push_back({ name, 0, 0, (uint16_t)s_gpuStack.size(), GPU_THREAD });
+			s_gpuStack.push_back(index);
+		}
+		void endGPUScope()
+		{
+			if (s_gpuStack.empty()) {
+				return;
+			}
+			int index = s_gpuStack.back();
+			s_gpuStack.pop_back();
+			if (index >= 0) {
+				GPUFrame& gpuFrame = s_gpuFrames[internal::getFrameIndex() % GPU_LATENCY];
+				glQueryCounter(gpuFrame.queries[index * 2 + 1], GL_TIMESTAMP);
+				gpuFrame.lastQuery = index * 2 + 1;
+			}
+		}
+		void shutdown()
+		{
+			for (GPUFrame& gpuFrame : s_gpuFrames) {
+				if (!gpuFrame.queries.empty()) {
+					glDeleteQueries((int)gpuFrame.queries.size(), gpuFrame.queries.data());
+				}
+				gpuFrame = GPUFrame();
+			}
+			s_gpuStack.clear();
+		}
+	}
+}
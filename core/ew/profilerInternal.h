@@ -0,0 +1,22 @@
+#pragma once
+#include "profiler.h"
+
+//Shared by the profiler's source files: profiler.cpp records CPU scopes and frames without GL or ImGui,
+//profilerGPU.cpp adds the GPU scopes and profilerWindow.cpp the ImGui window
+namespace ew {
+	namespace profiler {
+		namespace internal {
+			//Called by beginFrame and endFrame with the frame index. Installed by the GPU scopes on first use
+			struct FrameHooks {
+				void (*beginFrame)(uint64_t frameIndex) = nullptr;
+				void (*endFrame)(uint64_t frameIndex) = nullptr;
+			};
+			void setFrameHooks(const FrameHooks& hooks);
+			int64_t nowNs();
+			bool isInFrame();
+			uint64_t getFrameIndex(); //Index of the current frame, or of the next one between frames
+			ProfileFrame* findFrame(uint64_t frameIndex); //nullptr once the frame has left the history
+			std::string getThreadName(uint16_t thread); //A copy, as the thread may rename itself at any time
+		}
+	}
+}
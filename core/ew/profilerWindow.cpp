@@ -0,0 +1,143 @@
+#include "profiler.h"
+#include "profilerInternal.h"
+#include <imgui.h>
+#include <float.h>
+#include <algorithm>
+
+static int s_selectedFrame = ew::profiler::GPU_LATENCY;
+static std::string s_exportStatus;
+
+static uint32_t hashName(const char* name) {
+	uint32_t hash = 2166136261u;
+	for (const char* c = name; *c; c++)
+	{
+		hash = (hash ^ (uint8_t)*c) * 16777619u;
+	}
+	return hash;
+}
+
+namespace ew {
+	namespace profiler {
+		/// <summary>
+		/// Draws frame times and a flame graph of one frame: a lane per thread with nested scopes stacked below
+		/// their parents, then the GPU lane. Hover a scope for its duration.
+		/// </summary>
+		void drawWindow(bool* open)
+		{
+			ImGui::SetNextWindowSize(ImVec2(720, 420), ImGuiCond_FirstUseEver);
+			if (!ImGui::Begin("Profiler", open)) {
+				ImGui::End();
+				return;
+			}
+			bool enabled = isEnabled();
+			if (ImGui::Checkbox("Record", &enabled)) {
+				setEnabled(enabled);
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Export Chrome trace")) {
+				s_exportStatus = writeChromeTrace("profile_trace.json") ? "Wrote profile_trace.json" : "Export failed";
+			}
+			if (!s_exportStatus.empty()) {
+				ImGui::SameLine();
+				ImGui::TextUnformatted(s_exportStatus.c_str());
+			}
+
+			const int numFrames = getNumFrames();
+			float frameMs[HISTORY_SIZE];
+			for (int i = 0; i < numFrames; i++)
+			{
+				const ProfileFrame* frame = getFrame(numFrames - 1 - i);
+				frameMs[i] = (frame->endNs - frame->startNs) / 1e6f;
+			}
+			ImGui::PlotLines("##FrameTimes", frameMs, numFrames, 0, "Frame time (ms)", 0.0f, FLT_MAX, ImVec2(-1, 50));
+			ImGui::SliderInt("Frames ago", &s_selectedFrame, 0, std::max(numFrames - 1, 0));
+			const ProfileFrame* frame = getFrame(s_selectedFrame);
+			if (!frame) {
+				ImGui::Text("No frames recorded");
+				ImGui::End();
+				return;
+			}
+			float gpuMs = 0.0f;
+			for (const ProfileEvent& event : frame->gpuEvents) {
+				if (event.depth == 0) {
+					gpuMs += (event.endNs - event.startNs) / 1e6f;
+				}
+			}
+			if (frame->gpuReady) {
+				ImGui::Text("Frame %llu: CPU %.3fms, GPU scopes %.3fms, %i dropped", (unsigned long long)frame->index, (frame->endNs - frame->startNs) / 1e6f, gpuMs, frame->numDropped);
+			}
+			else {
+				ImGui::Text("Frame %llu: CPU %.3fms, GPU pending, %i dropped", (unsigned long long)frame->index, (frame->endNs - frame->startNs) / 1e6f, frame->numDropped);
+			}
+
+			//Lanes: the frame thread first, then other threads in index order, then the GPU
+			std::vector<int> lanes;
+			std::vector<int> laneDepths;
+			auto addLane = [&](int thread, int depth) {
+				auto it = std::find(lanes.begin(), lanes.end(), thread);
+				if (it == lanes.end()) {
+					lanes.push_back(thread);
+					laneDepths.push_back(depth + 1);
+				}
+				else {
+					int& laneDepth = laneDepths[it - lanes.begin()];
+					laneDepth = std::max(laneDepth, depth + 1);
+				}
+			};
+			addLane(frame->thread, 0);
+			for (const ProfileEvent& event : frame->events) {
+				addLane(event.thread, event.depth);
+			}
+			int64_t rangeEnd = frame->endNs;
+			for (const ProfileEvent& event : frame->gpuEvents) {
+				addLane(GPU_THREAD, event.depth);
+				rangeEnd = std::max(rangeEnd, event.endNs);
+			}
+			const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+			int numRows = 0;
+			for (int depth : laneDepths) {
+				numRows += depth + 1; //Label row
+			}
+			ImVec2 origin = ImGui::GetCursorScreenPos();
+			ImVec2 size(std::max(ImGui::GetContentRegionAvail().x, 100.0f), numRows * rowHeight);
+			ImGui::InvisibleButton("##FlameGraph", size);
+			bool hovered = ImGui::IsItemHovered();
+			ImVec2 mouse = ImGui::GetIO().MousePos;
+			ImDrawList* drawList = ImGui::GetWindowDrawList();
+			drawList->AddRectFilled(origin, ImVec2(origin.x + size.x, origin.y + size.y), IM_COL32(30, 30, 30, 255));
+			const double pixelsPerNs = size.x / (double)std::max<int64_t>(rangeEnd - frame->startNs, 1);
+			const ProfileEvent* hoveredEvent = nullptr;
+			auto drawEvent = [&](const ProfileEvent& event, float laneY) {
+				float x0 = origin.x + (float)((std::max(event.startNs, frame->startNs) - frame->startNs) * pixelsPerNs);
+				float x1 = origin.x + (float)((std::min(event.endNs, rangeEnd) - frame->startNs) * pixelsPerNs);
+				x1 = std::max(x1, x0 + 1.0f);
+				float y0 = laneY + (event.depth + 1) * rowHeight;
+				float y1 = y0 + rowHeight - 1.0f;
+				ImU32 color = ImColor::HSV((hashName(event.name) % 360) / 360.0f, 0.5f, 0.75f);
+				drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), color);
+				if (ImGui::CalcTextSize(event.name).x < x1 - x0 - 4.0f) {
+					drawList->AddText(ImVec2(x0 + 2.0f, y0), IM_COL32(0, 0, 0, 255), event.name);
+				}
+				if (hovered && mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1) {
+					hoveredEvent = &event;
+				}
+			};
+			float laneY = origin.y;
+			for (size_t lane = 0; lane < lanes.size(); lane++)
+			{
+				drawList->AddText(ImVec2(origin.x + 2.0f, laneY), IM_COL32(200, 200, 200, 255), internal::getThreadName((uint16_t)lanes[lane]).c_str());
+				const std::vector<ProfileEvent>& events = lanes[lane] == GPU_THREAD ? frame->gpuEvents : frame->events;
+				for (const ProfileEvent& event : events) {
+					if (event.thread == lanes[lane]) {
+						drawEvent(event, laneY);
+					}
+				}
+				laneY += (laneDepths[lane] + 1) * rowHeight;
+			}
+			if (hoveredEvent) {
+				ImGui::SetTooltip("%s\n%.3fms", hoveredEvent->name, (hoveredEvent->endNs - hoveredEvent->startNs) / 1e6f);
+			}
+			ImGui::End();
+		}
+	}
+}
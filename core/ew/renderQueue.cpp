@@ -0,0 +1,162 @@
+#include "renderQueue.h"
+#include "glState.h"
+#include "external/glad.h"
+#include <chrono>
+#include <string.h>
+
+//Sort key layout, most significant bits first:
+//Opaque:      [1 transparent=0][12 shader][12 texture][12 mesh][24 depth, near first][3 unused]
+//Transparent: [1 transparent=1][24 depth, far first][12 shader][12 texture][12 mesh][3 unused]
+static const int STATE_BITS = 12;
+static const uint64_t STATE_MASK = (1 << STATE_BITS) - 1;
+
+/// <summary>
+/// Converts a non-negative depth to 24 bits that sort in the same order. The bit pattern of a
+/// positive float increases with its value, so its top bits can be used without knowing the depth range.
+/// </summary>
+static uint64_t quantizeDepth(float depth) {
+	if (!(depth > 0.0f)) {
+		return 0;
+	}
+	uint32_t bits;
+	memcpy(&bits, &depth, sizeof(bits));
+	return (bits >> 7) & 0xFFFFFF;
+}
+
+namespace ew {
+	/// <summary>
+	/// Adds a draw to the queue
+	/// </summary>
+	/// <param name="texture">Texture bound to unit 0, or 0 for none</param>
+	/// <param name="depth">Distance from the camera, used to order draws</param>
+	/// <param name="transparent">Transparent draws are drawn after opaque ones, back to front</param>
+	void RenderQueue::submit(const Mesh& mesh, const Shader& shader, unsigned int texture, const ew::Mat4& model, float depth, bool transparent)
+	{
+		DrawItem item = { &mesh, &shader, texture, model, depth, transparent };
+		m_items.push_back(item);
+		m_sorted = false;
+	}
+	/// <summary>
+	/// Adds a draw to the queue, using the distance from the camera to the model's origin as depth
+	/// </summary>
+	void RenderQueue::submit(const Mesh& mesh, const Shader& shader, unsigned int texture, const ew::Mat4& model, const ew::Vec3& cameraPosition, bool transparent)
+	{
+		float depth = ew::Magnitude(model[3].toVec3() - cameraPosition);
+		submit(mesh, shader, texture, model, depth, transparent);
+	}
+	/// <summary>
+	/// Builds the sort key for a draw. GL object names are truncated to 12 bits, which can only
+	/// make unrelated objects sort together, never break the depth ordering of transparent draws.
+	/// </summary>
+	uint64_t RenderQueue::makeSortKey(const DrawItem& item)
+	{
+		uint64_t state = ((item.shader->getID() & STATE_MASK) << (STATE_BITS * 2))
+			| ((item.texture & STATE_MASK) << STATE_BITS)
+			| (item.mesh->getVAO() & STATE_MASK);
+		uint64_t depth = quantizeDepth(item.depth);
+		if (item.transparent) {
+			return (1ull << 63) | ((0xFFFFFF - depth) << 39) | (state << 3);
+		}
+		return (state << 27) | (depth << 3);
+	}
+	/// <summary>
+	/// Sorts submitted draws. Called by execute if needed.
+	/// </summary>
+	void RenderQueue::sort()
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		m_keys.resize(m_items.size());
+		m_order.resize(m_items.size());
+		for (size_t i = 0; i < m_items.size(); i++)
+		{
+			m_keys[i] = makeSortKey(m_items[i]);
+			m_order[i] = (uint32_t)i;
+		}
+		radixSort(m_keys, m_order, m_tempKeys, m_tempOrder);
+		m_sorted = true;
+		m_stats.sortMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+	/// <summary>
+	/// Issues all draws in sorted order. Shader uniforms other than _Model and _NormalMatrix must already be set.
+	/// </summary>
+	void RenderQueue::execute()
+	{
+		if (!m_sorted) {
+			sort();
+		}
+		GLStateCounters countersBefore = ew::state::getCounters();
+		auto start = std::chrono::high_resolution_clock::now();
+		for (uint32_t index : m_order)
+		{
+			const DrawItem& item = m_items[index];
+			item.shader->use();
+			ew::state::bindTexture(0, GL_TEXTURE_2D, item.texture);
+			item.shader->setMat4("_Model", item.model);
+			item.shader->setMat4("_NormalMatrix", ew::NormalMatrix(item.model));
+			item.mesh->draw();
+		}
+		m_stats.submitMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		GLStateCounters countersAfter = ew::state::getCounters();
+		m_stats.numDraws = (int)m_order.size();
+		m_stats.stateCallsIssued = countersAfter.issued - countersBefore.issued;
+		m_stats.stateCallsFiltered = countersAfter.filtered - countersBefore.filtered;
+	}
+	/// <summary>
+	/// Removes all draws. Call once per frame after execute.
+	/// </summary>
+	void RenderQueue::clear()
+	{
+		m_items.clear();
+		m_keys.clear();
+		m_order.clear();
+		m_sorted = false;
+	}
+
+	/// <summary>
+	/// Stable least significant digit radix sort of 64 bit keys, 8 bits per pass.
+	/// Passes where every key has the same byte are skipped, which is common for the unused high bits of sort keys.
+	/// </summary>
+	/// <param name="keys">Keys to sort</param>
+	/// <param name="values">Payload moved along with each key</param>
+	/// <param name="tempKeys">Scratch space, reused between calls to avoid allocating</param>
+	/// <param name="tempValues">Scratch space, reused between calls to avoid allocating</param>
+	void radixSort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values, std::vector<uint64_t>& tempKeys, std::vector<uint32_t>& tempValues)
+	{
+		const size_t count = keys.size();
+		tempKeys.resize(count);
+		tempValues.resize(count);
+		//Histograms for all 8 passes are built in one read of the keys
+		uint32_t histograms[8][256] = {};
+		for (size_t i = 0; i < count; i++)
+		{
+			uint64_t key = keys[i];
+			for (int pass = 0; pass < 8; pass++)
+			{
+				histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+			}
+		}
+		for (int pass = 0; pass < 8; pass++)
+		{
+			uint32_t* histogram = histograms[pass];
+			int shift = pass * 8;
+			if (count == 0 || histogram[(keys[0] >> shift) & 0xFF] == count) {
+				continue;
+			}
+			uint32_t offset = 0;
+			for (int i = 0; i < 256; i++)
+			{
+				uint32_t bucketCount = histogram[i];
+				histogram[i] = offset;
+				offset += bucketCount;
+			}
+			for (size_t i = 0; i < count; i++)
+			{
+				uint32_t destination = histogram[(keys[i] >> shift) & 0xFF]++;
+				tempKeys[destination] = keys[i];
+				tempValues[destination] = values[i];
+			}
+			keys.swap(tempKeys);
+			values.swap(tempValues);
+		}
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include "ewMath/ewMath.h"
+#include "mesh.h"
+#include "shader.h"
+
+namespace ew {
+	//A single draw waiting in a RenderQueue
+	struct DrawItem {
+		const Mesh* mesh;
+		const Shader* shader;
+		unsigned int texture; //Bound to GL_TEXTURE_2D unit 0. 0 for none
+		ew::Mat4 model; //Set as _Model, and its NormalMatrix as _NormalMatrix
+		float depth; //Distance from the camera
+		bool transparent;
+	};
+
+	struct RenderQueueStats {
+		int numDraws = 0;
+		unsigned int stateCallsIssued = 0;
+		unsigned int stateCallsFiltered = 0;
+		float sortMs = 0.0f;
+		float submitMs = 0.0f; //CPU time spent issuing GL calls
+	};
+
+	//Collects draws for a frame and sorts them by 64 bit key to minimize state changes.
+	//Opaque draws are grouped by shader, texture and mesh, then ordered front to back.
+	//Transparent draws come last, ordered back to front.
+	class RenderQueue {
+	public:
+		void submit(const Mesh& mesh, const Shader& shader, unsigned int texture, const ew::Mat4& model, float depth, bool transparent = false);
+		void submit(const Mesh& mesh, const Shader& shader, unsigned int texture, const ew::Mat4& model, const ew::Vec3& cameraPosition, bool transparent = false);
+		void sort();
+		void execute();
+		void clear();
+		inline int size()const { return (int)m_items.size(); }
+		inline const RenderQueueStats& getStats()const { return m_stats; }
+		static uint64_t makeSortKey(const DrawItem& item);
+	private:
+		std::vector<DrawItem> m_items;
+		std::vector<uint64_t> m_keys;
+		std::vector<uint32_t> m_order; //Indices into m_items in draw order
+		std::vector<uint64_t> m_tempKeys;
+		std::vector<uint32_t> m_tempOrder;
+		bool m_sorted = false;
+		RenderQueueStats m_stats;
+	};
+
+	void radixSort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values, std::vector<uint64_t>& tempKeys, std::vector<uint32_t>& tempValues);
+}
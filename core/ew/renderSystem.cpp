@@ -0,0 +1,100 @@
+#include "renderSystem.h"
+
+namespace ew {
+	void UpdateWorldBounds(World& world, int numThreads)
+	{
+		world.parallelEach<Transform, Bounds>([](const Transform& transform, Bounds& bounds) {
+			bounds.world = transform.getWorldBounds(bounds.local);
+		}, numThreads);
+	}
+
+	/// <summary>
+	/// Each thread culls and builds model matrices into its own list. Thread 0 writes straight into renderables, so its
+	/// capacity is reused between frames. The lists are joined in thread order, and threads get consecutive ranges
+	/// of entities, so the result doesn't depend on the thread count
+	/// </summary>
+	void GatherRenderables(World& world, const Frustum& frustum, const ew::Vec3& cameraPosition, std::vector<Renderable>& renderables, int numThreads)
+	{
+		if (numThreads < 1) {
+			numThreads = 1;
+		}
+		size_t total = 0;
+		world.eachChunk<Transform, MeshRef, MaterialRef>([&total](const ChunkView& chunk) {
+			total += chunk.size();
+		});
+		//Same split as parallelEachChunk, which uses fewer threads for small worlds. No range exceeds its even share,
+		//so the lists never grow while gathering
+		numThreads = World::parallelRanges(total, numThreads);
+		const size_t perThread = (total + numThreads - 1) / numThreads;
+		renderables.clear();
+		renderables.reserve(perThread);
+		std::vector<std::vector<Renderable>> otherThreads(numThreads - 1);
+		for (std::vector<Renderable>& list : otherThreads) {
+			list.reserve(perThread);
+		}
+		world.parallelEachChunk<Transform, MeshRef, MaterialRef>([&](int thread, const ChunkView& chunk) {
+			const Transform* transforms = chunk.get<Transform>();
+			const MeshRef* meshes = chunk.get<MeshRef>();
+			const MaterialRef* materials = chunk.get<MaterialRef>();
+			const Bounds* bounds = chunk.get<Bounds>();
+			std::vector<Renderable>& out = thread == 0 ? renderables : otherThreads[thread - 1];
+			for (size_t i = 0; i < chunk.size(); i++)
+			{
+				if (bounds && !IsVisible(frustum, bounds[i].world)) {
+					continue;
+				}
+				const ew::Mat4 model = transforms[i].getModelMatrix();
+				out.push_back({ &meshes[i], &materials[i], model, ew::Magnitude(model[3].toVec3() - cameraPosition) });
+			}
+		}, numThreads);
+		for (const std::vector<Renderable>& list : otherThreads) {
+			renderables.insert(renderables.end(), list.begin(), list.end());
+		}
+	}
+
+	void GatherRenderables(World& world, const std::vector<Entity>& entities, const std::vector<uint8_t>& visible, const ew::Vec3& cameraPosition, std::vector<Renderable>& renderables)
+	{
+		renderables.clear();
+		for (size_t i = 0; i < entities.size(); i++)
+		{
+			if (!visible[i]) {
+				continue;
+			}
+			const Transform* transform = world.get<Transform>(entities[i]);
+			const MeshRef* mesh = world.get<MeshRef>(entities[i]);
+			const MaterialRef* material = world.get<MaterialRef>(entities[i]);
+			if (!transform || !mesh || !material) {
+				continue;
+			}
+			const ew::Mat4 model = transform->getModelMatrix();
+			renderables.push_back({ mesh, material, model, ew::Magnitude(model[3].toVec3() - cameraPosition) });
+		}
+	}
+
+	void SubmitRenderables(const std::vector<Renderable>& renderables, RenderQueue& queue)
+	{
+		for (const Renderable& renderable : renderables) {
+			if (!renderable.mesh->mesh || !renderable.material->shader) {
+				continue;
+			}
+			queue.submit(*renderable.mesh->mesh, *renderable.material->shader, renderable.material->texture, renderable.model, renderable.depth, renderable.material->transparent);
+		}
+	}
+
+	void SubmitRenderables(const std::vector<Renderable>& renderables, IndirectBatch& batch)
+	{
+		for (const Renderable& renderable : renderables) {
+			batch.add(renderable.mesh->allocation, renderable.model, renderable.material->materialIndex);
+		}
+	}
+
+	void GatherLights(World& world, std::vector<ew::Vec3>& positions, std::vector<ew::Vec3>& colors)
+	{
+		positions.clear();
+		colors.clear();
+		world.each<Transform, Light>([&](const Transform& transform, const Light& light) {
+			positions.push_back(transform.position);
+			colors.push_back(light.color * light.intensity);
+		});
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <vector>
+#include "ecs.h"
+#include "frustum.h"
+#include "renderQueue.h"
+#include "geometryArena.h"
+
+namespace ew {
+	//A visible entity found by GatherRenderables. The pointers are into the World's component arrays
+	struct Renderable {
+		const MeshRef* mesh;
+		const MaterialRef* material;
+		ew::Mat4 model;
+		float depth; //Distance from the camera
+	};
+
+	//Systems for entities with the components in ecs.h. numThreads splits the entities into up to that many jobs on DefaultJobSystem (jobSystem.h)
+
+	//Recomputes Bounds::world from Bounds::local for every entity with Transform and Bounds
+	void UpdateWorldBounds(World& world, int numThreads = 1);
+	//Collects the entities with Transform, MeshRef and MaterialRef, skipping those with Bounds outside the frustum.
+	//Output order is the same for any numThreads
+	void GatherRenderables(World& world, const Frustum& frustum, const ew::Vec3& cameraPosition, std::vector<Renderable>& renderables, int numThreads = 1);
+	//Collects entities[i] for every visible[i] that is set, e.g. after culling their bounds with a BVH or occlusion culler.
+	//Entities without Transform, MeshRef and MaterialRef are skipped
+	void GatherRenderables(World& world, const std::vector<Entity>& entities, const std::vector<uint8_t>& visible, const ew::Vec3& cameraPosition, std::vector<Renderable>& renderables);
+	void SubmitRenderables(const std::vector<Renderable>& renderables, RenderQueue& queue);
+	void SubmitRenderables(const std::vector<Renderable>& renderables, IndirectBatch& batch);
+	//Positions and colors (scaled by intensity) of entities with Transform and Light, for _LightsArray style uniforms
+	void GatherLights(World& world, std::vector<ew::Vec3>& positions, std::vector<ew::Vec3>& colors);
+}
@@ -1,9 +1,189 @@
 #include "shader.h"
 #include <fstream>
 #include <sstream>
+#include <filesystem>
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
 #include "external/glad.h"
+#include "glState.h"
 
 namespace ew {
+	/// <summary>
+	/// shaderCache next to the executable, so runs from any working directory share it.
+	/// Falls back to the working directory where the executable path is unknown.
+	/// </summary>
+	static std::string getDefaultShaderCacheDirectory() {
+#ifdef __linux__
+		std::error_code error;
+		std::filesystem::path executable = std::filesystem::read_symlink("/proc/self/exe", error);
+		if (!error) {
+			return (executable.parent_path() / "shaderCache").string();
+		}
+#endif
+		return "shaderCache";
+	}
+	//Directory linked program binaries are cached in. Empty disables the cache.
+	static std::string s_shaderCacheDirectory = getDefaultShaderCacheDirectory();
+	static const uint32_t PROGRAM_BINARY_MAGIC = 0x42505745; //"EWPB"
+	//Least recently used binaries are deleted past this size. Every edited shader leaves a binary behind
+	static const uintmax_t MAX_SHADER_CACHE_BYTES = 32 * 1024 * 1024;
+
+	/// <summary>
+	/// Sets the directory where linked program binaries are cached between runs. Pass an empty string to disable caching.
+	/// Defaults to shaderCache next to the executable. Past 32 MB, the least recently used binaries are deleted.
+	/// </summary>
+	/// <param name="directory"></param>
+	void setShaderCacheDirectory(const std::string& directory) {
+		s_shaderCacheDirectory = directory;
+	}
+	/// <summary>
+	/// Directory linked program binaries are cached in. Empty if caching is disabled
+	/// </summary>
+	const std::string& getShaderCacheDirectory() {
+		return s_shaderCacheDirectory;
+	}
+
+	/// <summary>
+	/// FNV-1a hash, used to key cached program binaries
+	/// </summary>
+	static uint64_t hashString(const char* str, uint64_t hash = 14695981039346656037ull) {
+		for (; *str; str++) {
+			hash ^= (unsigned char)*str;
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	/// <summary>
+	/// Builds the cache file path for a vertex + fragment pair. The driver strings are part of the key
+	/// since binaries are only valid for the driver that produced them.
+	/// </summary>
+	/// <returns>Empty string if caching is disabled or unsupported</returns>
+	static std::string getProgramCachePath(const char* vertexShaderSource, const char* fragmentShaderSource) {
+		if (s_shaderCacheDirectory.empty()) {
+			return {};
+		}
+		int numFormats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+		if (numFormats <= 0) {
+			return {};
+		}
+		uint64_t hash = hashString(vertexShaderSource);
+		hash = hashString("\x1f", hash);
+		hash = hashString(fragmentShaderSource, hash);
+		const GLenum driverStrings[3] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+		for (GLenum name : driverStrings) {
+			const char* str = (const char*)glGetString(name);
+			hash = hashString(str ? str : "", hash);
+		}
+		char fileName[32];
+		snprintf(fileName, sizeof(fileName), "%016llx.bin", (unsigned long long)hash);
+		return s_shaderCacheDirectory + "/" + fileName;
+	}
+
+	/// <summary>
+	/// Creates a program from a cached binary
+	/// </summary>
+	/// <returns>Linked program, or 0 if there is no cached binary or the driver rejected it</returns>
+	static unsigned int loadProgramBinary(const std::string& cachePath) {
+		std::ifstream file(cachePath, std::ios::binary);
+		if (!file.is_open()) {
+			return 0;
+		}
+		uint32_t header[3]; //Magic, format, length
+		if (!file.read((char*)header, sizeof(header)) || header[0] != PROGRAM_BINARY_MAGIC) {
+			return 0;
+		}
+		//A truncated or corrupt file could claim any length, so it has to match what is on disk
+		std::error_code error;
+		const uintmax_t fileSize = std::filesystem::file_size(cachePath, error);
+		if (error || fileSize != sizeof(header) + (uintmax_t)header[2]) {
+			file.close();
+			std::filesystem::remove(cachePath, error);
+			return 0;
+		}
+		std::vector<char> binary(header[2]);
+		if (!file.read(binary.data(), binary.size())) {
+			return 0;
+		}
+		unsigned int program = glCreateProgram();
+		glProgramBinary(program, header[1], binary.data(), (GLsizei)binary.size());
+		int success;
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		if (!success) {
+			//Driver updates invalidate binaries, so a rejected binary is expected. Recompile from source instead.
+			glDeleteProgram(program);
+			file.close();
+			std::filesystem::remove(cachePath, error);
+			return 0;
+		}
+		//Marks the binary as recently used for pruneShaderCache
+		std::filesystem::last_write_time(cachePath, std::filesystem::file_time_type::clock::now(), error);
+		return program;
+	}
+
+	/// <summary>
+	/// Deletes the least recently used binaries until the cache fits in MAX_SHADER_CACHE_BYTES
+	/// </summary>
+	static void pruneShaderCache() {
+		struct Entry {
+			std::filesystem::path path;
+			std::filesystem::file_time_type lastUsed;
+			uintmax_t size;
+		};
+		std::vector<Entry> entries;
+		uintmax_t totalSize = 0;
+		std::error_code error;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(s_shaderCacheDirectory, error)) {
+			if (entry.path().extension() != ".bin" || !entry.is_regular_file(error)) {
+				continue;
+			}
+			const uintmax_t size = entry.file_size(error);
+			entries.push_back({ entry.path(), entry.last_write_time(error), size });
+			totalSize += size;
+		}
+		if (totalSize <= MAX_SHADER_CACHE_BYTES) {
+			return;
+		}
+		std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.lastUsed < b.lastUsed; });
+		for (const Entry& entry : entries) {
+			if (totalSize <= MAX_SHADER_CACHE_BYTES) {
+				break;
+			}
+			if (std::filesystem::remove(entry.path, error)) {
+				totalSize -= entry.size;
+			}
+		}
+	}
+
+	/// <summary>
+	/// Writes a linked program's binary to the cache
+	/// </summary>
+	static void saveProgramBinary(unsigned int program, const std::string& cachePath) {
+		int length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0) {
+			return;
+		}
+		std::vector<char> binary(length);
+		GLenum format;
+		glGetProgramBinary(program, length, &length, &format, binary.data());
+
+		std::error_code error;
+		std::filesystem::create_directories(s_shaderCacheDirectory, error);
+		std::ofstream file(cachePath, std::ios::binary);
+		if (!file.is_open()) {
+			printf("Failed to write shader cache %s", cachePath.c_str());
+			return;
+		}
+		uint32_t header[3] = { PROGRAM_BINARY_MAGIC, format, (uint32_t)length };
+		file.write((const char*)header, sizeof(header));
+		file.write(binary.data(), length);
+		file.close();
+		pruneShaderCache();
+	}
+
 	/// <summary>
 	/// Loads shader source code from a file.
 	/// </summary>
@@ -21,27 +201,113 @@ namespace ew {
 	}
 
 	/// <summary>
-	/// Creates and compiles a shader object of a given type
+	/// Lets the driver use as many compiler threads as it wants, through KHR_parallel_shader_compile or the equivalent ARB extension.
+	/// Compiler threads are per context state, so this is done for whichever context is current.
 	/// </summary>
-	/// <param name="shaderType">Expects GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, etc.</param>
-	/// <param name="sourceCode">GLSL source code for the shader stage</param>
-	/// <returns></returns>
-	static unsigned int createShader(GLenum shaderType, const char* sourceCode) {
-		//Create a new vertex shader object
-		unsigned int shader = glCreateShader(shaderType);
-		//Supply the shader object with source code
-		glShaderSource(shader, 1, &sourceCode, NULL);
-		//Compile the shader object
-		glCompileShader(shader);
+	static void setMaxShaderCompilerThreads() {
+		//0xFFFFFFFF = implementation chosen number of threads
+		if (GLAD_GL_KHR_parallel_shader_compile) {
+			glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+		}
+		else if (GLAD_GL_ARB_parallel_shader_compile) {
+			glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+		}
+	}
+	/// <summary>
+	/// True if shader programs can be compiled asynchronously in the current context.
+	/// glad checks for the extensions when it is loaded for the context.
+	/// </summary>
+	bool isParallelShaderCompileSupported() {
+		return GLAD_GL_KHR_parallel_shader_compile || GLAD_GL_ARB_parallel_shader_compile;
+	}
+
+	/// <summary>
+	/// Starts compiling and linking a shader program without waiting on the driver.
+	/// Loads the program from the binary cache instead if possible.
+	/// </summary>
+	/// <param name="vertexShaderSource">GLSL source code for the vertex shader</param>
+	/// <param name="fragmentShaderSource">GLSL source code for the fragment shader</param>
+	/// <returns>In-flight build, to be polled with isShaderProgramComplete and finished with finishShaderProgram</returns>
+	ShaderProgramBuild beginShaderProgram(const char* vertexShaderSource, const char* fragmentShaderSource) {
+		setMaxShaderCompilerThreads();
+		ShaderProgramBuild build;
+		build.cachePath = getProgramCachePath(vertexShaderSource, fragmentShaderSource);
+		if (!build.cachePath.empty()) {
+			build.program = loadProgramBinary(build.cachePath);
+			if (build.program != 0) {
+				build.fromCache = true;
+				return build;
+			}
+		}
+		build.vertexShader = glCreateShader(GL_VERTEX_SHADER);
+		glShaderSource(build.vertexShader, 1, &vertexShaderSource, NULL);
+		glCompileShader(build.vertexShader);
+		build.fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+		glShaderSource(build.fragmentShader, 1, &fragmentShaderSource, NULL);
+		glCompileShader(build.fragmentShader);
+
+		build.program = glCreateProgram();
+		//Attach each stage
+		glAttachShader(build.program, build.vertexShader);
+		glAttachShader(build.program, build.fragmentShader);
+		if (!build.cachePath.empty()) {
+			glProgramParameteri(build.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		}
+		//Link all the stages together. With parallel compile this returns immediately.
+		glLinkProgram(build.program);
+		return build;
+	}
+
+	/// <summary>
+	/// Polls whether the driver has finished compiling and linking. Never blocks.
+	/// Without parallel compile support this always returns true, and finishShaderProgram will block instead.
+	/// </summary>
+	bool isShaderProgramComplete(const ShaderProgramBuild& build) {
+		if (build.fromCache || !isParallelShaderCompileSupported()) {
+			return true;
+		}
+		int complete = 0;
+		glGetProgramiv(build.program, GL_COMPLETION_STATUS_KHR, &complete);
+		return complete;
+	}
+
+	/// <summary>
+	/// Checks compile and link status, prints any errors, and writes the program to the binary cache
+	/// </summary>
+	/// <returns>Program handle. Check build.linked for success</returns>
+	unsigned int finishShaderProgram(ShaderProgramBuild& build) {
+		if (build.fromCache) {
+			build.linked = true;
+			return build.program;
+		}
+		GLuint stages[2] = { build.vertexShader, build.fragmentShader };
+		for (GLuint stage : stages) {
+			int success;
+			glGetShaderiv(stage, GL_COMPILE_STATUS, &success);
+			if (!success) {
+				char infoLog[512];
+				glGetShaderInfoLog(stage, 512, NULL, infoLog);
+				printf("Failed to compile shader: %s", infoLog);
+				build.log += infoLog;
+			}
+		}
 		int success;
-		glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+		glGetProgramiv(build.program, GL_LINK_STATUS, &success);
 		if (!success) {
-			//512 is an arbitrary length, but should be plenty of characters for our error message.
 			char infoLog[512];
-			glGetShaderInfoLog(shader, 512, NULL, infoLog);
-			printf("Failed to compile shader: %s", infoLog);
+			glGetProgramInfoLog(build.program, 512, NULL, infoLog);
+			printf("Failed to link shader program: %s", infoLog);
+			build.log += infoLog;
 		}
-		return shader;
+		else if (!build.cachePath.empty()) {
+			saveProgramBinary(build.program, build.cachePath);
+		}
+		build.linked = success;
+		//The linked program now contains our compiled code, so we can delete these intermediate objects
+		glDeleteShader(build.vertexShader);
+		glDeleteShader(build.fragmentShader);
+		build.vertexShader = build.fragmentShader = 0;
+		return build.program;
 	}
 
 	/// <summary>
@@ -51,41 +317,296 @@ namespace ew {
 	/// <param name="fragmentShaderSource">GLSL source code for the fragment shader</param>
 	/// <returns></returns>
 	unsigned int createShaderProgram(const char* vertexShaderSource, const char* fragmentShaderSource) {
-		unsigned int vertexShader = createShader(GL_VERTEX_SHADER, vertexShaderSource);
-		unsigned int fragmentShader = createShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
-
-		unsigned int shaderProgram = glCreateProgram();
-		//Attach each stage
-		glAttachShader(shaderProgram, vertexShader);
-		glAttachShader(shaderProgram, fragmentShader);
-		//Link all the stages together
-		glLinkProgram(shaderProgram);
+		ShaderProgramBuild build = beginShaderProgram(vertexShaderSource, fragmentShaderSource);
+		return finishShaderProgram(build);
+	}
+	/// <summary>
+	/// Creates a shader program with a single compute shader. Compute programs are not binary cached.
+	/// </summary>
+	/// <param name="computeShaderSource">GLSL source code for the compute shader</param>
+	/// <returns>Program handle, or 0 if compiling or linking failed</returns>
+	unsigned int createComputeProgram(const char* computeShaderSource) {
+		GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+		glShaderSource(shader, 1, &computeShaderSource, NULL);
+		glCompileShader(shader);
 		int success;
-		glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
 		if (!success) {
 			char infoLog[512];
-			glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-			printf("Failed to link shader program: %s", infoLog);
+			glGetShaderInfoLog(shader, 512, NULL, infoLog);
+			printf("Failed to compile compute shader: %s", infoLog);
+			glDeleteShader(shader);
+			return 0;
 		}
-		//The linked program now contains our compiled code, so we can delete these intermediate objects
-		glDeleteShader(vertexShader);
-		glDeleteShader(fragmentShader);
-		return shaderProgram;
+		GLuint program = glCreateProgram();
+		glAttachShader(program, shader);
+		glLinkProgram(program);
+		glDeleteShader(shader);
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		if (!success) {
+			char infoLog[512];
+			glGetProgramInfoLog(program, 512, NULL, infoLog);
+			printf("Failed to link compute program: %s", infoLog);
+			glDeleteProgram(program);
+			return 0;
+		}
+		return program;
 	}
+	/// <summary>
+	/// Inserts text into GLSL source on the line following the #version directive,
+	/// which is the earliest point #extension and #define lines are allowed.
+	/// </summary>
+	/// <param name="source">GLSL source code</param>
+	/// <param name="text">Text to insert. Should end with a newline</param>
+	/// <returns></returns>
+	std::string insertAfterVersion(const std::string& source, const std::string& text) {
+		if (text.empty()) {
+			return source;
+		}
+		size_t versionPos = source.find("#version");
+		if (versionPos == std::string::npos) {
+			return text + source;
+		}
+		size_t lineEnd = source.find('\n', versionPos);
+		if (lineEnd == std::string::npos) {
+			return source + "\n" + text;
+		}
+		//Restore line numbering so compile errors still point at the right line of the file
+		int nextLine = (int)std::count(source.begin(), source.begin() + lineEnd, '\n') + 2;
+		return source.substr(0, lineEnd + 1) + text + "#line " + std::to_string(nextLine) + " 0\n" + source.substr(lineEnd + 1);
+	}
+
+	/// <summary>
+	/// Recursively expands #include "file" directives. Each file is included at most once.
+	/// </summary>
+	/// <param name="filePath">File to expand</param>
+	/// <param name="files">Every file loaded so far. Index in this list is the GLSL source string number used in #line</param>
+	/// <param name="output">Expanded source is appended here</param>
+	static void expandIncludes(const std::string& filePath, std::vector<std::string>& files, std::string& output) {
+		const int MAX_INCLUDED_FILES = 64;
+		int fileIndex = (int)files.size();
+		files.push_back(filePath);
+		std::string source = ew::loadShaderSourceFromFile(filePath);
+		std::filesystem::path directory = std::filesystem::path(filePath).parent_path();
+		if (fileIndex > 0) {
+			output += "#line 1 " + std::to_string(fileIndex) + "\n";
+		}
+		std::istringstream lines(source);
+		std::string line;
+		int lineNumber = 0;
+		while (std::getline(lines, line)) {
+			lineNumber++;
+			size_t start = line.find_first_not_of(" \t");
+			if (start == std::string::npos || line.compare(start, 8, "#include") != 0) {
+				output += line;
+				output += '\n';
+				continue;
+			}
+			size_t open = line.find('"', start);
+			size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+			if (close == std::string::npos) {
+				printf("Malformed #include in %s line %i", filePath.c_str(), lineNumber);
+				output += "\n";
+				continue;
+			}
+			std::string includePath = (directory / line.substr(open + 1, close - open - 1)).lexically_normal().string();
+			if (std::find(files.begin(), files.end(), includePath) == files.end()) {
+				if (files.size() >= MAX_INCLUDED_FILES) {
+					printf("Too many files included from %s", filePath.c_str());
+				}
+				else {
+					expandIncludes(includePath, files, output);
+				}
+			}
+			output += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileIndex) + "\n";
+		}
+	}
+
+	/// <summary>
+	/// Loads a shader file, expanding #include directives (relative to the including file)
+	/// and defining each of the given macros after #version.
+	/// </summary>
+	/// <param name="filePath">Shader file path</param>
+	/// <param name="defines">Macros to define, e.g. {{"BLINN_PHONG", ""}, {"NUM_LIGHTS", "4"}}</param>
+	/// <param name="includedFiles">Optional. Receives every file the source was built from, including filePath</param>
+	/// <returns>GLSL source code ready to compile</returns>
+	std::string preprocessShaderSource(const std::string& filePath, const ShaderDefines& defines, std::vector<std::string>* includedFiles) {
+		std::vector<std::string> files;
+		std::string source;
+		expandIncludes(filePath, files, source);
+		std::string defineLines;
+		for (const auto& define : defines) {
+			defineLines += "#define " + define.first + " " + define.second + "\n";
+		}
+		if (includedFiles != nullptr) {
+			*includedFiles = files;
+		}
+		return ew::insertAfterVersion(source, defineLines);
+	}
+
+	/// <summary>
+	/// Unique key for a set of defines, independent of their order
+	/// </summary>
+	static std::string getPermutationKey(ShaderDefines defines) {
+		std::sort(defines.begin(), defines.end());
+		std::string key;
+		for (const auto& define : defines) {
+			key += define.first + "=" + define.second + ";";
+		}
+		return key;
+	}
+
 	/// <summary>
 	/// Creates a shader instance with vertex + fragment stages
 	/// </summary>
 	/// <param name="vertexShader">File path to vertex shader</param>
 	/// <param name="fragmentShader">File path to fragment shader</param>
 	Shader::Shader(const std::string& vertexShader, const std::string& fragmentShader)
+		:Shader(vertexShader, fragmentShader, ShaderDefines(), std::string())
+	{
+	}
+	/// <summary>
+	/// Creates a shader instance with vertex + fragment stages, inserting shared GLSL declarations into both
+	/// </summary>
+	/// <param name="vertexShader">File path to vertex shader</param>
+	/// <param name="fragmentShader">File path to fragment shader</param>
+	/// <param name="header">GLSL inserted after #version in both stages (e.g. MaterialTable::getShaderHeader)</param>
+	Shader::Shader(const std::string& vertexShader, const std::string& fragmentShader, const std::string& header)
+		:Shader(vertexShader, fragmentShader, ShaderDefines(), header)
 	{
-		std::string vertexShaderSource = ew::loadShaderSourceFromFile(vertexShader.c_str());
-		std::string fragmentShaderSource = ew::loadShaderSourceFromFile(fragmentShader.c_str());
+	}
+	/// <summary>
+	/// Creates a shader permutation with vertex + fragment stages compiled with the given defines
+	/// </summary>
+	/// <param name="vertexShader">File path to vertex shader</param>
+	/// <param name="fragmentShader">File path to fragment shader</param>
+	/// <param name="defines">Macros defined in both stages</param>
+	/// <param name="header">GLSL inserted after #version in both stages (e.g. MaterialTable::getShaderHeader)</param>
+	Shader::Shader(const std::string& vertexShader, const std::string& fragmentShader, const ShaderDefines& defines, const std::string& header)
+		:m_vertexPath(vertexShader), m_fragmentPath(fragmentShader), m_header(header), m_defines(defines)
+	{
+		std::string vertexShaderSource = buildSource(vertexShader);
+		std::string fragmentShaderSource = buildSource(fragmentShader);
 		m_id = ew::createShaderProgram(vertexShaderSource.c_str(), fragmentShaderSource.c_str());
 	}
+	/// <summary>
+	/// Preprocesses one of this shader's files with its header and defines
+	/// </summary>
+	/// <param name="filePath">Vertex or fragment shader path</param>
+	/// <param name="includedFiles">Optional. Receives every file the source was built from</param>
+	std::string Shader::buildSource(const std::string& filePath, std::vector<std::string>* includedFiles) const
+	{
+		std::string source = ew::preprocessShaderSource(filePath, m_defines, includedFiles);
+		return ew::insertAfterVersion(source, m_header);
+	}
+	/// <summary>
+	/// Returns a permutation of this shader compiled with additional defines.
+	/// Each permutation is compiled on first use and cached by its set of defines.
+	/// </summary>
+	/// <param name="defines">Macros to define on top of this shader's own</param>
+	const Shader& Shader::getVariant(const ShaderDefines& defines) const
+	{
+		if (defines.empty() || m_vertexPath.empty()) {
+			return *this;
+		}
+		ShaderDefines allDefines = m_defines;
+		allDefines.insert(allDefines.end(), defines.begin(), defines.end());
+		std::string key = getPermutationKey(allDefines);
+		std::shared_ptr<Shader>& variant = (*m_variants)[key];
+		if (!variant) {
+			variant = std::make_shared<Shader>(m_vertexPath, m_fragmentPath, allDefines, m_header);
+		}
+		return *variant;
+	}
+	/// <summary>
+	/// Deletes all cached permutations so they recompile on next use (e.g. after hot reloading)
+	/// </summary>
+	void Shader::clearVariants()
+	{
+		for (auto& variant : *m_variants) {
+			ew::state::onProgramDeleted(variant.second->m_id);
+			glDeleteProgram(variant.second->m_id);
+		}
+		m_variants->clear();
+	}
+	/// <summary>
+	/// Wraps an already linked shader program
+	/// </summary>
+	/// <param name="programId">Shader program handle</param>
+	/// <param name="vertexShader">Optional. File path the vertex shader was built from, needed for variants and hot reloading</param>
+	/// <param name="fragmentShader">Optional. File path the fragment shader was built from</param>
+	/// <param name="defines">Optional. Macros the program was built with</param>
+	Shader::Shader(unsigned int programId, const std::string& vertexShader, const std::string& fragmentShader, const ShaderDefines& defines)
+		:m_id(programId), m_vertexPath(vertexShader), m_fragmentPath(fragmentShader), m_defines(defines)
+	{
+	}
+	/// <summary>
+	/// Submits compilation of a vertex + fragment shader pair without waiting for it to finish.
+	/// Create every AsyncShader up front so the driver can compile them in parallel.
+	/// </summary>
+	/// <param name="vertexShader">File path to vertex shader</param>
+	/// <param name="fragmentShader">File path to fragment shader</param>
+	/// <param name="defines">Optional macros defined in both stages</param>
+	/// <param name="header">Optional GLSL inserted after #version in both stages of this shader and its permutations (e.g. MaterialTable::getShaderHeader)</param>
+	AsyncShader::AsyncShader(const std::string& vertexShader, const std::string& fragmentShader, const ShaderDefines& defines, const std::string& header)
+		:m_vertexPath(vertexShader), m_fragmentPath(fragmentShader), m_defines(defines), m_header(header), m_permutationKey(getPermutationKey(defines))
+	{
+		std::string vertexShaderSource = ew::insertAfterVersion(ew::preprocessShaderSource(vertexShader, defines), header);
+		std::string fragmentShaderSource = ew::insertAfterVersion(ew::preprocessShaderSource(fragmentShader, defines), header);
+		m_build = ew::beginShaderProgram(vertexShaderSource.c_str(), fragmentShaderSource.c_str());
+	}
+	/// <summary>
+	/// Polls the driver and finishes the program once compilation completes. Never blocks when parallel compile is supported.
+	/// </summary>
+	/// <returns>True once the program has finished compiling and linking successfully</returns>
+	bool AsyncShader::isReady()
+	{
+		if (!m_finished && ew::isShaderProgramComplete(m_build)) {
+			m_shader = Shader(ew::finishShaderProgram(m_build), m_vertexPath, m_fragmentPath, m_defines);
+			m_finished = true;
+		}
+		return m_finished && m_build.linked;
+	}
+	/// <summary>
+	/// Returns the compiled shader, or fallback while it is still compiling (or failed to compile)
+	/// </summary>
+	const Shader& AsyncShader::get(const Shader& fallback)
+	{
+		return isReady() ? m_shader : fallback;
+	}
+	/// <summary>
+	/// Returns the program compiled with exactly these defines, or fallback while it is still compiling.
+	/// The first request for a set of defines submits its compilation, so switching permutations never blocks.
+	/// </summary>
+	/// <param name="defines">Macros defined in both stages, in any order. The constructor's defines return this shader's own program</param>
+	const Shader& AsyncShader::getPermutation(const ShaderDefines& defines, const Shader& fallback)
+	{
+		const std::string key = getPermutationKey(defines);
+		if (key == m_permutationKey) {
+			return get(fallback);
+		}
+		std::unique_ptr<AsyncShader>& permutation = m_permutations[key];
+		if (!permutation) {
+			permutation = std::make_unique<AsyncShader>(m_vertexPath, m_fragmentPath, defines, m_header);
+		}
+		return permutation->get(fallback);
+	}
+	/// <summary>
+	/// Replaces the program this shader uses and deletes the old one (e.g. after hot reloading).
+	/// Copies of this Shader will still reference the deleted program.
+	/// </summary>
+	/// <param name="programId">Linked shader program handle</param>
+	void Shader::setProgram(unsigned int programId)
+	{
+		if (m_id != programId) {
+			ew::state::onProgramDeleted(m_id);
+			glDeleteProgram(m_id);
+			m_id = programId;
+		}
+	}
 	void Shader::use()const
 	{
-		glUseProgram(m_id);
+		ew::state::useProgram(m_id);
 	}
 	void Shader::setBool(const std::string& name, bool v) const
 	{
@@ -1,13 +1,46 @@
 #pragma once
 #include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <utility>
 #include "ewMath/ewMath.h"
 
 namespace ew {
+	//Preprocessor macros as name, value pairs
+	typedef std::vector<std::pair<std::string, std::string>> ShaderDefines;
+
 	std::string loadShaderSourceFromFile(const std::string& filePath);
+	std::string preprocessShaderSource(const std::string& filePath, const ShaderDefines& defines, std::vector<std::string>* includedFiles = nullptr);
 	unsigned int createShaderProgram(const char* vertexShaderSource, const char* fragmentShaderSource);
+	unsigned int createComputeProgram(const char* computeShaderSource);
+	void setShaderCacheDirectory(const std::string& directory);
+	const std::string& getShaderCacheDirectory();
+
+	//A shader program whose compilation has been submitted to the driver but may not have finished
+	struct ShaderProgramBuild {
+		unsigned int program = 0;
+		unsigned int vertexShader = 0;
+		unsigned int fragmentShader = 0;
+		bool fromCache = false;
+		bool linked = false; //Set by finishShaderProgram
+		std::string cachePath;
+		std::string log; //Compile and link errors
+	};
+	bool isParallelShaderCompileSupported();
+	ShaderProgramBuild beginShaderProgram(const char* vertexShaderSource, const char* fragmentShaderSource);
+	bool isShaderProgramComplete(const ShaderProgramBuild& build);
+	unsigned int finishShaderProgram(ShaderProgramBuild& build);
+	std::string insertAfterVersion(const std::string& source, const std::string& text);
 	class Shader {
 	public:
 		Shader(const std::string& vertexShader, const std::string& fragmentShader);
+		Shader(const std::string& vertexShader, const std::string& fragmentShader, const std::string& header);
+		Shader(const std::string& vertexShader, const std::string& fragmentShader, const ShaderDefines& defines, const std::string& header = "");
+		explicit Shader(unsigned int programId, const std::string& vertexShader = "", const std::string& fragmentShader = "", const ShaderDefines& defines = ShaderDefines());
+		const Shader& getVariant(const ShaderDefines& defines) const;
+		void clearVariants();
+		std::string buildSource(const std::string& filePath, std::vector<std::string>* includedFiles = nullptr) const;
 		void use()const;
 		void setBool(const std::string& name, bool v) const;
 		void setInt(const std::string& name, int v) const;
@@ -19,7 +52,41 @@ namespace ew {
 		void setVec4(const std::string& name, float x, float y, float z, float w) const;
 		void setVec4(const std::string& name, const ew::Vec4& v) const;
 		void setMat4(const std::string& name, const ew::Mat4& m) const;
+		inline unsigned int getID()const { return m_id; }
+		void setProgram(unsigned int programId);
+		inline const std::string& getVertexPath()const { return m_vertexPath; }
+		inline const std::string& getFragmentPath()const { return m_fragmentPath; }
+		inline const std::string& getHeader()const { return m_header; }
+		inline const ShaderDefines& getDefines()const { return m_defines; }
 	private:
 		unsigned int m_id; //Shader program handle
+		std::string m_vertexPath; //Empty if not loaded from a file
+		std::string m_fragmentPath;
+		std::string m_header;
+		ShaderDefines m_defines;
+		//Compiled permutations by sorted define key. Shared so copies of a Shader share its cache
+		std::shared_ptr<std::map<std::string, std::shared_ptr<Shader>>> m_variants = std::make_shared<std::map<std::string, std::shared_ptr<Shader>>>();
+	};
+
+	//Shader that compiles in the background. Render with a fallback until isReady() returns true.
+	class AsyncShader {
+	public:
+		AsyncShader(const std::string& vertexShader, const std::string& fragmentShader, const ShaderDefines& defines = ShaderDefines(), const std::string& header = "");
+		bool isReady();
+		const Shader& get(const Shader& fallback);
+		const Shader& getPermutation(const ShaderDefines& defines, const Shader& fallback);
+		inline bool isFinished()const { return m_finished; }
+		inline const std::string& getLog()const { return m_build.log; }
+	private:
+		std::string m_vertexPath;
+		std::string m_fragmentPath;
+		ShaderDefines m_defines;
+		std::string m_header;
+		std::string m_permutationKey;
+		ShaderProgramBuild m_build;
+		Shader m_shader = Shader(0u);
+		bool m_finished = false;
+		//Other permutations by sorted define key, each compiling in the background
+		std::map<std::string, std::unique_ptr<AsyncShader>> m_permutations;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "shaderHotReload.h"
+#include "external/glad.h"
+#include <imgui.h>
+#include <algorithm>
+
+namespace ew {
+	/// <summary>
+	/// Reloads a shader whenever its vertex or fragment source file, or a file they include, changes.
+	/// The shader must have been loaded from files and must outlive this object.
+	/// </summary>
+	void ShaderHotReload::watch(Shader* shader)
+	{
+		if (shader->getVertexPath().empty() || shader->getFragmentPath().empty()) {
+			printf("Shader was not loaded from files and can't be hot reloaded");
+			return;
+		}
+		WatchedShader watched;
+		shader->buildSource(shader->getVertexPath(), &watched.files);
+		std::vector<std::string> fragmentFiles;
+		shader->buildSource(shader->getFragmentPath(), &fragmentFiles);
+		watched.files.insert(watched.files.end(), fragmentFiles.begin(), fragmentFiles.end());
+		for (const std::string& file : watched.files) {
+			m_fileWatcher.watch(file);
+		}
+		watched.shader = shader;
+		m_shaders.push_back(watched);
+	}
+	/// <summary>
+	/// Submits a new build from the shader's current source files
+	/// </summary>
+	void ShaderHotReload::beginBuild(WatchedShader& watched)
+	{
+		const Shader* shader = watched.shader;
+		std::vector<std::string> vertexFiles, fragmentFiles;
+		std::string vertexShaderSource = shader->buildSource(shader->getVertexPath(), &vertexFiles);
+		std::string fragmentShaderSource = shader->buildSource(shader->getFragmentPath(), &fragmentFiles);
+		//Edits may have added new includes
+		watched.files = vertexFiles;
+		watched.files.insert(watched.files.end(), fragmentFiles.begin(), fragmentFiles.end());
+		for (const std::string& file : watched.files) {
+			m_fileWatcher.watch(file);
+		}
+		watched.build = ew::beginShaderProgram(vertexShaderSource.c_str(), fragmentShaderSource.c_str());
+		watched.building = true;
+		watched.changedWhileBuilding = false;
+	}
+	/// <summary>
+	/// Starts rebuilding shaders whose files changed, and swaps in programs that finished linking.
+	/// A program that fails to compile or link is discarded and the shader keeps its previous program.
+	/// </summary>
+	void ShaderHotReload::update()
+	{
+		std::vector<std::string> changedFiles = m_fileWatcher.poll();
+		for (WatchedShader& watched : m_shaders) {
+			for (const std::string& path : changedFiles) {
+				if (std::find(watched.files.begin(), watched.files.end(), path) == watched.files.end()) {
+					continue;
+				}
+				if (watched.building) {
+					//Restart once the in-flight build is finished, since GL has no way to cancel it
+					watched.changedWhileBuilding = true;
+				}
+				else {
+					beginBuild(watched);
+				}
+				break;
+			}
+			if (!watched.building || !ew::isShaderProgramComplete(watched.build)) {
+				continue;
+			}
+			unsigned int program = ew::finishShaderProgram(watched.build);
+			watched.building = false;
+			if (watched.changedWhileBuilding) {
+				glDeleteProgram(program);
+				beginBuild(watched);
+			}
+			else if (watched.build.linked) {
+				watched.shader->setProgram(program);
+				watched.shader->clearVariants();
+				watched.error.clear();
+			}
+			else {
+				glDeleteProgram(program);
+				watched.error = watched.build.log;
+			}
+		}
+		m_numErrors = 0;
+		for (const WatchedShader& watched : m_shaders) {
+			m_numErrors += !watched.error.empty();
+		}
+	}
+	/// <summary>
+	/// Shows compile and link errors from the last reload of each shader in an ImGui window
+	/// </summary>
+	void ShaderHotReload::drawErrorOverlay() const
+	{
+		if (m_numErrors == 0) {
+			return;
+		}
+		ImGui::SetNextWindowBgAlpha(0.85f);
+		ImGui::Begin("Shader Errors", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+		for (const WatchedShader& watched : m_shaders) {
+			if (watched.error.empty()) {
+				continue;
+			}
+			ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s + %s", watched.shader->getVertexPath().c_str(), watched.shader->getFragmentPath().c_str());
+			ImGui::TextUnformatted(watched.error.c_str());
+			ImGui::Separator();
+		}
+		ImGui::Text("Previous programs are still in use");
+		ImGui::End();
+	}
+}
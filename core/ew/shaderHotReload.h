@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "shader.h"
+#include "fileWatcher.h"
+
+namespace ew {
+	//Recompiles shaders when their source files change and swaps the new program in once it links.
+	//Builds use parallel shader compile when available, so the render loop keeps using the old program meanwhile.
+	class ShaderHotReload {
+	public:
+		void watch(Shader* shader);
+		void update(); //Call once per frame
+		void drawErrorOverlay() const; //Call between ImGui::NewFrame and ImGui::Render
+		inline bool hasErrors()const { return m_numErrors > 0; }
+	private:
+		struct WatchedShader {
+			Shader* shader = nullptr;
+			std::vector<std::string> files; //Sources and includes of both stages
+			bool building = false;
+			bool changedWhileBuilding = false;
+			ShaderProgramBuild build;
+			std::string error; //Last failed build, cleared on success
+		};
+		void beginBuild(WatchedShader& watched);
+		FileWatcher m_fileWatcher;
+		std::vector<WatchedShader> m_shaders;
+		int m_numErrors = 0;
+	};
+}
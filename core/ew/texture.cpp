@@ -1,6 +1,7 @@
 #include "texture.h"
 #include "external/glad.h"
 #include "external/stb_image.h"
+#include "glState.h"
 
 static int getTextureFormat(int numComponents) {
 	switch (numComponents) {
@@ -23,12 +24,12 @@ namespace ew {
 		}
 		unsigned int texture;
 		glGenTextures(1, &texture);
-		glBindTexture(GL_TEXTURE_2D, texture);
+		ew::state::bindTexture(0, GL_TEXTURE_2D, texture);
 		int format = getTextureFormat(numComponents);
 		glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapMode);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapMode);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmapMinFilter(filterMode));
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filterMode);
 
 		float borderColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
@@ -36,9 +37,12 @@ namespace ew {
 
 		glGenerateMipmap(GL_TEXTURE_2D);
 
-		glBindTexture(GL_TEXTURE_2D, NULL);
+		ew::state::bindTexture(0, GL_TEXTURE_2D, 0);
 		stbi_image_free(data);
 		return texture;
 	}
+	int mipmapMinFilter(int filterMode) {
+		return filterMode == GL_NEAREST ? GL_NEAREST_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR;
+	}
 }
 
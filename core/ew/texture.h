@@ -2,4 +2,6 @@
 
 namespace ew {
 	unsigned int loadTexture(const char* filePath, int wrapMode, int filterMode);
+	//Minification filter for a mipmapped texture sampled with filterMode (GL_NEAREST or GL_LINEAR) when magnified
+	int mipmapMinFilter(int filterMode);
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include "ewMath/ewMath.h"
 #include "ewMath/transformations.h"
+#include "bounds.h"
 namespace ew {
 	struct Transform {
 		ew::Vec3 position = ew::Vec3(0.0f, 0.0f, 0.0f);
@@ -14,5 +15,41 @@ namespace ew {
 				* ew::RotateZ(ew::Radians(rotation.z))
 				* ew::Scale(scale);
 		}
+		//Inverse of getModelMatrix, built from the inverse of each step in reverse order
+		ew::Mat4 getInverseModelMatrix() const {
+			return ew::Scale(ew::Vec3(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z))
+				* ew::RotateZ(ew::Radians(-rotation.z))
+				* ew::RotateX(ew::Radians(-rotation.x))
+				* ew::RotateY(ew::Radians(-rotation.y))
+				* ew::Translate(-position);
+		}
+		//World space box enclosing local space bounds, e.g. MeshData::bounds
+		AABB getWorldBounds(const AABB& localBounds) const {
+			return ew::TransformBounds(localBounds, getModelMatrix());
+		}
+	};
+
+	//Transform with a quaternion rotation. The model matrix is written in closed form instead of
+	//multiplying five matrices, and rotations interpolate with ew::Slerp without gimbal lock.
+	struct QuatTransform {
+		ew::Vec3 position = ew::Vec3(0.0f, 0.0f, 0.0f);
+		ew::Quat rotation;
+		ew::Vec3 scale = ew::Vec3(1.0f, 1.0f, 1.0f);
+
+		QuatTransform() {};
+		QuatTransform(const ew::Vec3& position, const ew::Quat& rotation, const ew::Vec3& scale) :position(position), rotation(rotation), scale(scale) {};
+		//Same model matrix as the Euler transform
+		explicit QuatTransform(const Transform& transform)
+			:position(transform.position), rotation(ew::QuatFromEuler(transform.rotation * ew::DEG2RAD)), scale(transform.scale) {};
+
+		ew::Mat4 getModelMatrix() const {
+			return ew::TRS(position, rotation, scale);
+		}
+		ew::Mat4 getInverseModelMatrix() const {
+			return ew::InverseTRS(position, rotation, scale);
+		}
+		AABB getWorldBounds(const AABB& localBounds) const {
+			return ew::TransformBounds(localBounds, getModelMatrix());
+		}
 	};
 }
@@ -0,0 +1,11 @@
+#Google Benchmark
+string(TIMESTAMP BEFORE "%s")
+
+CPMAddPackage(
+	NAME "benchmark"
+	URL "https://github.com/google/benchmark/archive/refs/tags/v1.8.3.zip"
+	OPTIONS "BENCHMARK_ENABLE_TESTING OFF" "BENCHMARK_ENABLE_GTEST_TESTS OFF" "BENCHMARK_ENABLE_INSTALL OFF" "BENCHMARK_ENABLE_WERROR OFF"
+)
+string(TIMESTAMP AFTER "%s")
+math(EXPR DELTAbenchmark "${AFTER}-${BEFORE}")
+MESSAGE(STATUS "benchmark TIME: ${DELTAbenchmark}s")
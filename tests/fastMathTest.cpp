@@ -0,0 +1,59 @@
+#include <vector>
+#include "testCheck.h"
+#include <ew/ewMath/fastMath.h>
+
+//SinCos inside and outside SINCOS_FAST_RANGE, where it hands over to the C library, and for non-finite input
+
+static void expectSinCos(float rad, const char* name) {
+	float s = 0.0f, c = 0.0f;
+	ew::SinCos(rad, s, c);
+	const bool inRange = s >= -1.0f && s <= 1.0f && c >= -1.0f && c <= 1.0f;
+	expect(inRange && fabsf(s - sinf(rad)) <= 1e-6f && fabsf(c - cosf(rad)) <= 1e-6f, name);
+}
+
+static void expectSinCosNaN(float rad, const char* name) {
+	float s = 0.0f, c = 0.0f;
+	ew::SinCos(rad, s, c);
+	expect(isnan(s) && isnan(c), name);
+}
+
+int main() {
+	expectSinCos(0.0f, "SinCos(0)");
+	expectSinCos(-2.5f, "SinCos(-2.5)");
+	expectSinCos(1000.0f, "SinCos(1000)");
+	expectSinCos(8000.0f, "SinCos(8000)");
+	expectSinCos(1e10f, "SinCos(1e10)");
+	expectSinCos(-1e10f, "SinCos(-1e10)");
+	expectSinCos(1e20f, "SinCos(1e20)");
+	expectSinCos(3e38f, "SinCos(3e38)");
+	expectSinCosNaN(INFINITY, "SinCos(inf) is NaN");
+	expectSinCosNaN(-INFINITY, "SinCos(-inf) is NaN");
+	expectSinCosNaN(NAN, "SinCos(NaN) is NaN");
+
+	float s = 0.0f, c = 0.0f;
+	ew::SinCos<ew::Precision::LOW>(1e10f, s, c);
+	expect(s == sinf(1e10f) && c == cosf(1e10f), "LOW SinCos(1e10) falls back to libm");
+
+	//The bulk version matches the scalar one in every lane, including lanes it hands to the scalar version
+	std::vector<float> angles;
+	for (int i = 0; i < 64; i++)
+	{
+		angles.push_back((i - 32) * 0.37f);
+	}
+	angles[5] = 1e10f;
+	angles[17] = -1e20f;
+	angles[26] = INFINITY;
+	angles[40] = NAN;
+	std::vector<float> sines(angles.size()), cosines(angles.size());
+	ew::SinCos(angles.data(), sines.data(), cosines.data(), angles.size());
+	bool bulkMatches = true;
+	for (size_t i = 0; i < angles.size(); i++)
+	{
+		ew::SinCos(angles[i], s, c);
+		const bool same = (isnan(s) ? isnan(sines[i]) : fabsf(sines[i] - s) <= 1e-6f) && (isnan(c) ? isnan(cosines[i]) : fabsf(cosines[i] - c) <= 1e-6f);
+		bulkMatches = bulkMatches && same;
+	}
+	expect(bulkMatches, "bulk SinCos matches scalar");
+
+	return testResult();
+}
@@ -0,0 +1,99 @@
+#include "testCheck.h"
+#include <ew/ewMath/mat4.h>
+#include <ew/ewMath/transformations.h>
+#include <ew/ewMath/rng.h>
+
+//Inverse, AffineInverse, NormalMatrix and Transpose against the portable versions in mat4scalar and against M * M^-1 = I.
+//Without SSE both sides are the same code, so only the identities are meaningful there
+
+static float maxDifference(const ew::Mat4& a, const ew::Mat4& b) {
+	float maxDiff = 0.0f;
+	for (int c = 0; c < 4; c++)
+	{
+		for (int r = 0; r < 4; r++)
+		{
+			const float diff = fabsf(a[c][r] - b[c][r]);
+			maxDiff = diff > maxDiff || isnan(diff) ? diff : maxDiff;
+		}
+	}
+	return maxDiff;
+}
+
+static bool allFinite(const ew::Mat4& m) {
+	for (int c = 0; c < 4; c++)
+	{
+		for (int r = 0; r < 4; r++)
+		{
+			if (!isfinite(m[c][r])) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static ew::Mat4 randomTRS(ew::Rng& rng) {
+	const ew::Vec3 t(rng.range(-50.0f, 50.0f), rng.range(-50.0f, 50.0f), rng.range(-50.0f, 50.0f));
+	const ew::Vec3 s(rng.range(0.2f, 5.0f), rng.range(0.2f, 5.0f), rng.range(0.2f, 5.0f));
+	return ew::Translate(t) * ew::RotateY(rng.range(-3.0f, 3.0f)) * ew::RotateX(rng.range(-3.0f, 3.0f)) * ew::Scale(s);
+}
+
+static ew::Mat4 randomGeneral(ew::Rng& rng) {
+	//Diagonally dominant, so well conditioned
+	ew::Mat4 m;
+	for (int c = 0; c < 4; c++)
+	{
+		for (int r = 0; r < 4; r++)
+		{
+			m[c][r] = rng.range(-1.0f, 1.0f) + (c == r ? 4.0f : 0.0f);
+		}
+	}
+	return m;
+}
+
+int main() {
+	ew::Rng rng(7);
+	const ew::Mat4 identity = ew::IdentityMatrix();
+	float inverseVsScalar = 0.0f, inverseIdentity = 0.0f, affineVsInverse = 0.0f, affineIdentity = 0.0f;
+	float normalVsScalar = 0.0f, normalVsInverse = 0.0f, transposeVsScalar = 0.0f;
+	for (int i = 0; i < 1000; i++)
+	{
+		const ew::Mat4 general = i % 2 == 0 ? randomGeneral(rng) : ew::Perspective(rng.range(0.5f, 2.0f), rng.range(0.5f, 3.0f), 0.1f, 100.0f) * randomTRS(rng);
+		const ew::Mat4 inverse = ew::Inverse(general);
+		//Relative to the magnitudes involved, since projections have large entries
+		const float scale = maxDifference(general, ew::Mat4(0.0f)) * maxDifference(inverse, ew::Mat4(0.0f));
+		inverseVsScalar = fmaxf(inverseVsScalar, maxDifference(inverse, ew::mat4scalar::Inverse(general)) / scale);
+		inverseIdentity = fmaxf(inverseIdentity, maxDifference(general * inverse, identity) / scale);
+		transposeVsScalar = fmaxf(transposeVsScalar, maxDifference(ew::Transpose(general), ew::mat4scalar::Transpose(general)));
+
+		const ew::Mat4 trs = randomTRS(rng);
+		const ew::Mat4 affineInverse = ew::AffineInverse(trs);
+		affineVsInverse = fmaxf(affineVsInverse, maxDifference(affineInverse, ew::Inverse(trs)));
+		affineVsInverse = fmaxf(affineVsInverse, maxDifference(affineInverse, ew::mat4scalar::AffineInverse(trs)));
+		affineIdentity = fmaxf(affineIdentity, maxDifference(trs * affineInverse, identity));
+
+		const ew::Mat4 normalMatrix = ew::NormalMatrix(trs);
+		normalVsScalar = fmaxf(normalVsScalar, maxDifference(normalMatrix, ew::mat4scalar::NormalMatrix(trs)));
+		ew::Mat4 expected = ew::Transpose(ew::Inverse(trs));
+		expected[0][3] = expected[1][3] = expected[2][3] = 0.0f;
+		expected[3] = ew::Vec4(0.0f, 0.0f, 0.0f, 1.0f);
+		normalVsInverse = fmaxf(normalVsInverse, maxDifference(normalMatrix, expected));
+	}
+	expectNear(inverseVsScalar, 0.0f, 1e-6f, "Inverse matches the scalar version");
+	expectNear(inverseIdentity, 0.0f, 1e-5f, "M * Inverse(M) = I");
+	expectNear(transposeVsScalar, 0.0f, 0.0f, "Transpose matches the scalar version");
+	expectNear(affineVsInverse, 0.0f, 1e-4f, "AffineInverse matches Inverse and the scalar version");
+	expectNear(affineIdentity, 0.0f, 1e-4f, "M * AffineInverse(M) = I");
+	expectNear(normalVsScalar, 0.0f, 1e-5f, "NormalMatrix matches the scalar version");
+	expectNear(normalVsInverse, 0.0f, 1e-4f, "NormalMatrix is the transposed inverse");
+
+	//Singular input gives non-finite values rather than a plausible looking matrix
+	ew::Mat4 singular = ew::Translate(ew::Vec3(1, 2, 3)) * ew::Scale(ew::Vec3(2, 3, 4));
+	singular[1] = singular[0];
+	expect(!allFinite(ew::Inverse(singular)), "Inverse of a singular matrix is not finite");
+	expect(!allFinite(ew::mat4scalar::Inverse(singular)), "scalar Inverse of a singular matrix is not finite");
+	expect(!allFinite(ew::AffineInverse(singular)), "AffineInverse of a singular matrix is not finite");
+	expect(!allFinite(ew::Inverse(ew::Mat4(0.0f))), "Inverse of zero is not finite");
+
+	return testResult();
+}
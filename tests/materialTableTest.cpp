@@ -0,0 +1,126 @@
+#include <vector>
+#include <string>
+#include "testCheck.h"
+#include <ew/external/glad.h>
+#include <ew/headless.h>
+#include <ew/materialTable.h>
+#include <ew/imageWrite.h>
+#include <ew/shader.h>
+
+//Uploads a table with a missing image, a red 4x2 image, a green 8x8 image and an untextured material,
+//then reads each material back through the shader header in a compute shader.
+//Needs an OpenGL 4.5 context, so it is skipped where none can be created
+
+static const char* RED_PATH = "materialTableTest_red.png";
+static const char* GREEN_PATH = "materialTableTest_green.png";
+
+//One work group per material, so the index is dynamically uniform as sampleMaterial requires
+static const char* READ_MATERIALS_SOURCE =
+"#version 450\n"
+"layout(local_size_x = 1) in;\n"
+"layout(std430, binding = 1) writeonly buffer Results{\n"
+"	vec4 _Results[];\n"
+"};\n"
+"void main(){\n"
+"	uint i = gl_WorkGroupID.x;\n"
+"	_Results[i * 2] = sampleMaterial(i, vec2(0.5));\n"
+"	_Results[i * 2 + 1] = vec4(_Materials[i].ambient, _Materials[i].diffuse, _Materials[i].specular, _Materials[i].shine);\n"
+"}\n";
+
+static bool writeImage(const char* filePath, int width, int height, unsigned char r, unsigned char g, unsigned char b) {
+	std::vector<unsigned char> pixels((size_t)width * height * 4);
+	for (size_t i = 0; i < pixels.size(); i += 4)
+	{
+		pixels[i] = r; pixels[i + 1] = g; pixels[i + 2] = b; pixels[i + 3] = 255;
+	}
+	return ew::writePNG(filePath, width, height, 4, pixels.data());
+}
+
+//Runs READ_MATERIALS_SOURCE, two vec4s per material: the sampled color, then ambient, diffuse, specular and shine
+static void readMaterials(const ew::MaterialTable& table, unsigned int program, unsigned int resultBuffer, std::vector<float>& results) {
+	table.bind(0, 0);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, resultBuffer);
+	glUseProgram(program);
+	glUniform1i(glGetUniformLocation(program, "_MaterialTextures"), 0);
+	glDispatchCompute(table.getNumMaterials(), 1, 1);
+	glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, resultBuffer);
+	glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(float) * results.size(), results.data());
+}
+
+static bool near(const float* actual, float x, float y, float z, float w, float tolerance) {
+	return fabsf(actual[0] - x) <= tolerance && fabsf(actual[1] - y) <= tolerance && fabsf(actual[2] - z) <= tolerance && fabsf(actual[3] - w) <= tolerance;
+}
+
+int main() {
+	ew::HeadlessContext context;
+	if (!context.create(4, 5)) {
+		return testSkipped("No OpenGL 4.5 context");
+	}
+	if (!writeImage(RED_PATH, 4, 2, 255, 0, 0) || !writeImage(GREEN_PATH, 8, 8, 0, 255, 0)) {
+		return testSkipped("Can't write test images");
+	}
+
+	//Texture array mode, which every context supports
+	ew::MaterialTable table(GL_REPEAT, GL_NEAREST, false);
+	const int missing = table.addTexture("materialTableTest_missing.png");
+	const int red = table.addTexture(RED_PATH);
+	const int green = table.addTexture(GREEN_PATH);
+	const int textures[4] = { missing, red, green, -1 };
+	for (int i = 0; i < 4; i++)
+	{
+		ew::Material material;
+		material.texture = textures[i];
+		material.ambient = 0.1f * i;
+		material.diffuse = 0.2f * i;
+		material.specular = 0.3f * i;
+		material.shine = 16.0f * (i + 1);
+		expect(table.addMaterial(material) == i, "addMaterial returns consecutive indices");
+	}
+	table.upload();
+	expect(!table.isBindless(), "allowBindless = false uses the texture array");
+	expect(table.getNumMaterials() == 4, "getNumMaterials");
+
+	//Layers are sized from the first image that loads, not the missing one
+	table.bind(0, 0);
+	int width = 0, height = 0, depth = 0;
+	glGetTexLevelParameteriv(GL_TEXTURE_2D_ARRAY, 0, GL_TEXTURE_WIDTH, &width);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D_ARRAY, 0, GL_TEXTURE_HEIGHT, &height);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D_ARRAY, 0, GL_TEXTURE_DEPTH, &depth);
+	expect(width == 4 && height == 2 && depth == 3, "Texture array is 4x2 with a layer per texture");
+
+	const unsigned int program = ew::createComputeProgram(ew::insertAfterVersion(READ_MATERIALS_SOURCE, table.getShaderHeader(0)).c_str());
+	std::vector<float> results(4 * 2 * 4, -1.0f);
+	unsigned int resultBuffer;
+	glGenBuffers(1, &resultBuffer);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, resultBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(float) * results.size(), results.data(), GL_DYNAMIC_READ);
+	readMaterials(table, program, resultBuffer, results);
+
+	expect(near(&results[0], 1, 1, 1, 1, 0.0f), "Missing image samples white");
+	expect(near(&results[8], 1, 0, 0, 1, 0.0f), "Red image");
+	expect(near(&results[16], 0, 1, 0, 1, 0.0f), "Green image resampled to the layer size");
+	expect(near(&results[24], 1, 1, 1, 1, 0.0f), "Untextured material samples white");
+	bool paramsMatch = true;
+	for (int i = 0; i < 4; i++)
+	{
+		paramsMatch &= near(&results[i * 8 + 4], 0.1f * i, 0.2f * i, 0.3f * i, 16.0f * (i + 1), 1e-6f);
+	}
+	expect(paramsMatch, "Material parameters");
+
+	//Editing a material must not reload textures, which would now fail and turn the red layer white
+	remove(RED_PATH);
+	remove(GREEN_PATH);
+	ew::Material edited = table.getMaterial(1);
+	edited.shine = 512.0f;
+	table.setMaterial(1, edited);
+	table.upload();
+	readMaterials(table, program, resultBuffer, results);
+	expect(near(&results[8], 1, 0, 0, 1, 0.0f), "setMaterial keeps the texture array");
+	expectNear(results[15], 512.0f, 0.0f, "setMaterial updates the material buffer");
+	expectNear(results[23], 48.0f, 0.0f, "setMaterial leaves other materials");
+
+	glDeleteBuffers(1, &resultBuffer);
+	glDeleteProgram(program);
+	return testResult();
+}
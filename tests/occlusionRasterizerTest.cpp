@@ -0,0 +1,69 @@
+#include <vector>
+#include "testCheck.h"
+#include <ew/occlusionRasterizer.h>
+#include <ew/procGen.h>
+#include <ew/camera.h>
+#include <ew/ewMath/transformations.h>
+
+//Camera at z = 10 looking down -z at a 4 unit cube occluder centered on the origin.
+//Boxes are tested 5 units behind the cube, where it covers |x| and |y| up to about 1.9
+
+static ew::AABB box(const ew::Vec3& min, const ew::Vec3& max) {
+	ew::AABB bounds;
+	bounds.min = min;
+	bounds.max = max;
+	return bounds;
+}
+
+int main() {
+	ew::Camera camera;
+	camera.position = ew::Vec3(0, 0, 10);
+	camera.target = ew::Vec3(0);
+	camera.aspectRatio = 2.0f;
+	camera.nearPlane = 0.1f;
+	const ew::Mat4 viewProjection = camera.ProjectionMatrix() * camera.ViewMatrix();
+	const ew::MeshData cube = ew::createCube(4.0f);
+
+	const ew::AABB occluded = box(ew::Vec3(-1, -1, -6), ew::Vec3(1, 1, -4));
+	const ew::AABB visible = box(ew::Vec3(9, -1, -6), ew::Vec3(11, 1, -4));
+	const ew::AABB straddling = box(ew::Vec3(1, -1, -6), ew::Vec3(5, 1, -4));
+	const ew::AABB inFront = box(ew::Vec3(-0.5f, -0.5f, 3), ew::Vec3(0.5f, 0.5f, 4));
+	const ew::AABB behindCamera = box(ew::Vec3(-1, -1, 12), ew::Vec3(1, 1, 14));
+	const ew::AABB acrossNearPlane = box(ew::Vec3(-1, -1, 5), ew::Vec3(1, 1, 15));
+
+	ew::OcclusionRasterizer rasterizer(256, 128);
+
+	//Nothing drawn, so nothing can be occluded
+	rasterizer.beginOccluders(viewProjection);
+	rasterizer.endOccluders();
+	expect(!rasterizer.isOccluded(occluded), "empty buffer occludes nothing");
+
+	rasterizer.beginOccluders(viewProjection);
+	rasterizer.addOccluder(cube, ew::Identity());
+	rasterizer.endOccluders();
+	expect(rasterizer.getStats().numTrianglesRasterized > 0, "occluder rasterized");
+	expect(rasterizer.isOccluded(occluded), "box behind occluder is occluded");
+	expect(!rasterizer.isOccluded(visible), "box beside occluder is visible");
+	expect(!rasterizer.isOccluded(straddling), "box partly behind occluder is visible");
+	expect(!rasterizer.isOccluded(inFront), "box in front of occluder is visible");
+	expect(!rasterizer.isOccluded(behindCamera), "box behind camera is visible");
+	expect(!rasterizer.isOccluded(acrossNearPlane), "box across near plane is visible");
+
+	//cull agrees with isOccluded, on one and several threads
+	const std::vector<ew::AABB> bounds = { occluded, visible, straddling, inFront, behindCamera, acrossNearPlane };
+	for (int numThreads = 1; numThreads <= 4; numThreads *= 4)
+	{
+		std::vector<uint8_t> visibility;
+		int numVisible = rasterizer.cull(bounds, visibility, numThreads);
+		expect(numVisible == 5 && visibility[0] == 0 && visibility[1] == 1, numThreads == 1 ? "cull on 1 thread" : "cull on 4 threads");
+	}
+
+	//The same occluder on several threads gives the same depth buffer
+	std::vector<float> singleThreaded = rasterizer.getDepthBuffer();
+	rasterizer.beginOccluders(viewProjection);
+	rasterizer.addOccluder(cube, ew::Identity());
+	rasterizer.endOccluders(4);
+	expect(rasterizer.getDepthBuffer() == singleThreaded, "multithreaded depth matches");
+
+	return testResult();
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <stdio.h>
+#include <math.h>
+
+//Minimal checks for the CTest executables. Each prints its result, and main returns testResult()
+static int s_numFailed = 0;
+
+inline void expect(bool condition, const char* name) {
+	printf("%s: %s\n", condition ? "PASSED" : "FAILED", name);
+	if (!condition) {
+		s_numFailed++;
+	}
+}
+
+//|actual - expected| <= tolerance. Fails for NaN
+inline void expectNear(float actual, float expected, float tolerance, const char* name) {
+	const bool near = fabsf(actual - expected) <= tolerance;
+	if (near) {
+		printf("PASSED: %s\n", name);
+	}
+	else {
+		printf("FAILED: %s (got %g, expected %g, tolerance %g)\n", name, actual, expected, tolerance);
+		s_numFailed++;
+	}
+}
+
+inline int testResult() {
+	return s_numFailed == 0 ? 0 : 1;
+}
+
+//Returned from main when the test can't run here, e.g. without an OpenGL context. ctest reports it as skipped
+const int TEST_SKIPPED = 77;
+inline int testSkipped(const char* reason) {
+	printf("SKIPPED: %s\n", reason);
+	return TEST_SKIPPED;
+}
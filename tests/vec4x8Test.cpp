@@ -0,0 +1,99 @@
+#include <vector>
+#include "testCheck.h"
+#include <ew/ewMath/vec4x8.h>
+#include <ew/ewMath/transformations.h>
+#include <ew/ewMath/rng.h>
+
+//Vec4x8 operations against the same math on single Vec4s, with a count that leaves the last packet partly used
+
+static const int NUM_VECTORS = 37;
+
+static std::vector<ew::Vec4> randomVec4s(ew::Rng& rng) {
+	std::vector<ew::Vec4> vectors(NUM_VECTORS);
+	for (ew::Vec4& v : vectors) {
+		v = ew::Vec4(rng.range(-10.0f, 10.0f), rng.range(-10.0f, 10.0f), rng.range(-10.0f, 10.0f), rng.range(-10.0f, 10.0f));
+	}
+	return vectors;
+}
+
+static float maxDifference(const std::vector<ew::Vec4x8>& packets, const std::vector<ew::Vec4>& expected) {
+	std::vector<ew::Vec4> actual;
+	ew::Unpack(packets, expected.size(), actual);
+	float maxDiff = 0.0f;
+	for (size_t i = 0; i < expected.size(); i++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			const float diff = fabsf(actual[i][c] - expected[i][c]);
+			maxDiff = diff > maxDiff || isnan(diff) ? diff : maxDiff;
+		}
+	}
+	return maxDiff;
+}
+
+int main() {
+	ew::Rng rng(11);
+	const std::vector<ew::Vec4> a = randomVec4s(rng);
+	const std::vector<ew::Vec4> b = randomVec4s(rng);
+	std::vector<ew::Vec4x8> pa, pb, result;
+	ew::Pack(a, pa);
+	ew::Pack(b, pb);
+	expect(pa.size() == 5 && pa[4].x[5] == 0.0f && pa[4].w[7] == 0.0f, "Pack pads the last packet with zeros");
+	expectNear(maxDifference(pa, a), 0.0f, 0.0f, "Unpack(Pack(v)) = v");
+
+	std::vector<ew::Vec4> sums(NUM_VECTORS), lerps(NUM_VECTORS), scaled(NUM_VECTORS), clamped(NUM_VECTORS), normalized(NUM_VECTORS), transformed(NUM_VECTORS);
+	std::vector<float> dots(NUM_VECTORS);
+	const ew::Mat4 m = ew::Perspective(1.0f, 1.5f, 0.1f, 100.0f) * ew::Translate(ew::Vec3(1, 2, -20)) * ew::RotateY(0.5f);
+	for (int i = 0; i < NUM_VECTORS; i++)
+	{
+		//Per component, since the Vec4 operators leave w alone
+		const float invMagnitude = 1.0f / sqrtf(a[i].x * a[i].x + a[i].y * a[i].y + a[i].z * a[i].z + a[i].w * a[i].w);
+		for (int c = 0; c < 4; c++)
+		{
+			sums[i][c] = a[i][c] + b[i][c];
+			lerps[i][c] = a[i][c] + (b[i][c] - a[i][c]) * 0.25f;
+			scaled[i][c] = a[i][c] * 0.5f + b[i][c];
+			clamped[i][c] = fminf(fmaxf(a[i][c], -2.0f), 3.0f);
+			normalized[i][c] = a[i][c] * invMagnitude;
+		}
+		dots[i] = a[i].x * b[i].x + a[i].y * b[i].y + a[i].z * b[i].z + a[i].w * b[i].w;
+		transformed[i] = m * a[i];
+	}
+
+	ew::Add(pa, pb, result);
+	expectNear(maxDifference(result, sums), 0.0f, 1e-5f, "Add");
+	ew::Lerp(pa, pb, 0.25f, result);
+	expectNear(maxDifference(result, lerps), 0.0f, 1e-5f, "Lerp");
+	ew::MulAdd(pa, 0.5f, pb, result);
+	expectNear(maxDifference(result, scaled), 0.0f, 1e-5f, "MulAdd");
+	ew::Clamp(pa, -2.0f, 3.0f, result);
+	expectNear(maxDifference(result, clamped), 0.0f, 0.0f, "Clamp");
+	ew::Normalize(pa, result);
+	expectNear(maxDifference(result, normalized), 0.0f, 1e-5f, "Normalize");
+	ew::Transform(m, pa, result);
+	expectNear(maxDifference(result, transformed), 0.0f, 1e-4f, "Transform");
+
+	std::vector<float> packetDots;
+	ew::Dot(pa, pb, packetDots);
+	float dotDiff = 0.0f;
+	for (int i = 0; i < NUM_VECTORS; i++)
+	{
+		dotDiff = fmaxf(dotDiff, fabsf(packetDots[i] - dots[i]));
+	}
+	expect(packetDots.size() == pa.size() * ew::Vec4x8::SIZE, "Dot gives 8 results per packet");
+	expectNear(dotDiff, 0.0f, 1e-4f, "Dot");
+
+	//Outputs may alias inputs
+	result = pa;
+	ew::Transform(m, result, result);
+	expectNear(maxDifference(result, transformed), 0.0f, 1e-4f, "Transform in place");
+	result = pa;
+	ew::Add(result, pb, result);
+	expectNear(maxDifference(result, sums), 0.0f, 1e-5f, "Add in place");
+
+	//Zero vectors are unchanged by Normalize, including the padding lanes
+	ew::Normalize(pa, result);
+	expect(result[4].x[7] == 0.0f && result[4].w[7] == 0.0f, "Normalize leaves zero vectors");
+
+	return testResult();
+}
@@ -0,0 +1,15 @@
+#version 450
+out vec4 FragColor;
+
+in vec3 WorldNormal;
+in vec2 UV;
+
+uniform vec3 _Color;
+uniform vec3 _LightDirection;
+
+void main(){
+	//Checker pattern so that image diffs also catch UV regressions
+	float checker = mod(floor(UV.x * 8.0) + floor(UV.y * 8.0), 2.0) * 0.25 + 0.75;
+	float diffuse = max(dot(normalize(WorldNormal), -_LightDirection), 0.0);
+	FragColor = vec4(_Color * checker * (0.2 + 0.8 * diffuse), 1.0);
+}
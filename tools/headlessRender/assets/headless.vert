@@ -0,0 +1,17 @@
+#version 450
+layout(location = 0) in vec3 vPos;
+layout(location = 1) in vec3 vNormal;
+layout(location = 2) in vec2 vUV;
+
+uniform mat4 _Model;
+uniform mat4 _NormalMatrix; //ew::NormalMatrix(_Model)
+uniform mat4 _ViewProjection;
+
+out vec3 WorldNormal;
+out vec2 UV;
+
+void main(){
+	WorldNormal = mat3(_NormalMatrix) * vNormal;
+	UV = vUV;
+	gl_Position = _ViewProjection * _Model * vec4(vPos,1.0);
+}
@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <ew/external/glad.h>
+#include <ew/ewMath/ewMath.h>
+
+#include <ew/headless.h>
+#include <ew/shader.h>
+#include <ew/procGen.h>
+#include <ew/transform.h>
+#include <ew/camera.h>
+#include <ew/glState.h>
+
+//Shader and meshes for the scene, created together so startup can be timed as a unit
+struct Scene {
+	ew::Shader shader = ew::Shader("assets/headless.vert", "assets/headless.frag");
+	ew::Mesh planeMesh = ew::Mesh(ew::createPlane(10.0f, 10.0f, 10));
+	ew::Mesh cubeMesh = ew::Mesh(ew::createCube(1.0f));
+	ew::Mesh sphereMesh = ew::Mesh(ew::createSphere(0.5f, 64));
+	ew::Mesh cylinderMesh = ew::Mesh(ew::createCylinder(0.5f, 1.0f, 32));
+};
+
+//Draws the ground and a ring of shapes, seen from an orbiting camera
+static void drawScene(const Scene& scene, ew::Camera& camera, float time) {
+	const ew::Mesh* shapes[3] = { &scene.cubeMesh, &scene.sphereMesh, &scene.cylinderMesh };
+	const ew::Vec3 colors[3] = { ew::Vec3(0.9f, 0.3f, 0.2f), ew::Vec3(0.2f, 0.7f, 0.3f), ew::Vec3(0.2f, 0.4f, 0.9f) };
+	float angle = time * 0.5f;
+	camera.position = ew::Vec3(sinf(angle) * 6.0f, 3.0f, cosf(angle) * 6.0f);
+
+	glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	scene.shader.use();
+	scene.shader.setMat4("_ViewProjection", camera.ProjectionMatrix() * camera.ViewMatrix());
+	scene.shader.setVec3("_LightDirection", ew::Normalize(ew::Vec3(-0.4f, -1.0f, -0.3f)));
+
+	ew::Transform transform;
+	transform.position = ew::Vec3(0, -0.5f, 0);
+	ew::Mat4 model = transform.getModelMatrix();
+	scene.shader.setMat4("_Model", model);
+	scene.shader.setMat4("_NormalMatrix", ew::NormalMatrix(model));
+	scene.shader.setVec3("_Color", ew::Vec3(0.7f));
+	scene.planeMesh.draw();
+	for (int i = 0; i < 9; i++)
+	{
+		float ringAngle = i * 2.0f * ew::PI / 9.0f;
+		transform.position = ew::Vec3(cosf(ringAngle) * 3.0f, 0.5f, sinf(ringAngle) * 3.0f);
+		transform.rotation = ew::Vec3(0, time * 45.0f + i * 40.0f, 0);
+		model = transform.getModelMatrix();
+		scene.shader.setMat4("_Model", model);
+		scene.shader.setMat4("_NormalMatrix", ew::NormalMatrix(model));
+		scene.shader.setVec3("_Color", colors[i % 3]);
+		shapes[i % 3]->draw();
+	}
+}
+
+//Usage: headlessRender [--width W] [--height H] [--frames N] [--capture-interval K] [--capture-prefix PATH] [--timings PATH]
+//Renders an orbiting camera around procedural shapes. With a fixed time step the captures are the same
+//on every run, so they can be diffed against reference images.
+int main(int argc, char* argv[]) {
+	ew::HeadlessOptions options;
+	options.width = 640;
+	options.height = 360;
+	options.capturePrefix = "capture";
+	options.timingsPath = "timings.json";
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		const char* value = argv[i + 1];
+		if (strcmp(argv[i], "--width") == 0) {
+			options.width = atoi(value);
+		}
+		else if (strcmp(argv[i], "--height") == 0) {
+			options.height = atoi(value);
+		}
+		else if (strcmp(argv[i], "--frames") == 0) {
+			options.numFrames = atoi(value);
+		}
+		else if (strcmp(argv[i], "--capture-interval") == 0) {
+			options.captureInterval = atoi(value);
+		}
+		else if (strcmp(argv[i], "--capture-prefix") == 0) {
+			options.capturePrefix = value;
+		}
+		else if (strcmp(argv[i], "--timings") == 0) {
+			options.timingsPath = value;
+		}
+		else {
+			printf("Unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	ew::HeadlessContext context;
+	if (!context.create(4, 5)) {
+		return 1;
+	}
+	printf("Rendering %i frames at %ix%i on %s\n", options.numFrames, options.width, options.height, (const char*)glGetString(GL_RENDERER));
+
+	ew::state::setEnabled(GL_CULL_FACE, true);
+	ew::state::cullFace(GL_BACK);
+	ew::state::setEnabled(GL_DEPTH_TEST, true);
+
+	ew::Camera camera;
+	camera.target = ew::Vec3(0, 0.5f, 0);
+	camera.fov = 60.0f;
+	camera.aspectRatio = (float)options.width / options.height;
+
+	//Cold and warm shader program cache, reported in the timings JSON
+	options.startup = ew::measureTimeToFirstFrame(options, [&]() {
+		Scene scene;
+		drawScene(scene, camera, 0.0f);
+	});
+	if (options.startup.warmMs >= 0.0f) {
+		printf("Time to first frame %.1fms with a cold shader cache, %.1fms warm\n", options.startup.coldMs, options.startup.warmMs);
+	}
+
+	Scene scene;
+	std::vector<ew::FrameTiming> timings = ew::runHeadless(options, [&](int, float time, float) {
+		drawScene(scene, camera, time);
+	});
+	if (timings.empty()) {
+		return 1;
+	}
+
+	float cpuMs = 0.0f, gpuMs = 0.0f;
+	int numGPUFrames = 0;
+	for (const ew::FrameTiming& timing : timings) {
+		cpuMs += timing.cpuMs;
+		//gpuMs is -1 for frames whose timer queries were unsupported or unavailable
+		if (timing.gpuMs >= 0.0f) {
+			gpuMs += timing.gpuMs;
+			numGPUFrames++;
+		}
+	}
+	if (numGPUFrames > 0) {
+		printf("Average CPU %.3fms, GPU %.3fms per frame\n", cpuMs / timings.size(), gpuMs / numGPUFrames);
+	}
+	else {
+		printf("Average CPU %.3fms per frame, GPU time unavailable\n", cpuMs / timings.size());
+	}
+	return 0;
+}